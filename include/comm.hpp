@@ -107,6 +107,8 @@ class comm_t {
   /*MPI_Comm_dup and MPI_Comm_delete*/
   comm_t Dup() const;
   comm_t Split(const int color, const int key) const;
+  /*MPI_Comm_split_type into ranks sharing a node*/
+  comm_t SplitShared(const int key) const;
   void Free();
 
   /*Rank and size getters*/
@@ -136,7 +138,7 @@ class comm_t {
             const int tag=0) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     const int cnt = (count==-1) ? static_cast<int>(m.length()) : count;
-    MPI_Recv(m.ptr(), cnt, type, source, tag, comm());
+    MPI_Recv(m.ptr(), cnt, type, source, tag, comm(), MPI_STATUS_IGNORE);
     mpiType<T>::freeMpiType(type);
   }
 
@@ -156,7 +158,7 @@ class comm_t {
             const int source,
             const int tag=0) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
-    MPI_Recv(&val, 1, type, source, tag, comm());
+    MPI_Recv(&val, 1, type, source, tag, comm(), MPI_STATUS_IGNORE);
     mpiType<T>::freeMpiType(type);
   }
 
@@ -53,6 +53,9 @@ class initialGuessStrategy_t {
 
   virtual void FormInitialGuess(deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_rhs) = 0;
   virtual void Update(operator_t& linearOperator, deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_rhs) = 0;
+
+  // Time level of the next solve, for strategies that extrapolate in time
+  virtual void SetTime(const dfloat time) {}
 };
 
 // Default initial guess strategy:  use whatever the user gave us.
@@ -146,13 +149,20 @@ private:
   deviceMemory<int> o_sparseIds;
   deviceMemory<dfloat> o_sparseCoeffs;
 
+  // Time levels of the history entries, and of the next solve
+  bool timed;
+  dfloat time;
+  memory<dfloat> th;
+
   void extrapCoeffs(int m, int M, memory<dfloat> c);
+  void extrapCoeffs(int m, int M, memory<dfloat> r, dfloat ro, memory<dfloat> c);
 
 public:
   Extrap(dlong _N, platform_t& _platform, settings_t& _settings, comm_t _comm);
 
   void FormInitialGuess(deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_rhs);
   void Update(operator_t &linearOperator, deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_rhs);
+  void SetTime(const dfloat _time);
 };
 
 } //namespace InitialGuess
@@ -29,6 +29,7 @@ SOFTWARE.
 
 #include "core.hpp"
 #include "memory.hpp"
+#include <map>
 
 namespace libp {
 
@@ -45,6 +46,9 @@ class linAlg_t {
   //initialize list of kernels
   void InitKernels(std::vector<std::string> kernels);
 
+  //initialize batched kernels for M x N blocks
+  void InitBatchedGEMV(const int M, const int N);
+
   /*********************/
   /* vector operations */
   /*********************/
@@ -95,6 +99,27 @@ class linAlg_t {
               deviceMemory<dfloat> o_a, deviceMemory<dfloat> o_x,
               const dfloat beta, deviceMemory<dfloat> o_y, deviceMemory<dfloat> o_z);
 
+  /***************************/
+  /* batched block operations */
+  /***************************/
+
+  // No batched GEMM: the element-local operators in the solvers are all
+  // applied to one vector per block, so only the GEMV forms exist
+
+  // o_y_e = alpha*A_e*o_x_e + beta*o_y_e, for Nbatch column major M x N
+  // blocks A_e = o_A + e*strideA (strideA=0 applies one shared block)
+  void batchedGEMV(const dlong Nbatch, const int M, const int N,
+                   const dfloat alpha, deviceMemory<dfloat> o_A, const dlong strideA,
+                   deviceMemory<dfloat> o_x,
+                   const dfloat beta, deviceMemory<dfloat> o_y);
+
+  // o_y_e = alpha*o_s[e]*A_e*o_x_e + beta*o_y_e
+  void batchedGEMV(const dlong Nbatch, const int M, const int N,
+                   const dfloat alpha, deviceMemory<dfloat> o_s,
+                   deviceMemory<dfloat> o_A, const dlong strideA,
+                   deviceMemory<dfloat> o_x,
+                   const dfloat beta, deviceMemory<dfloat> o_y);
+
   // \min o_a
   dfloat min(const dlong N, deviceMemory<dfloat> o_a, comm_t comm);
 
@@ -155,6 +180,10 @@ class linAlg_t {
   static void matrixInverse(const int N, memory<double> A);
   static void matrixInverse(const int N, memory<float> A);
 
+  // in-place inverse of Nbatch consecutive N x N blocks of A
+  static void matrixInverseBatched(const dlong Nbatch, const int N, memory<double> A);
+  static void matrixInverseBatched(const dlong Nbatch, const int N, memory<float> A);
+
   static double matrixConditionNumber(const int N, const memory<double> A);
   static float  matrixConditionNumber(const int N, const memory<float> A);
 
@@ -207,6 +236,10 @@ class linAlg_t {
   kernel_t innerProdKernel2;
   kernel_t weightedInnerProdKernel1;
   kernel_t weightedInnerProdKernel2;
+
+  //batched kernels, built per block size
+  std::map<std::pair<int,int>, kernel_t> batchedGEMVKernels;
+  std::map<std::pair<int,int>, kernel_t> batchedScaledGEMVKernels;
 };
 
 } //namespace libp
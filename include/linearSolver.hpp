@@ -63,6 +63,9 @@ class linearSolver_t {
             deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_rhs,
             const dfloat tol, const int MAXIT, const int verbose);
 
+  /*Time level of the next Solve, used by time extrapolating initial guesses*/
+  void SetInitialGuessTime(const dfloat time);
+
  private:
   std::shared_ptr<LinearSolver::linearSolverBase_t> ls=nullptr;
   std::shared_ptr<InitialGuess::initialGuessStrategy_t> ig=nullptr;
@@ -278,6 +278,13 @@ class mesh_t {
   memory<memory<dlong>> mrPmlIds;
   memory<deviceMemory<dlong>> o_mrPmlIds;
 
+  //multirate cost model
+  double mrElementCost=0.0;        // per-element kernel cost
+  double mrLaunchCost=0.0;         // kernel launch/underfill floor
+  double mrExchangeCost=0.0;       // trace halo exchange cost
+  bool mrMeasuredCosts=false;      // costs were calibrated on this machine
+  double mrPredictedSpeedup=1.0;
+
   /*************************/
   /* SEMFEM                */
   /*************************/
@@ -289,6 +296,15 @@ class mesh_t {
   deviceMemory<dfloat> o_SEMFEMInterp;
   deviceMemory<dfloat> o_SEMFEMAnterp;
 
+  /*************************/
+  /* Load Rebalancing      */
+  /*************************/
+  // element migration pattern of the last rebalance
+  dlong NmigrateElements=0;  // local element count before migration
+  memory<dlong> migrateIds;  // local elements in send order
+  memory<int> migrateSendCounts, migrateSendOffsets;
+  memory<int> migrateRecvCounts, migrateRecvOffsets;
+
   kernel_t MassMatrixKernel;
 
   mesh_t() = default;
@@ -312,7 +328,15 @@ class mesh_t {
   void MultiRatePmlSetup();
 
   //Multirate partitioning
-  void MultiRateSetup(memory<dfloat> EToDT);
+  void MultiRateSetup(memory<dfloat> EToDT, const int Nfields=1);
+
+  //Multirate level selection from a calibrated cost model
+  void MultiRateCalibrate(const int Nfields);
+  void MultiRateEnforceLevelDifference(memory<int> level, const int Nlevels);
+  double MultiRateTickCost(memory<int> level, const int Nlevels);
+  void MultiRateCostModel(memory<dfloat> EToDT, const int Nfields);
+  void MultiRateReport(const hlong Nticks, const double elapsedTime,
+                       const double singleRateTickTime);
 
   // Multirate trace halo
   memory<ogs::halo_t> MultiRateHaloTraceSetup(int Nfields);
@@ -359,6 +383,18 @@ class mesh_t {
     }
   }
 
+  // Setup cubature geometric factors (ggeo, wJ) for over-integrated
+  // continuous operators
+  void CubatureGeometricFactors() {
+    switch (elementType) {
+      case Mesh::HEXAHEDRA:
+        CubatureGeometricFactorsHex3D();
+        break;
+      default:
+        LIBP_FORCE_ABORT("Cubature geometric factors only supported for hexahedra");
+    }
+  }
+
   dfloat MinCharacteristicLength();
 
   void PlotInterp(const memory<dfloat> q, memory<dfloat> Iq, memory<dfloat> scratch=memory<dfloat>()) {
@@ -412,12 +448,58 @@ class mesh_t {
   }
 
   //create a new mesh object with the same geometry, but different degree
-  mesh_t SetupNewDegree(int Nf);
+  mesh_t SetupNewDegree(int Nf, const bool cubature=false);
+
+  //create a lightweight continuous multigrid level mesh of a different degree
+  mesh_t SetupLevelDegree(int Nf, const bool cubature=false);
 
   mesh_t SetupRingPatch();
 
   mesh_t SetupSEMFEM(memory<hlong>& globalIds, memory<int>& mapB);
 
+  // ratio of the maximum to the mean of a per-rank time
+  dfloat LoadImbalance(const double localTime);
+
+  // repartition elements to balance their total weight on each rank, migrate
+  // elements, and rebuild connectivity, halos, and geometric factors. Trace
+  // halos, ring halos, and PML/multirate lists must be set up again by the caller
+  void Rebalance(const memory<dfloat>& elementWeights);
+
+  // migrate element-blocked data with Nentries per element to follow the
+  // last Rebalance. Space for Nhalo elements is appended to the result
+  template<typename T>
+  void Migrate(memory<T>& data, const int Nentries, const dlong Nhalo=0) {
+
+    memory<T> sendData(NmigrateElements*Nentries);
+    for (dlong n=0;n<NmigrateElements;++n) {
+      const dlong e = migrateIds[n];
+      for (int i=0;i<Nentries;++i) {
+        sendData[n*Nentries+i] = data[e*Nentries+i];
+      }
+    }
+
+    memory<int> sendCounts(size), sendOffsets(size);
+    memory<int> recvCounts(size), recvOffsets(size);
+    for (int rr=0;rr<size;++rr) {
+      sendCounts[rr]  = migrateSendCounts[rr]*Nentries;
+      sendOffsets[rr] = migrateSendOffsets[rr]*Nentries;
+      recvCounts[rr]  = migrateRecvCounts[rr]*Nentries;
+      recvOffsets[rr] = migrateRecvOffsets[rr]*Nentries;
+    }
+
+    data.calloc((Nelements+Nhalo)*Nentries);
+    comm.Alltoallv(sendData, sendCounts, sendOffsets,
+                   data,     recvCounts, recvOffsets);
+  }
+
+  template<typename T>
+  void Migrate(deviceMemory<T>& o_data, const int Nentries, const dlong Nhalo=0) {
+    memory<T> data(NmigrateElements*Nentries);
+    o_data.copyTo(data, NmigrateElements*Nentries);
+    Migrate(data, Nentries, Nhalo);
+    o_data = platform.malloc<T>(data);
+  }
+
   int RXID, RYID, RZID;
   int SXID, SYID, SZID;
   int TXID, TYID, TZID;
@@ -652,6 +734,8 @@ class mesh_t {
   void CubaturePhysicalNodesTet3D();
   void CubaturePhysicalNodesHex3D();
 
+  void CubatureGeometricFactorsHex3D();
+
   void PlotInterpTri2D(const memory<dfloat> q, memory<dfloat> Iq, memory<dfloat> scratch);
   void PlotInterpQuad2D(const memory<dfloat> q, memory<dfloat> Iq, memory<dfloat> scratch);
   void PlotInterpTet3D(const memory<dfloat> q, memory<dfloat> Iq, memory<dfloat> scratch);
@@ -93,6 +93,9 @@ private:
                            dlong &Nshared,
                            memory<parallelNode_t> &sharedNodes);
 
+  void NodeLocalityReport(const dlong Nshared,
+                          memory<parallelNode_t> &sharedNodes);
+
   void LocalSignedSetup(const dlong Nids, memory<parallelNode_t> &nodes);
   void LocalUnsignedSetup(const dlong Nids, memory<parallelNode_t> &nodes);
   void LocalHaloSetup(const dlong Nids, memory<parallelNode_t> &nodes);
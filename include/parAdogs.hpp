@@ -54,6 +54,22 @@ void MeshPartition(platform_t &platform,
                    memory<dfloat>& EZ,
                    comm_t comm);
 
+void MeshRebalance(platform_t &platform,
+                   settings_t &settings,
+                   const dlong Nelements,
+                   const  int dim,
+                   const  int Nverts,
+                   const  int Nfaces,
+                   const  int NfaceVertices,
+                   const  memory<int>& faceVertices,
+                   const  memory<hlong>& EToV,
+                   const  memory<dfloat>& EX,
+                   const  memory<dfloat>& EY,
+                   const  memory<dfloat>& EZ,
+                   const  memory<dfloat>& weights,
+                   memory<int>& dest,
+                   comm_t comm);
+
 } //namespace paradogs
 
 } //namespace libp
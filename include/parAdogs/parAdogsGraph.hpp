@@ -84,6 +84,20 @@ private:
 
   memory<hlong> colIds;
 
+  /*Boundary refinement*/
+  bool refine=false;
+  dfloat imbalanceTol=0.0;
+  bool refined=false;
+  hlong cutBefore=0, volumeBefore=0;
+
+  /*Surface locality of the local ordering*/
+  int reuseWindow=0;
+  dfloat reuseBefore=0.0;
+
+  /*Node hierarchy. nodeId is the lowest rank on this rank's node*/
+  bool nodeAware=false;
+  int nodeId=0;
+
 public:
   /*Build a graph from mesh connectivity info*/
   graph_t(platform_t &_platform,
@@ -99,13 +113,39 @@ public:
           const memory<dfloat>& EZ,
           comm_t _comm);
 
+  /*Reorder ranks by compute node, and bisect along node boundaries first*/
+  void NodeHierarchy();
+
   void InertialPartition();
 
   void SpectralPartition();
 
+  void SFCPartition();
+
+  /*Destination ranks of a weighted space-filling curve partition*/
+  void SFCRebalance(const memory<dfloat>& weights,
+                    memory<int>& dest);
+
   void Connect();
 
-  void CuthillMckee();
+  void CuthillMckee(const bool reverse=false);
+
+  void HilbertOrdering();
+
+  /*Group elements sharing faces into tiles of tileSize elements*/
+  void FaceBlockOrdering(const int tileSize);
+
+  /*Measure surface locality before reordering, for the report*/
+  void SetReuseWindow(const int window);
+
+  /*Enable greedy boundary refinement of bisections and final partition*/
+  void SetRefinement(const dfloat tolerance);
+
+  /*Greedy k-way boundary refinement of connected partition*/
+  void RefinePartition();
+
+  /*Rebuild connectivity and offsets after migrating elements*/
+  void Reconnect();
 
   void Report();
 
@@ -122,6 +162,26 @@ private:
   void SpectralBipartition(const dfloat targetFraction[2]);
 
 
+  /*Greedy boundary refinement of a bisection*/
+  void RefineBipartition(memory<int>& partition,
+                         const dfloat targetFraction[2]);
+
+  /*Hilbert curve index of element centers*/
+  int HilbertKeyBits();
+  void HilbertKeys(memory<hlong>& keys, const bool local);
+
+  /*Apply new rank-local element ids*/
+  void Reorder(memory<hlong>& newId);
+
+  /*Fraction of local face neighbors within window elements of each other*/
+  dfloat SurfaceReuse(const int window);
+
+  /*Global edge cut and communication volume of current partition*/
+  void CutStats(hlong& cut, hlong& volume);
+
+  /*Number of ranks holding the first half of a bisection*/
+  int BisectionSize();
+
   /*Divide graph into two pieces according to a bisection*/
   void Split(const memory<int>& partition);
 
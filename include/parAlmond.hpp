@@ -42,6 +42,8 @@ namespace parAlmond {
 void AddSettings(settings_t& settings, const std::string prefix="");
 void ReportSettings(settings_t& settings);
 
+class parGlobalCSR;
+
 //distributed matrix class passed to AMG setup
 class parCOO {
 public:
@@ -63,6 +65,33 @@ public:
   parCOO() = default;
   parCOO(platform_t &_platform, comm_t _comm):
     platform(_platform), comm(_comm) {};
+
+  //expand a distributed CSR matrix
+  parCOO(parGlobalCSR& A);
+};
+
+//distributed row-compressed matrix class passed to AMG setup
+//-- rows are the locally owned rows, columns are global ids sorted within each row
+class parGlobalCSR {
+public:
+  platform_t platform;
+  comm_t comm;
+
+  dlong Nrows=0;
+  dlong nnz=0;
+  memory<hlong> globalRowStarts;
+  memory<hlong> globalColStarts;
+
+  memory<dlong>  rowStarts;
+  memory<hlong>  cols;
+  memory<dfloat> vals;
+
+  parGlobalCSR() = default;
+  parGlobalCSR(platform_t &_platform, comm_t _comm):
+    platform(_platform), comm(_comm) {};
+
+  //compress a row-sorted distributed COO matrix
+  parGlobalCSR(parCOO& A);
 };
 
 //abstract multigrid level
@@ -98,6 +127,7 @@ typedef enum {RUGESTUBEN=0,SYMMETRIC=1} StrengthType;
 typedef enum {COARSEEXACT=0,COARSEOAS=1} CoarseType;
 
 class coarseSolver_t;
+class parCSR;
 
 //multigrid preconditioner
 class multigrid_t: public operator_t {
@@ -219,6 +249,10 @@ public:
                bool nullSpace,
                memory<dfloat> nullVector,
                dfloat nullSpacePenalty);
+  void AMGSetup(parGlobalCSR& A,
+               bool nullSpace,
+               memory<dfloat> nullVector,
+               dfloat nullSpacePenalty);
 
   void Operator(deviceMemory<dfloat>& o_rhs, deviceMemory<dfloat>& o_x);
 
@@ -231,6 +265,11 @@ private:
   settings_t settings;
 
   std::shared_ptr<multigrid_t> multigrid=nullptr;
+
+  void AMGSetupLevels(parCSR& A,
+                      bool nullSpace,
+                      memory<dfloat> nullVector,
+                      dfloat nullSpacePenalty);
 };
 
 } //namespace parAlmond
@@ -101,6 +101,9 @@ public:
   //build a parCSR matrix from a distributed COO matrix
   parCSR(parCOO& A);
 
+  //build a parCSR matrix from a distributed, globally indexed CSR matrix
+  parCSR(parGlobalCSR& A);
+
   void haloSetup(memory<hlong> colIds);
 
   void diagSetup();
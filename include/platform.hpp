@@ -38,6 +38,7 @@ SOFTWARE.
 #include "comm.hpp"
 #include "settings.hpp"
 #include "linAlg.hpp"
+#include "profiler.hpp"
 
 namespace libp {
 
@@ -66,6 +67,7 @@ public:
   private:
   std::shared_ptr<internal::iplatform_t> iplatform;
   std::shared_ptr<linAlg_t> ilinAlg;
+  std::shared_ptr<profiler_t> iprofiler;
 
  public:
   comm_t comm;
@@ -99,6 +101,7 @@ public:
     DeviceProperties();
 
     ilinAlg = std::make_shared<linAlg_t>(this);
+    iprofiler = std::make_shared<profiler_t>(this);
   }
 
   platform_t(const platform_t &other)=default;
@@ -189,6 +192,11 @@ public:
     return *ilinAlg;
   }
 
+  profiler_t& profiler() {
+    assertInitialized();
+    return *iprofiler;
+  }
+
   settings_t& settings() {
     assertInitialized();
     return iplatform->settings;
@@ -46,6 +46,13 @@ class precon_t: public operator_t {
     precon = std::make_shared<Precon>(args...);
   }
 
+  /*Access the wrapped Precon object*/
+  template<class Precon>
+  Precon& Get() {
+    assertInitialized();
+    return dynamic_cast<Precon&>(*precon);
+  }
+
  private:
   std::shared_ptr<operator_t> precon=nullptr;
 
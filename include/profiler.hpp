@@ -0,0 +1,106 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#ifndef LIBP_PROFILER_HPP
+#define LIBP_PROFILER_HPP
+
+#include "core.hpp"
+#include <chrono>
+#include <vector>
+
+namespace libp {
+
+//forward declare
+class platform_t;
+
+/* Per-rank performance counters and timeline of a time stepping run.
+   Disabled by default, in which case Tic/Toc reduce to a single branch. */
+class profiler_t {
+ public:
+  enum region_t {
+    Rhs=0,      //solver rhs evaluation
+    HaloStart,  //halo exchange start
+    HaloFinish, //halo exchange finish, including the MPI wait
+    Update,     //time step, exclusive of the regions nested in it
+    Output,     //solver report and output
+    Nregions
+  };
+
+  profiler_t(platform_t *_platform): platform(_platform) {}
+
+  //start counting. Ndofs is the global number of unknowns updated per step
+  void Enable(const hlong _Ndofs, const bool _timeline);
+  void Disable() { enabled = false; }
+  bool Enabled() const { return enabled; }
+
+  void Tic(const region_t region) { if (enabled) Start(region); }
+  void Toc(const region_t region) { if (enabled) Stop(region); }
+
+  //print counters reduced over comm, with min/avg/max per rank
+  void Report(comm_t comm);
+
+  //write this rank's timeline as Chrome trace-event JSON
+  void WriteTrace(const std::string fileName, const int rank);
+
+ private:
+  using hrclock_t = std::chrono::high_resolution_clock;
+
+  struct frame_t {
+    region_t region;
+    hrclock_t::time_point start;
+    double children;
+  };
+
+  struct event_t {
+    region_t region;
+    double start, duration;
+  };
+
+  platform_t *platform;
+
+  bool enabled=false;
+  bool timeline=false;
+
+  hlong Ndofs=0;
+  hrclock_t::time_point startTime;
+
+  double inclusive[Nregions];
+  double exclusive[Nregions];
+  long long int counts[Nregions];
+
+  std::vector<frame_t> stack;
+  std::vector<event_t> events;
+
+  void Start(const region_t region);
+  void Stop(const region_t region);
+
+  static const char* Name(const region_t region);
+};
+
+} //namespace libp
+
+#endif
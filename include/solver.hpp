@@ -53,6 +53,12 @@ public:
     LIBP_FORCE_ABORT("Report not implemented in this solver");
   }
 
+  //Largest stable time step for state q at the given time, used by adaptive steppers
+  virtual dfloat MaxTimeStep(deviceMemory<dfloat>& o_q, const dfloat time) {
+    LIBP_FORCE_ABORT("MaxTimeStep not implemented in this solver");
+    return 0.0;
+  }
+
   //Full rhs evaluation of solver in form dq/dt = rhsf(q,t)
   virtual void rhsf(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time) {
     LIBP_FORCE_ABORT("rhsf not implemented in this solver");
@@ -74,9 +80,10 @@ public:
     LIBP_FORCE_ABORT("rhs_imex_invg not implemented in this solver");
   }
 
-  // Evolve rhs f function via a sub-timestepper
+  // Evolve rhs f function via a sub-timestepper. dt[0] is the step being taken
+  //  and dt[n] the step from history state n to history state n-1
   virtual void rhs_subcycle_f(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_QHAT,
-                           const dfloat T, const dfloat dt, const memory<dfloat> B,
+                           const dfloat T, const memory<dfloat> dt, const memory<dfloat> B,
                            const int order, const int shiftIndex, const int maxOrder) {
     LIBP_FORCE_ABORT("Subcycling not implemented in this solver");
   }
@@ -86,6 +93,15 @@ public:
     LIBP_FORCE_ABORT("rhsf_MR not implemented in this solver");
   }
 
+  //Full rhs evaluation fused with a low-storage Runge-Kutta stage update
+  //  res = rka*res + dt*rhsf(q,t), qnext = q + rkb*res
+  virtual void rhsf_lsrk(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_qnext,
+                         deviceMemory<dfloat>& o_rhs, deviceMemory<dfloat>& o_res,
+                         const dfloat time, const dfloat dt,
+                         const dfloat rka, const dfloat rkb) {
+    LIBP_FORCE_ABORT("rhsf_lsrk not implemented in this solver");
+  }
+
   //Full rhs evaluation of solver in form dq/dt = rhsf(q,t) with a perfectly matched layer (PML)
   virtual void rhsf_pml(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_pmlq,
                         deviceMemory<dfloat>& o_rhs, deviceMemory<dfloat>& o_pmlrhs, const dfloat time) {
@@ -99,6 +115,18 @@ public:
     LIBP_FORCE_ABORT("rhsf_MR_pml not implemented in this solver");
   }
 
+  //Repartition the solver's mesh if rank work has become imbalanced, migrating o_q and
+  // solver data. Called after each time step. Returns true, with the new local and halo
+  // element counts, if elements were migrated
+  virtual bool Rebalance(deviceMemory<dfloat>& o_q, dlong& Nelements, dlong& NhaloElements) {
+    return false;
+  }
+
+  //Migrate element-blocked data with Nentries per element to follow the last Rebalance
+  virtual void Migrate(deviceMemory<dfloat>& o_data, const int Nentries) {
+    LIBP_FORCE_ABORT("Migrate not implemented in this solver");
+  }
+
   //Evaluation of solver as a operator in the form A(q)
   virtual void Operator(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Aq) {
     LIBP_FORCE_ABORT("Operator not implemented in this solver");
@@ -31,6 +31,8 @@ SOFTWARE.
 #include "settings.hpp"
 #include "mesh.hpp"
 #include "solver.hpp"
+#include <complex>
+#include <functional>
 
 namespace libp {
 
@@ -56,6 +58,8 @@ class timeStepper_t {
 
   dfloat GetGamma();
 
+  void EnableAdaptiveTimeStep();
+
  private:
   std::shared_ptr<TimeStepper::timeStepperBase_t> ts=nullptr;
 
@@ -72,6 +76,7 @@ public:
 
   dlong N;
   dlong Nhalo;
+  int Nentries; //entries per element
 
   dfloat dt;
 
@@ -81,10 +86,22 @@ public:
     platform(_platform),
     comm(_comm),
     N(Nelements*Np*Nfields),
-    Nhalo(NhaloElements*Np*Nfields) {}
+    Nhalo(NhaloElements*Np*Nfields),
+    Nentries(Np*Nfields) {}
 
   virtual void Run(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat start, dfloat end)=0;
 
+  //Let the solver rebalance its mesh after a step, and migrate stepper data if it did
+  void Rebalance(solver_t& solver, deviceMemory<dfloat>& o_q) {
+    dlong Nelements=0, NhaloElements=0;
+    if (solver.Rebalance(o_q, Nelements, NhaloElements))
+      Migrate(solver, Nelements, NhaloElements);
+  }
+
+  virtual void Migrate(solver_t& solver, const dlong Nelements, const dlong NhaloElements) {
+    LIBP_FORCE_ABORT("Load rebalancing not available in this Timestepper");
+  }
+
   void SetTimeStep(dfloat dt_) {dt = dt_;};
 
   dfloat GetTimeStep() {return dt;};
@@ -93,6 +110,55 @@ public:
     LIBP_FORCE_ABORT("GetGamma() not available in this Timestepper");
     return 0.0;
   }
+
+  virtual void EnableAdaptiveTimeStep() {
+    LIBP_FORCE_ABORT("Adaptive time stepping not available in this Timestepper");
+  }
+
+protected:
+  //largest step allowed by the solver's stability limit for state q,
+  // growing by at most maxGrowth over the current step
+  dfloat ControlTimeStep(solver_t& solver, deviceMemory<dfloat>& o_q,
+                         const dfloat time, const dfloat maxGrowth);
+
+  //monomial coefficients c[0..Nnodes-1] of the Lagrange polynomial
+  // through the given nodes which is one at nodes[i]
+  static void LagrangePolynomial(const int Nnodes, const memory<dfloat> nodes,
+                                 const int i, memory<dfloat> c);
+};
+
+/* Stiff linear relaxation operator L of the semi-analytic integrators. L is
+   given either as Nfields diagonal entries or as a dense, row-major
+   Nfields x Nfields matrix, and scalar coefficient functions phi(h*lambda)
+   are lifted to phi(h*L) through the eigendecomposition L = V W V^{-1}.
+   A matrix always takes the dense update kernels, even if it is diagonal. */
+class relaxation_t {
+public:
+  int Nfields=0;
+  bool dense=false;
+  int Nlambda=0; //Nfields if diagonal, Nfields*Nfields if dense
+
+  //integrand(lr, c) evaluates the Ncoeffs coefficient integrands at lr
+  using integrand_t = std::function<void(const std::complex<double>, std::complex<double>*)>;
+
+  relaxation_t() = default;
+  relaxation_t(const int _Nfields, const memory<dfloat> L) {
+    Setup(_Nfields, L);
+  }
+
+  void Setup(const int _Nfields, const memory<dfloat> L);
+
+  //Contour integral evaluation of the coefficient functions at h*L
+  // coeffs[c + m*Ncoeffs], with m = f (diagonal) or m = f*Nfields+g (dense)
+  void Evaluate(const dfloat h, const int Ncoeffs,
+                integrand_t integrand, memory<dfloat> coeffs) const;
+
+private:
+  memory<dfloat> lambda;
+  memory<std::complex<double>> W, V, invV;
+
+  void ContourIntegral(const std::complex<double> alpha, const int Ncoeffs,
+                       integrand_t& integrand, std::complex<double>* c) const;
 };
 
 /* Adams Bashforth, order 3 */
@@ -108,18 +174,29 @@ protected:
 
   kernel_t updateKernel;
 
+  //variable step sizes, most recent first
+  bool adaptive;
+  memory<dfloat> dtHistory;
+
+  void UpdateCoefficients(const int order, const dfloat _dt);
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
+  void Migrate(solver_t& solver, const dlong Nelements, const dlong NhaloElements) override;
+
 public:
   ab3(dlong Nelements, dlong NhaloElements,
       int Np, int Nfields,
       platform_t& _platform, comm_t _comm);
 
+  void EnableAdaptiveTimeStep() override {adaptive = true;}
+
   void Run(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat start, dfloat end);
 };
 
-/* Low-Storage Explicit Runge-Kutta, order 4 */
-class lserk4: public timeStepperBase_t {
+/* Generic low-storage (2N) explicit Runge-Kutta */
+/* Coefficients are taken from a named built-in tableau or read from a file */
+class lsrk: public timeStepperBase_t {
 protected:
   int Nrk;
   memory<dfloat> rka, rkb, rkc;
@@ -129,18 +206,37 @@ protected:
 
   deviceMemory<dfloat> o_saveq;
 
+  //fused stages write the updated state to o_qnext, which is then swapped with o_q
+  bool fused;
+  deviceMemory<dfloat> o_qnext;
+
   kernel_t updateKernel;
 
+  void LoadTableau(const std::string tableau);
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt);
 
+  void Migrate(solver_t& solver, const dlong Nelements, const dlong NhaloElements) override;
+
 public:
-  lserk4(dlong Nelements, dlong NhaloElements,
-         int Np, int Nfields,
-         platform_t& _platform, comm_t _comm);
+  lsrk(dlong Nelements, dlong NhaloElements,
+       int Np, int Nfields,
+       platform_t& _platform, comm_t _comm,
+       const std::string tableau,
+       const bool _fused=false);
 
   void Run(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat start, dfloat end);
 };
 
+/* Low-Storage Explicit Runge-Kutta, order 4 */
+class lserk4: public lsrk {
+public:
+  lserk4(dlong Nelements, dlong NhaloElements,
+         int Np, int Nfields,
+         platform_t& _platform, comm_t _comm,
+         const bool _fused=false);
+};
+
 /* Dormand-Prince method */
 /* Explict Runge-Kutta, order 5 with embedded order 4 and adaptive time-stepping */
 class dopri5: public timeStepperBase_t {
@@ -191,6 +287,8 @@ protected:
 
   virtual dfloat Estimater(deviceMemory<dfloat>& o_q);
 
+  void Migrate(solver_t& solver, const dlong Nelements, const dlong NhaloElements) override;
+
 public:
   dopri5(dlong Nelements, dlong NhaloElements,
          int Np, int Nfields,
@@ -208,7 +306,7 @@ protected:
   int Np, Nfields;
   dlong Nblock, Nelements, NhaloElements;
 
-  memory<dfloat> lambda;
+  relaxation_t relaxation;
 
   pinnedMemory<dfloat> h_saab_x, h_saab_a;
   deviceMemory<dfloat> o_saab_x, o_saab_a;
@@ -239,7 +337,7 @@ protected:
   int Np, Nfields;
   dlong Nblock, Nelements, NhaloElements;
 
-  memory<dfloat> lambda;
+  relaxation_t relaxation;
 
   memory<dfloat> rkC;
   deviceMemory<dfloat> o_rkX, o_rkA, o_rkE;
@@ -303,7 +401,7 @@ protected:
   int Np, Nfields;
   dlong Nblock, Nelements, NhaloElements;
 
-  memory<dfloat> lambda;
+  relaxation_t relaxation;
 
   memory<dfloat> rkC;
   deviceMemory<dfloat> o_rkX, o_rkA, o_rkE;
@@ -376,6 +474,12 @@ protected:
 
   kernel_t rhsKernel;
 
+  //variable step sizes, most recent first
+  bool adaptive;
+  memory<dfloat> dtHistory;
+
+  void UpdateCoefficients(const int order, const dfloat _dt);
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
 public:
@@ -385,6 +489,8 @@ public:
 
   dfloat GetGamma();
 
+  void EnableAdaptiveTimeStep() override {adaptive = true;}
+
   void Run(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat start, dfloat end);
 };
 
@@ -403,6 +509,12 @@ protected:
 
   kernel_t rhsKernel;
 
+  //variable step sizes, most recent first
+  bool adaptive;
+  memory<dfloat> dtHistory;
+
+  void UpdateCoefficients(const int order, const dfloat _dt);
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
 public:
@@ -412,6 +524,74 @@ public:
 
   dfloat GetGamma();
 
+  void EnableAdaptiveTimeStep() override {adaptive = true;}
+
+  void Run(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat start, dfloat end);
+};
+
+/* Additive implicit-explicit Runge-Kutta (ARK3(2)4L[2]SA or ARK4(3)6L[2]SA) */
+/* ESDIRK implicit part with embedded error estimate and adaptive time-stepping */
+class ark: public timeStepperBase_t {
+protected:
+  int Nrk;
+
+  dlong Nblock;
+
+  //explicit and implicit tableaus share nodes and weights
+  memory<dfloat> rkC, rkAe, rkAi, rkB, rkE;
+  deviceMemory<dfloat> o_rkAe, o_rkAi, o_rkB, o_rkE;
+  dfloat rkGamma; //diagonal of the implicit tableau
+  int embeddedOrder;
+
+  deviceMemory<dfloat> o_errtmp;
+  pinnedMemory<dfloat> h_errtmp;
+
+  deviceMemory<dfloat> o_rkq;
+  deviceMemory<dfloat> o_rkF;
+  deviceMemory<dfloat> o_rkG;
+  deviceMemory<dfloat> o_rkS;
+  deviceMemory<dfloat> o_rhs;
+  deviceMemory<dfloat> o_rkerr;
+
+  kernel_t rkStageKernel;
+  kernel_t rkImplicitKernel;
+  kernel_t rkUpdateKernel;
+  kernel_t rkErrorEstimateKernel;
+
+  dfloat dtMIN; //minumum allowed timestep
+  dfloat ATOL;  //absolute error tolerance
+  dfloat RTOL;  //relative error tolerance
+  dfloat safe;   //safety factor
+
+  //error control parameters
+  dfloat beta;
+  dfloat factor1;
+  dfloat factor2;
+
+  dfloat exp1;
+  dfloat invfactor1;
+  dfloat invfactor2;
+  dfloat facold;
+  dfloat sqrtinvNtotal;
+
+  void LoadTableau(const std::string scheme);
+
+  void AllocateStages();
+
+  virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt);
+
+  virtual dfloat Estimater(deviceMemory<dfloat>& o_q);
+
+  void Migrate(solver_t& solver, const dlong Nelements, const dlong NhaloElements) override;
+
+public:
+  ark(dlong Nelements, dlong NhaloElements,
+      int Np, int Nfields,
+      platform_t& _platform, comm_t _comm,
+      const std::string scheme);
+
+  dfloat GetGamma();
+
   void Run(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat start, dfloat end);
 };
 
@@ -438,6 +618,10 @@ protected:
   kernel_t updateKernel;
   kernel_t traceUpdateKernel;
 
+  //time spent in the all-level rhs and update, i.e. the work of single-rate steps
+  bool timeSingleRate=false;
+  double singleRateTime=0.0;
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
 public:
@@ -457,7 +641,7 @@ protected:
   int Nlevels;
   int Nfields;
 
-  memory<dfloat> lambda;
+  relaxation_t relaxation;
 
   deviceMemory<int> o_shiftIndex;
   pinnedMemory<int> h_shiftIndex;
@@ -473,6 +657,10 @@ protected:
   kernel_t updateKernel;
   kernel_t traceUpdateKernel;
 
+  //time spent in the all-level rhs and update, i.e. the work of single-rate steps
+  bool timeSingleRate=false;
+  double singleRateTime=0.0;
+
   virtual void Step(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat time, dfloat dt, int order);
 
   void UpdateCoefficients();
@@ -487,6 +675,43 @@ public:
   void Run(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat start, dfloat end);
 };
 
+/* Parareal parallel-in-time driver */
+/* Each rank of timeComm owns one time slice and a copy of the spatial problem. */
+/* The fine and coarse propagators are any pair of steppers set up by the solver. */
+class parareal: public timeStepperBase_t {
+protected:
+  comm_t timeComm;
+
+  timeStepper_t fine, coarse;
+  dfloat coarseFactor; //coarse dt = coarseFactor*dt
+
+  int maxIterations;
+  dfloat tolerance;
+
+  deviceMemory<dfloat> o_U, o_Unext;
+  deviceMemory<dfloat> o_F, o_G, o_Gnew;
+  memory<dfloat> h_U;
+
+  void Propagate(solver_t& solver, timeStepper_t& stepper,
+                 deviceMemory<dfloat>& o_in, deviceMemory<dfloat>& o_out,
+                 dfloat start, dfloat end);
+
+public:
+  parareal(dlong Nelements, dlong NhaloElements,
+           int Np, int Nfields,
+           platform_t& _platform, comm_t _comm, comm_t _timeComm,
+           timeStepper_t& _fine, timeStepper_t& _coarse,
+           const dfloat _coarseFactor,
+           const int _maxIterations, const dfloat _tolerance);
+
+  void Run(solver_t& solver, deviceMemory<dfloat>& o_q, dfloat start, dfloat end);
+
+  //split comm into Nslices time slices. Ranks of spaceComm share a slice
+  // and ranks of timeComm share a spatial partition
+  static void SplitComm(comm_t comm, const int Nslices,
+                        comm_t& spaceComm, comm_t& timeComm);
+};
+
 
 /**************************************************/
 /* Derived Time Integrators which step PML fields */
@@ -87,6 +87,24 @@ comm_t comm_t::Split(const int color, const int key) const {
   return c;
 }
 
+/*Split into shared memory (i.e. node-local) communicators*/
+comm_t comm_t::SplitShared(const int key) const {
+  comm_t c;
+  /*Make a new comm shared_ptr, which will call MPI_Comm_free when destroyed*/
+  c.comm_ptr = std::shared_ptr<MPI_Comm>(new MPI_Comm,
+                                        [](MPI_Comm *comm) {
+                                          if (*comm != MPI_COMM_NULL)
+                                            MPI_Comm_free(comm);
+                                          delete comm;
+                                        });
+
+  MPI_Comm_split_type(comm(), MPI_COMM_TYPE_SHARED, key,
+                      MPI_INFO_NULL, c.comm_ptr.get());
+  MPI_Comm_rank(c.comm(), &(c._rank));
+  MPI_Comm_size(c.comm(), &(c._size));
+  return c;
+}
+
 /*Rank and size getters*/
 const int comm_t::rank() const {
   return _rank;
@@ -53,6 +53,20 @@ platformSettings_t::platformSettings_t(comm_t _comm):
   newSetting("CACHE DIR",
              LIBP_DIR "/.occa",
              "Path for OCCA to place kernel cache");
+
+  newSetting("PROFILE",
+             "FALSE",
+             "Collect time stepper performance counters",
+             {"TRUE", "FALSE"});
+
+  newSetting("PROFILE TRACE",
+             "FALSE",
+             "Write a per-rank Chrome trace-event timeline of the time stepper",
+             {"TRUE", "FALSE"});
+
+  newSetting("PROFILE TRACE FILE NAME",
+             "trace",
+             "Trace file name prefix, rank r writes <prefix>_r.json");
 }
 
 void platformSettings_t::report() {
@@ -70,6 +84,13 @@ void platformSettings_t::report() {
         ||compareSetting("THREAD MODEL","HIP")
         ||compareSetting("THREAD MODEL","OpenCL") ))
       reportSetting("DEVICE NUMBER");
+
+    reportSetting("PROFILE");
+    if (compareSetting("PROFILE","TRUE")) {
+      reportSetting("PROFILE TRACE");
+      if (compareSetting("PROFILE TRACE","TRUE"))
+        reportSetting("PROFILE TRACE FILE NAME");
+    }
   }
 }
 
@@ -0,0 +1,176 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "profiler.hpp"
+#include "platform.hpp"
+#include <fstream>
+#include <iomanip>
+
+namespace libp {
+
+const char* profiler_t::Name(const region_t region) {
+  switch (region) {
+    case Rhs:        return "Rhs";
+    case HaloStart:  return "HaloStart";
+    case HaloFinish: return "HaloFinish";
+    case Update:     return "Update";
+    case Output:     return "Output";
+    default:         return "Unknown";
+  }
+}
+
+void profiler_t::Enable(const hlong _Ndofs, const bool _timeline) {
+  enabled = true;
+  timeline = _timeline;
+  Ndofs = _Ndofs;
+
+  for (int r=0;r<Nregions;++r) {
+    inclusive[r] = 0.0;
+    exclusive[r] = 0.0;
+    counts[r] = 0;
+  }
+  stack.clear();
+  events.clear();
+
+  platform->finish();
+  startTime = hrclock_t::now();
+}
+
+void profiler_t::Start(const region_t region) {
+  //device work is attributed to the region that queued it. Halo regions
+  // measure host blocking time only, so they do not serialize the overlap
+  if (region!=HaloStart && region!=HaloFinish) platform->finish();
+
+  stack.push_back({region, hrclock_t::now(), 0.0});
+}
+
+void profiler_t::Stop(const region_t region) {
+  if (region!=HaloStart && region!=HaloFinish) platform->finish();
+
+  const hrclock_t::time_point end = hrclock_t::now();
+
+  LIBP_ABORT("Profiler region " << Name(region) << " stopped out of order",
+             stack.empty() || stack.back().region!=region);
+
+  const frame_t frame = stack.back();
+  stack.pop_back();
+
+  const double elapsed = std::chrono::duration<double>(end-frame.start).count();
+
+  inclusive[region] += elapsed;
+  exclusive[region] += elapsed - frame.children;
+  counts[region]++;
+
+  if (!stack.empty()) stack.back().children += elapsed;
+
+  if (timeline) {
+    const double start = std::chrono::duration<double>(frame.start-startTime).count();
+    events.push_back({region, start, elapsed});
+  }
+}
+
+void profiler_t::Report(comm_t comm) {
+  platform->finish();
+  const double wallTime = std::chrono::duration<double>(hrclock_t::now()-startTime).count();
+
+  double maxWallTime = wallTime;
+  comm.Allreduce(maxWallTime, Comm::Max);
+
+  //steps are counted on every rank, take the max in case a rank had none
+  long long int Nsteps = counts[Update];
+  comm.Allreduce(Nsteps, Comm::Max);
+
+  const int size = comm.size();
+
+  if (comm.rank()==0) {
+    std::cout << "Time stepper profile (" << size << " ranks):\n";
+    std::cout << std::setw(12) << "region"
+              << std::setw(12) << "calls"
+              << std::setw(14) << "min [s]"
+              << std::setw(14) << "avg [s]"
+              << std::setw(14) << "max [s]"
+              << std::setw(12) << "max/avg"
+              << "\n";
+  }
+
+  for (int r=0;r<Nregions;++r) {
+    const region_t region = static_cast<region_t>(r);
+
+    //update time is reported exclusive of the rhs, halo, and output nested in it
+    const double time = (region==Update) ? exclusive[r] : inclusive[r];
+
+    double minTime=time, maxTime=time, avgTime=time;
+    comm.Allreduce(minTime, Comm::Min);
+    comm.Allreduce(maxTime, Comm::Max);
+    comm.Allreduce(avgTime, Comm::Sum);
+    avgTime /= size;
+
+    long long int calls = counts[r];
+    comm.Allreduce(calls, Comm::Max);
+
+    if (comm.rank()==0 && calls>0) {
+      std::cout << std::setw(12) << Name(region)
+                << std::setw(12) << calls
+                << std::setw(14) << std::scientific << std::setprecision(4) << minTime
+                << std::setw(14) << avgTime
+                << std::setw(14) << maxTime
+                << std::setw(12) << std::fixed << std::setprecision(3)
+                << ((avgTime>0.0) ? maxTime/avgTime : 1.0)
+                << "\n";
+    }
+  }
+
+  if (comm.rank()==0) {
+    std::cout << std::scientific << std::setprecision(4);
+    std::cout << "Wall time = " << maxWallTime << " s, "
+              << "steps = " << Nsteps << ", "
+              << "steps/s = " << Nsteps/maxWallTime << ", "
+              << "DOF updates/s = " << static_cast<double>(Ndofs)*Nsteps/maxWallTime
+              << std::endl;
+    std::cout << std::defaultfloat;
+  }
+}
+
+void profiler_t::WriteTrace(const std::string fileName, const int rank) {
+  std::ofstream file(fileName);
+  LIBP_ABORT("Could not open trace file " << fileName, !file.is_open());
+
+  //timestamps and durations are in microseconds, one process per rank
+  file << "{\"traceEvents\":[\n";
+  file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+       << ",\"tid\":0,\"args\":{\"name\":\"rank " << rank << "\"}}";
+  file << std::fixed << std::setprecision(3);
+  for (const event_t& event : events) {
+    file << ",\n{\"name\":\"" << Name(event.region) << "\",\"ph\":\"X\""
+         << ",\"pid\":" << rank << ",\"tid\":0"
+         << ",\"ts\":" << 1.0e6*event.start
+         << ",\"dur\":" << 1.0e6*event.duration << "}";
+  }
+  file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+} //namespace libp
@@ -100,6 +100,37 @@ void linAlg_t::zadxpy(const dlong N, const dfloat alpha,
   zadxpyKernel(N, alpha, o_a, o_x, beta, o_y, o_z);
 }
 
+/****************************/
+/* batched block operations */
+/****************************/
+
+// o_y_e = alpha*A_e*o_x_e + beta*o_y_e, A_e = o_A + e*strideA
+void linAlg_t::batchedGEMV(const dlong Nbatch, const int M, const int N,
+                           const dfloat alpha, deviceMemory<dfloat> o_A, const dlong strideA,
+                           deviceMemory<dfloat> o_x,
+                           const dfloat beta, deviceMemory<dfloat> o_y) {
+  auto kernel = batchedGEMVKernels.find(std::make_pair(M, N));
+  LIBP_ABORT("Batched GEMV not initialized for " << M << "x" << N << " blocks",
+             kernel==batchedGEMVKernels.end());
+
+  if (Nbatch)
+    kernel->second(Nbatch, alpha, o_A, strideA, o_x, beta, o_y);
+}
+
+// o_y_e = alpha*o_s[e]*A_e*o_x_e + beta*o_y_e
+void linAlg_t::batchedGEMV(const dlong Nbatch, const int M, const int N,
+                           const dfloat alpha, deviceMemory<dfloat> o_s,
+                           deviceMemory<dfloat> o_A, const dlong strideA,
+                           deviceMemory<dfloat> o_x,
+                           const dfloat beta, deviceMemory<dfloat> o_y) {
+  auto kernel = batchedScaledGEMVKernels.find(std::make_pair(M, N));
+  LIBP_ABORT("Batched GEMV not initialized for " << M << "x" << N << " blocks",
+             kernel==batchedScaledGEMVKernels.end());
+
+  if (Nbatch)
+    kernel->second(Nbatch, alpha, o_s, o_A, strideA, o_x, beta, o_y);
+}
+
 // \min o_a
 dfloat linAlg_t::min(const dlong N, deviceMemory<dfloat> o_a, comm_t comm) {
   int Nblock = (N+blocksize-1)/blocksize;
@@ -25,6 +25,7 @@ SOFTWARE.
 */
 
 #include "linAlg.hpp"
+#include "omp.h"
 
 extern "C" {
   void dgetrf_(int* M, int *N, double* A, int* lda, int* IPIV, int* INFO);
@@ -72,4 +73,66 @@ void linAlg_t::matrixInverse(const int N, memory<float> A){
   LIBP_ABORT("sgetri_ reports info = " << info, info);
 }
 
+void linAlg_t::matrixInverseBatched(const dlong Nbatch, const int N, memory<double> A){
+  int lwork = N*N;
+
+  // each thread gets its own pivots and workspace
+  const int Nthreads = omp_get_max_threads();
+  memory<int> ipiv(Nthreads*N);
+  memory<double> work(Nthreads*lwork);
+  memory<int> info(Nbatch, 0);
+
+  // invert each N x N block in-place
+  #pragma omp parallel for
+  for (dlong b=0;b<Nbatch;b++) {
+    const int t = omp_get_thread_num();
+    int n = N;
+    int lw = lwork;
+    double *Ab = A.ptr() + static_cast<size_t>(b)*N*N;
+    int *ipivt = ipiv.ptr() + t*N;
+    double *workt = work.ptr() + static_cast<size_t>(t)*lwork;
+
+    dgetrf_ (&n, &n, Ab, &n, ipivt, info.ptr()+b);
+    if (info[b]) continue;
+
+    dgetri_ (&n, Ab, &n, ipivt, workt, &lw, info.ptr()+b);
+  }
+
+  // report failures outside the parallel region
+  for (dlong b=0;b<Nbatch;b++) {
+    LIBP_ABORT("dgetrf_/dgetri_ reports info = " << info[b] << " in block " << b, info[b]);
+  }
+}
+
+void linAlg_t::matrixInverseBatched(const dlong Nbatch, const int N, memory<float> A){
+  int lwork = N*N;
+
+  // each thread gets its own pivots and workspace
+  const int Nthreads = omp_get_max_threads();
+  memory<int> ipiv(Nthreads*N);
+  memory<float> work(Nthreads*lwork);
+  memory<int> info(Nbatch, 0);
+
+  // invert each N x N block in-place
+  #pragma omp parallel for
+  for (dlong b=0;b<Nbatch;b++) {
+    const int t = omp_get_thread_num();
+    int n = N;
+    int lw = lwork;
+    float *Ab = A.ptr() + static_cast<size_t>(b)*N*N;
+    int *ipivt = ipiv.ptr() + t*N;
+    float *workt = work.ptr() + static_cast<size_t>(t)*lwork;
+
+    sgetrf_ (&n, &n, Ab, &n, ipivt, info.ptr()+b);
+    if (info[b]) continue;
+
+    sgetri_ (&n, Ab, &n, ipivt, workt, &lw, info.ptr()+b);
+  }
+
+  // report failures outside the parallel region
+  for (dlong b=0;b<Nbatch;b++) {
+    LIBP_ABORT("sgetrf_/sgetri_ reports info = " << info[b] << " in block " << b, info[b]);
+  }
+}
+
 } //namespace libp
@@ -201,4 +201,32 @@ void linAlg_t::InitKernels(std::vector<std::string> kernels) {
   }
 }
 
+//initialize batched GEMV kernels for M x N blocks
+void linAlg_t::InitBatchedGEMV(const int M, const int N) {
+
+  const std::pair<int,int> key(M, N);
+  if (batchedGEMVKernels.find(key)!=batchedGEMVKernels.end()) return;
+
+  properties_t batchedInfo = kernelInfo;
+  batchedInfo["defines/" "p_M"] = M;
+  batchedInfo["defines/" "p_N"] = N;
+
+  // CPU modes interleave a tile of blocks so the innermost loop runs across
+  // the batch and vectorizes. GPU modes use a thread per row
+  const std::string mode = platform->device.mode();
+  const int interleave = (mode=="Serial" || mode=="OpenMP") ? 1 : 0;
+  const int NblockV = interleave ? 16 : std::max(1, blocksize/M);
+  batchedInfo["defines/" "p_interleave"] = interleave;
+  batchedInfo["defines/" "p_NblockV"] = NblockV;
+
+  batchedGEMVKernels[key] = platform->buildKernel(LINALG_DIR "/okl/"
+                                        "linAlgBatchedGEMV.okl",
+                                        "batchedGEMV",
+                                        batchedInfo);
+  batchedScaledGEMVKernels[key] = platform->buildKernel(LINALG_DIR "/okl/"
+                                        "linAlgBatchedGEMV.okl",
+                                        "batchedScaledGEMV",
+                                        batchedInfo);
+}
+
 } //namespace libp
@@ -362,6 +362,10 @@ Extrap::Extrap(dlong _N, platform_t& _platform, settings_t& _settings, comm_t _c
 
   shift = 0;
 
+  timed = false;
+  time = 0.0;
+  th.malloc(Nhistory, 0.0);
+
   o_xh = platform.malloc<dfloat>(Nhistory*Ntotal);
 
   platform.linAlg().InitKernels({"set"});
@@ -377,9 +381,11 @@ Extrap::Extrap(dlong _N, platform_t& _platform, settings_t& _settings, comm_t _c
 
 void Extrap::FormInitialGuess(deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_rhs)
 {
-  if (entry < Nhistory) {
+  // Once the history is full, timed solves recompute the coefficients from
+  // the actual time levels, since the step size may have changed
+  if (entry < Nhistory || timed) {
     int M, m;
-    if (entry == Nhistory - 1) {
+    if (entry >= Nhistory - 1) {
       settings.getSetting("INITIAL GUESS HISTORY SPACE DIMENSION", M);
       settings.getSetting("INITIAL GUESS EXTRAP DEGREE", m);
     } else {
@@ -399,6 +405,19 @@ void Extrap::FormInitialGuess(deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o
 
     if (M == 1) {
       d[Nhistory - 1] = 1.0;
+    } else if (timed && entry == Nhistory) {
+      // Map the time levels of the M newest entries onto [-1,1]
+      const dfloat t0 = th[(Nhistory - M + shift) % Nhistory];
+      const dfloat t1 = th[(Nhistory - 1 + shift) % Nhistory];
+      memory<dfloat> r(M);
+      for (int i = 0; i < M; i++)
+        r[i] = -1.0 + 2.0*(th[(Nhistory - M + i + shift) % Nhistory] - t0)/(t1 - t0);
+      const dfloat ro = -1.0 + 2.0*(time - t0)/(t1 - t0);
+
+      extrapCoeffs(m, M, r, ro, c);
+
+      for (int i = 0; i < M; i++)
+        d[Nhistory - M + i] = c[i];
     } else {
       extrapCoeffs(m, M, c);
 
@@ -421,7 +440,7 @@ void Extrap::FormInitialGuess(deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o
     o_sparseIds = platform.malloc<int>(sparseIds);
     o_sparseCoeffs = platform.malloc<dfloat>(sparseCoeffs);
 
-    ++entry;
+    if (entry < Nhistory) ++entry;
   }
 
   if (settings.compareSetting("INITIAL GUESS EXTRAP COEFFS METHOD", "MINNORM"))
@@ -435,9 +454,16 @@ void Extrap::Update(operator_t &linearOperator, deviceMemory<dfloat>& o_x, devic
 {
   deviceMemory<dfloat> o_tmp = o_xh + Ntotal*shift;
   o_x.copyTo(o_tmp, Ntotal);
+  th[shift] = time;
   shift = (shift + 1) % Nhistory;
 }
 
+void Extrap::SetTime(const dfloat _time)
+{
+  timed = true;
+  time = _time;
+}
+
 void Extrap::extrapCoeffs(int m, int M, memory<dfloat> c)
 {
   LIBP_ABORT("Extrapolation space dimension (" << M << ") too low for degree (" << m << ").",
@@ -448,14 +474,20 @@ void Extrap::extrapCoeffs(int m, int M, memory<dfloat> c)
   for (int i = 0; i < M; i++)
     r[i] = -1.0 + i*h;
 
-  memory<dfloat> ro(1);
-  ro[0] = 1.0 + h;  // Evaluation point.
+  extrapCoeffs(m, M, r, 1.0 + h, c);
+}
+
+// Extrapolation from history entries at nodes r in [-1,1] to the point ro
+void Extrap::extrapCoeffs(int m, int M, memory<dfloat> r, dfloat ro, memory<dfloat> c)
+{
+  memory<dfloat> ero(1);
+  ero[0] = ro;  // Evaluation point.
 
   memory<dfloat> V;
   mesh_t::Vandermonde1D(m, r, V);
 
   memory<dfloat> b;
-  mesh_t::Vandermonde1D(m, ro, b);
+  mesh_t::Vandermonde1D(m, ero, b);
 
   if (settings.compareSetting("INITIAL GUESS EXTRAP COEFFS METHOD", "MINNORM")) {
     linAlg_t::matrixUnderdeterminedRightSolveMinNorm(M, m + 1, V, b, c);
@@ -43,6 +43,11 @@ int linearSolver_t::Solve(operator_t& linearOperator,
   return iters;
 }
 
+void linearSolver_t::SetInitialGuessTime(const dfloat time) {
+  assertInitialized();
+  ig->SetTime(time);
+}
+
 void linearSolver_t::MakeDefaultInitialGuessStrategy() {
   ig = std::make_shared<InitialGuess::Default>(ls->N, ls->platform,
                                                ls->settings, ls->comm);
@@ -0,0 +1,184 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "mesh.hpp"
+
+namespace libp {
+
+// second order geometric factors and Jacobian at the cubature nodes only,
+// for over-integrated continuous operators
+void mesh_t::CubatureGeometricFactorsHex3D(){
+
+  /* Quadrature data */
+  cubN = N+1;
+  cubNq = cubN+1;
+  cubNp = cubNq*cubNq*cubNq;
+
+  // cubN+1 point Gauss-Legendre quadrature
+  JacobiGQ(0, 0, cubN, cubr, cubw);
+
+  // GLL to GL interpolation matrix
+  InterpolationMatrix1D(N, gllz, cubr, cubInterp);
+
+  //cubature derivates matrix, cubD: differentiate on cubature nodes
+  Dmatrix1D(cubN, cubr, cubr, cubD);
+
+  // add compile time constants to kernels
+  props["defines/" "p_cubNq"]= cubNq;
+  props["defines/" "p_cubNp"]= cubNp;
+
+  // build transposes (we hold matrices as column major on device)
+  memory<dfloat> cubInterpT(cubNq*Nq);
+  linAlg_t::matrixTranspose(cubNq, Nq, cubInterp, Nq, cubInterpT, cubNq);
+
+  o_cubInterp = platform.malloc<dfloat>(Nq*cubNq, cubInterpT);
+  o_cubD      = platform.malloc<dfloat>(cubNq*cubNq, cubD);
+
+  cubwJ.malloc(Nelements*cubNp);
+  cubggeo.malloc(Nelements*Nggeo*cubNp);
+
+  // nine derivatives of the map x_r, x_s, ..., z_t
+  const int Nder = 9;
+
+  #pragma omp parallel
+  {
+    //temp arrays
+    memory<dfloat> dX(Nder*Np);
+    memory<dfloat> dX1(Nq*Nq*cubNq);
+    memory<dfloat> dX2(Nq*cubNq*cubNq);
+    memory<dfloat> cubdX(Nder*cubNp);
+
+    #pragma omp for
+    for(dlong e=0;e<Nelements;++e){ /* for each element */
+
+      //differentiate physical coordinates at the GLL nodes
+      for(int k=0;k<Nq;++k){
+        for(int j=0;j<Nq;++j){
+          for(int i=0;i<Nq;++i){
+            const int n = i + j*Nq + k*Nq*Nq;
+
+            dfloat xr = 0, xs = 0, xt = 0;
+            dfloat yr = 0, ys = 0, yt = 0;
+            dfloat zr = 0, zs = 0, zt = 0;
+            for(int m=0;m<Nq;++m){
+              const dlong idr = e*Np + k*Nq*Nq + j*Nq + m;
+              const dlong ids = e*Np + k*Nq*Nq + m*Nq + i;
+              const dlong idt = e*Np + m*Nq*Nq + j*Nq + i;
+              xr += D[i*Nq+m]*x[idr];
+              xs += D[j*Nq+m]*x[ids];
+              xt += D[k*Nq+m]*x[idt];
+              yr += D[i*Nq+m]*y[idr];
+              ys += D[j*Nq+m]*y[ids];
+              yt += D[k*Nq+m]*y[idt];
+              zr += D[i*Nq+m]*z[idr];
+              zs += D[j*Nq+m]*z[ids];
+              zt += D[k*Nq+m]*z[idt];
+            }
+            dX[0*Np+n] = xr; dX[1*Np+n] = xs; dX[2*Np+n] = xt;
+            dX[3*Np+n] = yr; dX[4*Np+n] = ys; dX[5*Np+n] = yt;
+            dX[6*Np+n] = zr; dX[7*Np+n] = zs; dX[8*Np+n] = zt;
+          }
+        }
+      }
+
+      //interpolate derivatives to cubature, one direction at a time
+      for(int d=0;d<Nder;++d){
+        for(int k=0;k<Nq;++k){
+          for(int j=0;j<Nq;++j){
+            for(int i=0;i<cubNq;++i){
+              dfloat tmp = 0.0;
+              for(int n=0;n<Nq;++n)
+                tmp += cubInterp[i*Nq+n]*dX[d*Np + k*Nq*Nq + j*Nq + n];
+              dX1[k*Nq*cubNq + j*cubNq + i] = tmp;
+            }
+          }
+        }
+
+        for(int k=0;k<Nq;++k){
+          for(int j=0;j<cubNq;++j){
+            for(int i=0;i<cubNq;++i){
+              dfloat tmp = 0.0;
+              for(int n=0;n<Nq;++n)
+                tmp += cubInterp[j*Nq+n]*dX1[k*Nq*cubNq + n*cubNq + i];
+              dX2[k*cubNq*cubNq + j*cubNq + i] = tmp;
+            }
+          }
+        }
+
+        for(int k=0;k<cubNq;++k){
+          for(int j=0;j<cubNq;++j){
+            for(int i=0;i<cubNq;++i){
+              dfloat tmp = 0.0;
+              for(int n=0;n<Nq;++n)
+                tmp += cubInterp[k*Nq+n]*dX2[n*cubNq*cubNq + j*cubNq + i];
+              cubdX[d*cubNp + k*cubNq*cubNq + j*cubNq + i] = tmp;
+            }
+          }
+        }
+      }
+
+      for(int k=0;k<cubNq;++k){
+        for(int j=0;j<cubNq;++j){
+          for(int i=0;i<cubNq;++i){
+            const int n = i + j*cubNq + k*cubNq*cubNq;
+
+            const dfloat xr = cubdX[0*cubNp+n], xs = cubdX[1*cubNp+n], xt = cubdX[2*cubNp+n];
+            const dfloat yr = cubdX[3*cubNp+n], ys = cubdX[4*cubNp+n], yt = cubdX[5*cubNp+n];
+            const dfloat zr = cubdX[6*cubNp+n], zs = cubdX[7*cubNp+n], zt = cubdX[8*cubNp+n];
+
+            /* compute geometric factors for affine coordinate transform*/
+            dfloat J = xr*(ys*zt-zs*yt) - yr*(xs*zt-zs*xt) + zr*(xs*yt-ys*xt);
+
+            LIBP_ABORT("Negative J found at element " << e,
+                       J<1e-12);
+
+            dfloat rx =  (ys*zt - zs*yt)/J, ry = -(xs*zt - zs*xt)/J, rz =  (xs*yt - ys*xt)/J;
+            dfloat sx = -(yr*zt - zr*yt)/J, sy =  (xr*zt - zr*xt)/J, sz = -(xr*yt - yr*xt)/J;
+            dfloat tx =  (yr*zs - zr*ys)/J, ty = -(xr*zs - zr*xs)/J, tz =  (xr*ys - yr*xs)/J;
+
+            dfloat JW = J*cubw[i]*cubw[j]*cubw[k];
+
+            /* store second order geometric factors */
+            const dlong base = Nggeo*cubNp*e + n;
+            cubggeo[base + cubNp*G00ID] = JW*(rx*rx + ry*ry + rz*rz);
+            cubggeo[base + cubNp*G01ID] = JW*(rx*sx + ry*sy + rz*sz);
+            cubggeo[base + cubNp*G02ID] = JW*(rx*tx + ry*ty + rz*tz);
+            cubggeo[base + cubNp*G11ID] = JW*(sx*sx + sy*sy + sz*sz);
+            cubggeo[base + cubNp*G12ID] = JW*(sx*tx + sy*ty + sz*tz);
+            cubggeo[base + cubNp*G22ID] = JW*(tx*tx + ty*ty + tz*tz);
+
+            cubwJ[cubNp*e + n] = JW;
+          }
+        }
+      }
+    }
+  }
+
+  o_cubwJ   = platform.malloc<dfloat>(cubwJ);
+  o_cubggeo = platform.malloc<dfloat>(cubggeo);
+}
+
+} //namespace libp
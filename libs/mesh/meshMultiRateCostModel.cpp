@@ -0,0 +1,285 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "mesh.hpp"
+#include "timer.hpp"
+
+namespace libp {
+
+/* Measure the inputs to the multirate cost model: the per-element cost and
+   launch floor of an element kernel, and the cost of a trace halo exchange */
+void mesh_t::MultiRateCalibrate(const int Nfields) {
+
+  const int Ntests = 10;
+
+  memory<dfloat> q((Nelements+totalHaloPairs)*Np*Nfields, 0.0);
+  deviceMemory<dfloat> o_q  = platform.malloc<dfloat>(q);
+  deviceMemory<dfloat> o_Mq = platform.malloc<dfloat>(q);
+
+  //use the mass matrix operator as a stand-in for the solver's element kernels
+  kernel_t savedKernel = MassMatrixKernel;
+  MassMatrixKernelSetup(Nfields);
+
+  double fullTime=0.0, launchTime=0.0;
+  if (Nelements) {
+    MassMatrixKernel(Nelements, o_wJ, o_MM, o_q, o_Mq); //warm up
+
+    timePoint_t start = PlatformTime(platform);
+    for (int n=0;n<Ntests;++n)
+      MassMatrixKernel(Nelements, o_wJ, o_MM, o_q, o_Mq);
+    timePoint_t end = PlatformTime(platform);
+    fullTime = ElapsedTime(start, end)/Ntests;
+
+    start = PlatformTime(platform);
+    for (int n=0;n<Ntests;++n)
+      MassMatrixKernel(1, o_wJ, o_MM, o_q, o_Mq);
+    end = PlatformTime(platform);
+    launchTime = ElapsedTime(start, end)/Ntests;
+  }
+
+  MassMatrixKernel = savedKernel;
+
+  ogs::halo_t traceHalo = HaloTraceSetup(Nfields);
+  traceHalo.Exchange(o_q, 1); //warm up
+
+  timePoint_t start = GlobalPlatformTime(platform, comm);
+  for (int n=0;n<Ntests;++n)
+    traceHalo.Exchange(o_q, 1);
+  timePoint_t end = GlobalPlatformTime(platform, comm);
+  double exchangeTime = ElapsedTime(start, end)/Ntests;
+
+  mrElementCost  = (Nelements) ? fullTime/Nelements : 0.0;
+  mrLaunchCost   = launchTime;
+  mrExchangeCost = exchangeTime;
+}
+
+/* Predicted cost of an element kernel on N elements */
+static double KernelCost(const dlong N, const double elementCost, const double launchCost) {
+  return (N) ? std::max(launchCost, N*elementCost) : 0.0;
+}
+
+/* Lower any element more than one level above a neighbour, sweeping up from
+   the finest level */
+void mesh_t::MultiRateEnforceLevelDifference(memory<int> level, const int Nlevels) {
+
+  for (int lev=0; lev < Nlevels; lev++){
+
+    halo.Exchange(level, 1);
+
+    for (dlong e=0; e<Nelements;e++) {
+      if (level[e] > lev+1) { //find elements at least 2 levels higher than lev
+        for (int f=0;f<Nfaces;f++) { //check for a level lev neighbour
+          dlong eP = EToE[Nfaces*e+f];
+          if (eP > -1)
+            if (level[eP] == lev)
+              level[e] = lev + 1;  //if one exists, lower the level of this element to lev-1
+        }
+      }
+    }
+  }
+}
+
+/* Predicted average time per finest time step of a level assignment. A tick
+   at level lev evaluates the rhs on every element of level <= lev, exchanges
+   the trace halo, and refreshes the trace on the lev+1 / lev interface */
+double mesh_t::MultiRateTickCost(memory<int> level, const int Nlevels) {
+
+  halo.Exchange(level, 1);
+
+  memory<dlong> levNelements(Nlevels, 0);
+  memory<dlong> levNinterface(Nlevels, 0);
+  for (dlong e=0;e<Nelements;e++) {
+    const int lev = level[e];
+    levNelements[lev]++;
+    for (int f=0;f<Nfaces;f++) {
+      dlong eP = EToE[Nfaces*e+f];
+      if (eP > -1 && level[eP] == lev-1) {
+        levNinterface[lev]++;
+        break;
+      }
+    }
+  }
+
+  //predicted rhs and trace update cost of each level on this rank.
+  // Trace updates only touch face nodes, so are launch bound
+  memory<double> levCost(2*Nlevels, 0.0);
+  dlong Nactive=0;
+  for (int lev=0;lev<Nlevels;lev++) {
+    Nactive += levNelements[lev];
+    levCost[lev]         = KernelCost(Nactive, mrElementCost, mrLaunchCost);
+    levCost[Nlevels+lev] = (levNinterface[lev]) ? mrLaunchCost : 0.0;
+  }
+
+  //each level evaluation waits on the slowest rank
+  comm.Allreduce(levCost, Comm::Max);
+
+  //a tick reaches level lev < Nlevels-1 on a 2^-(lev+1) fraction of ticks,
+  // and the top level on the remaining 2^-(Nlevels-1)
+  double cost=0.0;
+  for (int lev=0;lev<Nlevels;lev++) {
+    const double fraction = std::ldexp(1.0, -std::min(lev+1, Nlevels-1));
+    cost += fraction*(levCost[lev] + mrExchangeCost);
+    if (lev+1<Nlevels) cost += fraction*levCost[Nlevels+lev+1];
+  }
+  return cost;
+}
+
+/* Choose the number of levels and the cutoffs between them so that the
+   predicted time per finest time step is minimized. Elements only ever move to
+   a finer level, so every candidate stays stable. */
+void mesh_t::MultiRateCostModel(memory<dfloat> EToDT, const int Nfields) {
+
+  //fixed costs make the level choice reproducible across machines
+  double elementCost=0.0;
+  settings.getSetting("MULTIRATE ELEMENT COST", elementCost);
+  if (elementCost>0.0) {
+    mrElementCost = elementCost;
+    settings.getSetting("MULTIRATE LAUNCH COST", mrLaunchCost);
+    settings.getSetting("MULTIRATE EXCHANGE COST", mrExchangeCost);
+  } else {
+    MultiRateCalibrate(Nfields);
+  }
+
+  const int Nlevels = mrNlevels;
+  const int Nboundaries = Nlevels-1;
+
+  memory<int> level(Nelements+totalHaloPairs);
+
+  //first merge whole levels. Bit b of a mask keeps the boundary between levels b and b+1
+  const int maxSearch = 8;
+  const int Nmasks = (Nboundaries <= maxSearch) ? (1 << Nboundaries) : Nlevels;
+
+  memory<int> masks(Nmasks);
+  for (int m=0;m<Nmasks;m++)
+    masks[m] = (Nboundaries <= maxSearch) ? m : (1 << m) - 1; //else only cap the level count
+
+  //new level of each original level, under each mask
+  auto newLevel = [&](const int mask, const int lev) {
+    int l=0;
+    for (int b=0;b<lev;b++)
+      if (mask & (1 << b)) l++;
+    return l;
+  };
+
+  int bestMask=0;
+  double bestCost = std::numeric_limits<double>::max();
+  for (int m=0;m<Nmasks;m++) {
+    for (dlong e=0;e<Nelements;e++)
+      level[e] = newLevel(masks[m], mrLevel[e]);
+
+    const double cost = MultiRateTickCost(level, newLevel(masks[m], Nlevels-1)+1);
+    if (cost < bestCost) {
+      bestCost = cost;
+      bestMask = m;
+    }
+  }
+
+  for (dlong e=0;e<Nelements;e++)
+    level[e] = newLevel(masks[bestMask], mrLevel[e]);
+
+  int newNlevels = newLevel(masks[bestMask], Nlevels-1)+1;
+
+  //then search the cutoff between each pair of remaining levels: the elements
+  // of level b+1 with the smallest stable dt may drop to level b
+  const int Ncutoffs = 8;
+  memory<int> trial(Nelements+totalHaloPairs);
+  memory<int> bestLevel(Nelements+totalHaloPairs);
+  for (int b=0;b<newNlevels-1;b++) {
+    dfloat dtLow  = std::numeric_limits<dfloat>::max();
+    dfloat dtHigh = 0.0;
+    for (dlong e=0;e<Nelements;e++) {
+      if (level[e]==b+1) {
+        dtLow  = std::min(dtLow,  EToDT[e]);
+        dtHigh = std::max(dtHigh, EToDT[e]);
+      }
+    }
+    comm.Allreduce(dtLow, Comm::Min);
+    comm.Allreduce(dtHigh, Comm::Max);
+    if (!(dtLow < dtHigh)) continue;
+
+    bool improved = false;
+    for (int k=1;k<Ncutoffs;k++) {
+      const dfloat cutoff = dtLow*std::pow(dtHigh/dtLow, static_cast<dfloat>(k)/Ncutoffs);
+
+      for (dlong e=0;e<Nelements;e++)
+        trial[e] = (level[e]==b+1 && EToDT[e]<cutoff) ? b : level[e];
+      MultiRateEnforceLevelDifference(trial, newNlevels);
+
+      const double cost = MultiRateTickCost(trial, newNlevels);
+      if (cost < bestCost) {
+        bestCost = cost;
+        improved = true;
+        for (dlong e=0;e<Nelements;e++) bestLevel[e] = trial[e];
+      }
+    }
+    if (improved)
+      for (dlong e=0;e<Nelements;e++) level[e] = bestLevel[e];
+  }
+
+  //single-rate stepping evaluates every element each finest time step
+  for (dlong e=0;e<Nelements;e++) trial[e] = 0;
+  const double singleRateCost = MultiRateTickCost(trial, 1);
+
+  mrPredictedSpeedup = singleRateCost/bestCost;
+
+  //achieved speedups are only comparable with measured costs
+  mrMeasuredCosts = !(elementCost>0.0);
+
+  for (dlong e=0;e<Nelements;e++)
+    mrLevel[e] = level[e];
+
+  //a cutoff may have emptied the top level
+  newNlevels = 0;
+  for (dlong e=0;e<Nelements;e++)
+    newNlevels = std::max(mrLevel[e]+1, newNlevels);
+  comm.Allreduce(newNlevels, Comm::Max);
+
+  if (rank==0) {
+    printf("| Cost model: %2d of %2d levels, predicted speedup %6.2f    |\n",
+           newNlevels, Nlevels, mrPredictedSpeedup);
+    printf("-------------------------------------------------------------\n");
+  }
+
+  mrNlevels = newNlevels;
+}
+
+/* Compare the achieved multirate stepping time against single-rate stepping
+   for the same number of finest time steps. The single-rate step time is
+   measured by the time stepper from its all-level rhs and update. */
+void mesh_t::MultiRateReport(const hlong Nticks, const double elapsedTime,
+                             const double singleRateTickTime) {
+
+  if (!mrMeasuredCosts || elapsedTime<=0.0) return;
+
+  const double achievedSpeedup = (Nticks*singleRateTickTime)/elapsedTime;
+
+  if (rank==0)
+    printf("Multirate speedup: predicted %5.2f, achieved %5.2f\n",
+           mrPredictedSpeedup, achievedSpeedup);
+}
+
+} //namespace libp
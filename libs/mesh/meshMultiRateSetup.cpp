@@ -28,7 +28,7 @@ SOFTWARE.
 
 namespace libp {
 
-void mesh_t::MultiRateSetup(memory<dfloat> EToDT) {
+void mesh_t::MultiRateSetup(memory<dfloat> EToDT, const int Nfields) {
 
   const int maxLevels = 100;
 
@@ -63,21 +63,7 @@ void mesh_t::MultiRateSetup(memory<dfloat> EToDT) {
   }
 
   //enforce one level difference between neighbours
-  for (int lev=0; lev < mrNlevels; lev++){
-
-    halo.Exchange(mrLevel, 1);
-
-    for (dlong e=0; e<Nelements;e++) {
-      if (mrLevel[e] > lev+1) { //find elements at least 2 levels higher than lev
-        for (int f=0;f<Nfaces;f++) { //check for a level lev neighbour
-          dlong eP = EToE[Nfaces*e+f];
-          if (eP > -1)
-            if (mrLevel[eP] == lev)
-              mrLevel[e] = lev + 1;  //if one exists, lower the level of this element to lev-1
-        }
-      }
-    }
-  }
+  MultiRateEnforceLevelDifference(mrLevel, mrNlevels);
 
   //this could change the number of levels there are, so find the new max level
   mrNlevels = 0;
@@ -87,6 +73,12 @@ void mesh_t::MultiRateSetup(memory<dfloat> EToDT) {
 
   comm.Allreduce(mrNlevels, Comm::Max);
 
+  //optionally choose the levels and their cutoffs from a cost model
+  if (settings.compareSetting("MULTIRATE LEVEL SELECTION", "COST MODEL")) {
+    MultiRateCostModel(EToDT, Nfields);
+    halo.Exchange(mrLevel, 1);
+  }
+
   //construct element and halo lists
   // mrElements[lev] - list of all elements with multirate level <= lev
   // mrInterfaceElements[lev] - list of all elements with multirate level = lev,
@@ -0,0 +1,118 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "mesh.hpp"
+#include "parAdogs.hpp"
+
+namespace libp {
+
+dfloat mesh_t::LoadImbalance(const double localTime) {
+  double maxTime = localTime;
+  double sumTime = localTime;
+  comm.Allreduce(maxTime, Comm::Max);
+  comm.Allreduce(sumTime, Comm::Sum);
+
+  return (sumTime>0.0) ? static_cast<dfloat>(maxTime*size/sumTime) : 1.0;
+}
+
+void mesh_t::Rebalance(const memory<dfloat>& elementWeights) {
+
+  /*Find the new owner of each element*/
+  memory<int> dest;
+  paradogs::MeshRebalance(platform,
+                          settings,
+                          Nelements,
+                          dim,
+                          Nverts,
+                          Nfaces,
+                          NfaceVertices,
+                          faceVertices,
+                          EToV,
+                          EX,
+                          EY,
+                          EZ,
+                          elementWeights,
+                          dest,
+                          comm);
+
+  /*Record the migration pattern. Elements keep their relative
+    order on the way to each destination rank*/
+  NmigrateElements = Nelements;
+  migrateIds.malloc(Nelements);
+  migrateSendCounts.malloc(size, 0);
+  migrateSendOffsets.malloc(size);
+  migrateRecvCounts.malloc(size);
+  migrateRecvOffsets.malloc(size);
+
+  for (dlong e=0;e<Nelements;++e) migrateSendCounts[dest[e]]++;
+
+  comm.Alltoall(migrateSendCounts, migrateRecvCounts);
+
+  migrateSendOffsets[0]=0;
+  migrateRecvOffsets[0]=0;
+  for (int rr=1;rr<size;++rr) {
+    migrateSendOffsets[rr] = migrateSendOffsets[rr-1] + migrateSendCounts[rr-1];
+    migrateRecvOffsets[rr] = migrateRecvOffsets[rr-1] + migrateRecvCounts[rr-1];
+  }
+
+  memory<int> cnt(size);
+  cnt.copyFrom(migrateSendOffsets);
+  for (dlong e=0;e<Nelements;++e) migrateIds[cnt[dest[e]]++] = e;
+
+  dlong newNelements=0;
+  for (int rr=0;rr<size;++rr) newNelements += migrateRecvCounts[rr];
+
+  /*Move element data*/
+  Nelements = newNelements;
+
+  Migrate(EToV, Nverts);
+  Migrate(EX, Nverts);
+  Migrate(EY, Nverts);
+  if (EZ.length()) Migrate(EZ, Nverts);
+  if (elementInfo.length()==static_cast<size_t>(NmigrateElements))
+    Migrate(elementInfo, 1);
+
+  /*Rebuild the mesh on the new partition*/
+  Connect();
+  ConnectBoundary();
+  HaloSetup();
+  ConnectFaceVertices();
+  ConnectFaceNodes();
+  ConnectNodes();
+  PhysicalNodes();
+  GeometricFactors();
+  SurfaceGeometricFactors();
+  GatherScatterSetup();
+
+  /*Rebuild cubature data if it was in use*/
+  if (cubNp) {
+    CubatureSetup();
+    CubaturePhysicalNodes();
+  }
+}
+
+} //namespace libp
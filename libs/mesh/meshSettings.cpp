@@ -87,6 +87,23 @@ meshSettings_t::meshSettings_t(comm_t _comm):
              "Degree of polynomial finite element space",
              {"1","2","3","4","5","6","7","8","9","10","11","12","13","14","15"});
 
+  newSetting("MULTIRATE LEVEL SELECTION",
+             "BINNING",
+             "Method for assigning multirate time step levels",
+             {"BINNING", "COST MODEL"});
+
+  newSetting("MULTIRATE ELEMENT COST",
+             "0.0",
+             "Fixed per-element kernel cost for the multirate cost model (0 to measure at startup)");
+
+  newSetting("MULTIRATE LAUNCH COST",
+             "0.0",
+             "Fixed kernel launch cost for the multirate cost model");
+
+  newSetting("MULTIRATE EXCHANGE COST",
+             "0.0",
+             "Fixed trace halo exchange cost for the multirate cost model");
+
   paradogs::AddSettings(*this);
 }
 
@@ -130,6 +147,18 @@ void meshSettings_t::report() {
 
     reportSetting("POLYNOMIAL DEGREE");
 
+    if (!compareSetting("MULTIRATE LEVEL SELECTION","BINNING")) {
+      reportSetting("MULTIRATE LEVEL SELECTION");
+
+      dfloat elementCost;
+      getSetting("MULTIRATE ELEMENT COST", elementCost);
+      if (elementCost>0.0) {
+        reportSetting("MULTIRATE ELEMENT COST");
+        reportSetting("MULTIRATE LAUNCH COST");
+        reportSetting("MULTIRATE EXCHANGE COST");
+      }
+    }
+
     if (!compareSetting("MESH FILE","BOX")) {
       paradogs::ReportSettings(*this);
     }
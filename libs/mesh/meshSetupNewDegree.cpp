@@ -29,7 +29,7 @@ SOFTWARE.
 namespace libp {
 
 //build a new mesh object from another with a different degree.
-mesh_t mesh_t::SetupNewDegree(int Nf){
+mesh_t mesh_t::SetupNewDegree(int Nf, const bool cubature){
 
   // Copy the existing object
   mesh_t mesh=*this;
@@ -57,6 +57,64 @@ mesh_t mesh_t::SetupNewDegree(int Nf){
   // compute surface geofacs
   mesh.SurfaceGeometricFactors();
 
+  // compute cubature geofacs for an over-integrated operator
+  if (cubature) mesh.CubatureGeometricFactors();
+
+  // label local/global gather elements
+  mesh.GatherScatterSetup();
+
+  return mesh;
+}
+
+//build a lightweight mesh object for a continuous multigrid level with a
+// different degree. Element, vertex, and connectivity data stay shared with
+// this mesh and only the node numbering, mask, gather-scatter, and the
+// geometric factors used by the continuous Ax (ggeo, wJ) are built.
+mesh_t mesh_t::SetupLevelDegree(int Nf, const bool cubature){
+
+  // Copy the existing object
+  mesh_t mesh=*this;
+
+  //just reuse the current mesh if the degree isnt changing.
+  if (Nf==N) return mesh;
+
+  mesh.N = Nf;
+
+  // load reference (r,s) element nodes
+  mesh.ReferenceNodes();
+
+  // plotting data is never needed on a level
+  mesh.plotEToV.free();
+  mesh.plotR.free(); mesh.plotS.free(); mesh.plotT.free();
+  mesh.plotInterp.free();
+
+  // connect face nodes (find trace indices)
+  mesh.ConnectFaceNodes();
+
+  // make a global indexing
+  mesh.ConnectNodes();
+
+  // compute physical (x,y) locations of the element nodes
+  mesh.PhysicalNodes();
+
+  // compute geometric factors
+  mesh.GeometricFactors();
+
+  // compute cubature geofacs for an over-integrated operator
+  if (cubature) mesh.CubatureGeometricFactors();
+
+  // release the data only the node numbering and ggeo needed
+  mesh.x.free(); mesh.y.free(); mesh.z.free();
+  mesh.vgeo.free();
+  mesh.o_vgeo = deviceMemory<dfloat>();
+  mesh.vmapM.free(); mesh.vmapP.free(); mesh.mapP.free();
+  mesh.o_vmapM = deviceMemory<dlong>();
+  mesh.o_vmapP = deviceMemory<dlong>();
+
+  // drop references to the surface factors of the other degree
+  mesh.sgeo.free();
+  mesh.o_sgeo = deviceMemory<dfloat>();
+
   // label local/global gather elements
   mesh.GatherScatterSetup();
 
@@ -44,6 +44,8 @@ void halo_t::Exchange(deviceMemory<T> o_v, const int k) {
 
 template<typename T>
 void halo_t::ExchangeStart(deviceMemory<T> o_v, const int k){
+  platform.profiler().Tic(profiler_t::HaloStart);
+
   exchange->AllocBuffer(k*sizeof(T));
 
   deviceMemory<T> o_haloBuf = exchange->o_workspace;
@@ -92,10 +94,13 @@ void halo_t::ExchangeStart(deviceMemory<T> o_v, const int k){
       device.setStream(currentStream);
     }
   }
+
+  platform.profiler().Toc(profiler_t::HaloStart);
 }
 
 template<typename T>
 void halo_t::ExchangeFinish(deviceMemory<T> o_v, const int k){
+  platform.profiler().Tic(profiler_t::HaloFinish);
 
   deviceMemory<T> o_haloBuf = exchange->o_workspace;
 
@@ -140,6 +145,8 @@ void halo_t::ExchangeFinish(deviceMemory<T> o_v, const int k){
       gatherHalo->Scatter(o_v, o_haloBuf, k, NoTrans);
     }
   }
+
+  platform.profiler().Toc(profiler_t::HaloFinish);
 }
 
 template void halo_t::ExchangeStart(deviceMemory<float> o_v, const int k);
@@ -130,6 +130,9 @@ void ogsBase_t::Setup(const dlong _N,
   memory<parallelNode_t> sharedNodes;
   ConstructSharedNodes(Nids, nodes, Nshared, sharedNodes);
 
+  //report how much of the halo stays on the compute node
+  if (verbose) NodeLocalityReport(Nshared, sharedNodes);
+
   Nids=0;
   for (dlong n=0;n<N;n++) {
     if (ids[n]!=0) {
@@ -330,6 +333,37 @@ void ogsBase_t::FindSharedNodes(const dlong Nids,
                      nodes, sendCounts, sendOffsets);
 }
 
+void ogsBase_t::NodeLocalityReport(const dlong Nshared,
+                                   memory<parallelNode_t> &sharedNodes) {
+
+  int rank, size;
+  rank = comm.rank();
+  size = comm.size();
+
+  //identify each compute node by the lowest rank it holds
+  comm_t nodeComm = comm.SplitShared(rank);
+  int nodeId = rank;
+  nodeComm.Bcast(nodeId, 0);
+  nodeComm.Free();
+
+  memory<int> nodeIds(size);
+  comm.Allgather(nodeId, nodeIds);
+
+  //count the shared nodes exchanged with ranks on/off this compute node
+  hlong NonNode=0, NoffNode=0;
+  for (dlong n=0;n<Nshared;n++) {
+    if (nodeIds[sharedNodes[n].rank]==nodeId) NonNode++;
+    else                                      NoffNode++;
+  }
+  comm.Reduce(NonNode, 0);
+  comm.Reduce(NoffNode, 0);
+
+  if (!rank) {
+    std::cout << "ogs Setup: " << NonNode << " halo nodes exchanged on-node, "
+              << NoffNode << " off-node." << std::endl;
+  }
+}
+
 void ogsBase_t::ConstructSharedNodes(const dlong Nids,
                                      memory<parallelNode_t> &nodes,
                                      dlong &Nshared,
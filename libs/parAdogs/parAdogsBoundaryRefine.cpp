@@ -0,0 +1,393 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "parAdogs.hpp"
+#include "parAdogs/parAdogsGraph.hpp"
+#include "parAdogs/parAdogsPartition.hpp"
+
+namespace libp {
+
+namespace paradogs {
+
+void graph_t::SetRefinement(const dfloat tolerance) {
+  refine = true;
+  imbalanceTol = tolerance;
+}
+
+/****************************************/
+/* Greedy Boundary Bipartition Refinement*/
+/****************************************/
+/* Boundary vertices in one part are moved to the other part if doing so
+   reduces the number of cut edges. Each pass only moves vertices in one
+   direction, so the gain of a vertex can only be underestimated when its
+   neighbors move with it, and the cut never grows. Passes alternate
+   direction, and the number of moves per pass is limited to keep the
+   global size of part 0 within the imbalance tolerance of its target.
+   Highest gain vertices are moved first.
+*/
+void graph_t::RefineBipartition(memory<int>& partition,
+                                const dfloat targetFraction[2]) {
+
+  constexpr int maxPasses = 8;
+
+  /*Allowed range of global part 0 size*/
+  const hlong K = std::ceil(targetFraction[0]*NVertsGlobal);
+  const hlong slack = static_cast<hlong>(imbalanceTol*std::min(K, NVertsGlobal-K));
+  const hlong lower = K - slack;
+  const hlong upper = K + slack;
+
+  if (slack==0) return;
+
+  memory<int> gain(Nverts);
+  memory<hlong> hist(Nfaces+1);
+  memory<hlong> localHist(Nfaces+1);
+
+  int Nstalled=0;
+  for (int pass=0;pass<maxPasses;++pass) {
+    const int from = pass%2;
+    const int to   = 1-from;
+
+    /*Global size of part 0*/
+    hlong N0=0;
+    for (dlong n=0;n<Nverts;++n) {
+      if (partition[n]==0) N0++;
+    }
+    comm.Allreduce(N0);
+
+    const hlong budget = (from==0) ? N0-lower : upper-N0;
+
+    /*Compute gains of boundary vertices in part 'from'*/
+    for (int g=0;g<=Nfaces;++g) localHist[g]=0;
+
+    dlong cnt=0;
+    for (dlong e=0;e<Nverts;++e) {
+      int ge=0;
+      for (int f=0;f<Nfaces;++f) {
+        const hlong gE = elements[e].E[f];
+        if (gE!=-1) {
+          dlong eN;
+          if (gE>=VoffsetL && gE<VoffsetU) { /*local neighbor*/
+            eN = static_cast<dlong>(gE-VoffsetL);
+          } else { /*halo neighbor*/
+            eN = colIds[cnt++];
+          }
+          ge += (partition[eN]==from) ? -1 : 1;
+        }
+      }
+      gain[e] = (partition[e]==from) ? ge : 0;
+      if (gain[e]>0) localHist[gain[e]]++;
+    }
+
+    for (int g=0;g<=Nfaces;++g) hist[g]=localHist[g];
+    comm.Allreduce(hist);
+
+    /*Find the gain threshold which exhausts the budget*/
+    hlong remaining = std::max(budget, static_cast<hlong>(0));
+    int threshold = Nfaces+1;
+    hlong Nthreshold=0;
+    for (int g=Nfaces;g>0;--g) {
+      if (remaining==0) break;
+      threshold = g;
+      Nthreshold = std::min(hist[g], remaining);
+      remaining -= Nthreshold;
+    }
+
+    /*Split the moves at the threshold gain among ranks*/
+    hlong localCnt = localHist[threshold<=Nfaces ? threshold : 0];
+    hlong offsetU=0;
+    comm.Scan(localCnt, offsetU);
+    const hlong offsetL = offsetU - localCnt;
+    hlong Nmove = std::max(std::min(Nthreshold-offsetL, localCnt), static_cast<hlong>(0));
+
+    hlong moved=0;
+    for (dlong e=0;e<Nverts;++e) {
+      if (gain[e]>threshold) {
+        partition[e] = to;
+        moved++;
+      } else if (gain[e]==threshold && Nmove>0) {
+        partition[e] = to;
+        moved++;
+        Nmove--;
+      }
+    }
+    comm.Allreduce(moved);
+
+    /*Fill halo region of partition vector*/
+    L[0].A.halo.Exchange(partition, 1);
+
+    if (moved==0) {
+      Nstalled++;
+      if (Nstalled==2) break;
+    } else {
+      Nstalled=0;
+    }
+  }
+}
+
+/****************************************/
+/* Greedy k-Way Boundary Refinement     */
+/****************************************/
+/* Each pass, boundary elements propose a move to the neighboring rank
+   which holds most of their neighbors, if this reduces the cut. Passes
+   alternate between moving to higher and lower ranks to avoid elements
+   trading places across an interface. Receiving ranks grant moves up
+   to their capacity under the imbalance tolerance, and granted elements
+   are migrated and reconnected.
+*/
+void graph_t::RefinePartition() {
+
+  constexpr int maxPasses = 8;
+
+  CutStats(cutBefore, volumeBefore);
+  refined = true;
+
+  if (gsize==1) return;
+
+  struct move_t {
+    int gain;
+    int rank;
+    dlong e;
+  };
+
+  hlong cut = cutBefore;
+  int Nstalled=0;
+
+  for (int pass=0;pass<maxPasses;++pass) {
+
+    /*Global element offsets of each rank*/
+    memory<hlong> starts(gsize+1);
+    starts[0]=0;
+    hlong localNverts = static_cast<hlong>(Nverts);
+    gcomm.Allgather(localNverts, starts+1);
+    for (int r=0;r<gsize;++r) starts[r+1] += starts[r];
+
+    const hlong NglobalVerts = starts[gsize];
+    const dfloat avg = static_cast<dfloat>(NglobalVerts)/gsize;
+    const dlong maxNverts = static_cast<dlong>(std::floor((1.0+imbalanceTol)*avg));
+    const dlong minNverts = static_cast<dlong>(std::ceil((1.0-imbalanceTol)*avg));
+
+    /*Find candidate moves*/
+    memory<move_t> moves(Nverts);
+    dlong Nmoves=0;
+    for (dlong e=0;e<Nverts;++e) {
+      int nbrRank[MAX_NFACES];
+      int nbrCnt[MAX_NFACES];
+      int Nnbrs=0;
+      int ownCnt=0;
+
+      for (int f=0;f<Nfaces;++f) {
+        const hlong eN = elements[e].E[f];
+        if (eN==-1) continue;
+
+        if (eN>=gVoffsetL && eN<gVoffsetU) {
+          ownCnt++;
+        } else {
+          const int r = static_cast<int>(std::upper_bound(starts.ptr(), starts.ptr()+gsize+1, eN)
+                                         - starts.ptr() - 1);
+          int n=0;
+          for (;n<Nnbrs;++n) if (nbrRank[n]==r) break;
+          if (n==Nnbrs) {
+            nbrRank[Nnbrs] = r;
+            nbrCnt[Nnbrs++] = 0;
+          }
+          nbrCnt[n]++;
+        }
+      }
+
+      int bestGain=0;
+      int bestRank=-1;
+      for (int n=0;n<Nnbrs;++n) {
+        const bool allowed = (pass%2==0) ? (nbrRank[n]>grank) : (nbrRank[n]<grank);
+        if (allowed && nbrCnt[n]-ownCnt>bestGain) {
+          bestGain = nbrCnt[n]-ownCnt;
+          bestRank = nbrRank[n];
+        }
+      }
+
+      if (bestRank!=-1) {
+        moves[Nmoves].gain = bestGain;
+        moves[Nmoves].rank = bestRank;
+        moves[Nmoves].e = e;
+        Nmoves++;
+      }
+    }
+
+    /*Highest gains first, limited by how many elements we can give away*/
+    std::sort(moves.ptr(), moves.ptr()+Nmoves,
+              [](const move_t& a, const move_t& b) {
+                return a.gain > b.gain;
+              });
+    Nmoves = std::max(std::min(Nmoves, Nverts-minNverts), static_cast<dlong>(0));
+
+    /*Request moves from neighboring ranks*/
+    memory<hlong> Nrequest(gsize, 0);
+    memory<hlong> Nincoming(gsize);
+    for (dlong n=0;n<Nmoves;++n) Nrequest[moves[n].rank]++;
+    gcomm.Alltoall(Nrequest, Nincoming);
+
+    /*Grant requests up to our capacity*/
+    hlong NincomingTotal=0;
+    for (int r=0;r<gsize;++r) NincomingTotal += Nincoming[r];
+    const hlong capacity = std::max(static_cast<hlong>(maxNverts-Nverts), static_cast<hlong>(0));
+
+    memory<hlong> Ngrant(gsize);
+    memory<hlong> Ngranted(gsize);
+    for (int r=0;r<gsize;++r) {
+      Ngrant[r] = (NincomingTotal<=capacity) ? Nincoming[r]
+                                             : (Nincoming[r]*capacity)/NincomingTotal;
+    }
+    gcomm.Alltoall(Ngrant, Ngranted);
+
+    /*Destination of each element*/
+    memory<int> dest(Nverts, grank);
+    memory<int> Nsend(gsize, 0);
+    memory<int> Nrecv(gsize);
+    memory<int> sendOffsets(gsize);
+    memory<int> recvOffsets(gsize);
+
+    hlong moved=0;
+    for (dlong n=0;n<Nmoves;++n) {
+      const int r = moves[n].rank;
+      if (Ngranted[r]>0) {
+        dest[moves[n].e] = r;
+        Ngranted[r]--;
+        moved++;
+      }
+    }
+    gcomm.Allreduce(moved);
+
+    if (moved==0) {
+      Nstalled++;
+      if (Nstalled==2) break;
+      continue;
+    }
+    Nstalled=0;
+
+    /*Migrate elements*/
+    for (dlong e=0;e<Nverts;++e) Nsend[dest[e]]++;
+
+    gcomm.Alltoall(Nsend, Nrecv);
+
+    sendOffsets[0]=0;
+    recvOffsets[0]=0;
+    for (int r=1;r<gsize;++r) {
+      sendOffsets[r] = sendOffsets[r-1] + Nsend[r-1];
+      recvOffsets[r] = recvOffsets[r-1] + Nrecv[r-1];
+    }
+
+    dlong newNverts=0;
+    for (int r=0;r<gsize;++r) newNverts += Nrecv[r];
+
+    memory<element_t> sendElements(Nverts);
+    for (int r=0;r<gsize;++r) Nsend[r]=0;
+    for (dlong e=0;e<Nverts;++e) {
+      const int r = dest[e];
+      sendElements[sendOffsets[r]+Nsend[r]++] = elements[e];
+    }
+
+    /*Keep the current partition in case this pass makes the cut worse*/
+    memory<element_t> oldElements = elements;
+    const dlong oldNverts = Nverts;
+
+    Nverts = newNverts;
+    Nelements = newNverts;
+    elements.malloc(Nverts);
+
+    gcomm.Alltoallv(sendElements, Nsend, sendOffsets,
+                        elements, Nrecv, recvOffsets);
+
+    Reconnect();
+
+    /*Stop once the cut stops improving, rolling back this pass' moves*/
+    hlong newCut=0, newVolume=0;
+    CutStats(newCut, newVolume);
+    if (newCut>=cut) {
+      Nverts = oldNverts;
+      Nelements = oldNverts;
+      elements = oldElements;
+      Reconnect();
+      break;
+    }
+    cut = newCut;
+  }
+}
+
+/*Rebuild connectivity and offsets after elements changed ranks*/
+void graph_t::Reconnect() {
+  for (dlong e=0;e<Nverts;++e) {
+    for (int f=0;f<Nfaces;++f) {
+      elements[e].E[f] = -1;
+      elements[e].F[f] = -1;
+    }
+  }
+  Connect();
+
+  /*Update local element counts*/
+  NVertsGlobal=static_cast<hlong>(Nverts);
+  comm.Allreduce(NVertsGlobal);
+
+  hlong localNverts=static_cast<hlong>(Nverts);
+  comm.Scan(localNverts, VoffsetU);
+  VoffsetL = VoffsetU-Nverts;
+}
+
+/*Global edge cut and communication volume of current partition*/
+void graph_t::CutStats(hlong& cut, hlong& volume) {
+
+  memory<hlong> starts(gsize+1);
+  starts[0]=0;
+  hlong localNverts = static_cast<hlong>(Nverts);
+  gcomm.Allgather(localNverts, starts+1);
+  for (int r=0;r<gsize;++r) starts[r+1] += starts[r];
+
+  cut=0;
+  volume=0;
+  for (dlong e=0;e<Nverts;++e) {
+    int nbrRank[MAX_NFACES];
+    int Nnbrs=0;
+    for (int f=0;f<Nfaces;++f) {
+      const hlong eN = elements[e].E[f];
+      if (eN==-1) continue;
+      if ((eN<gVoffsetL) || (eN>=gVoffsetU)) {
+        cut++;
+
+        /*Count each neighboring rank once per element*/
+        const int r = static_cast<int>(std::upper_bound(starts.ptr(), starts.ptr()+gsize+1, eN)
+                                       - starts.ptr() - 1);
+        int n=0;
+        for (;n<Nnbrs;++n) if (nbrRank[n]==r) break;
+        if (n==Nnbrs) nbrRank[Nnbrs++] = r;
+      }
+    }
+    volume += Nnbrs;
+  }
+  gcomm.Allreduce(cut);
+  gcomm.Allreduce(volume);
+}
+
+} //namespace paradogs
+
+} //namespace libp
@@ -33,7 +33,7 @@ namespace libp {
 
 namespace paradogs {
 
-void graph_t::CuthillMckee() {
+void graph_t::CuthillMckee(const bool reverse) {
 
   /*Look for first node with lowest degree*/
   int minDegree=Nfaces+1;
@@ -113,7 +113,19 @@ void graph_t::CuthillMckee() {
     }
   } while(true);
 
+  /*Reversing the order usually reduces the profile further*/
+  if (reverse) {
+    for (dlong e=0;e<Nelements;++e) {
+      newId[e] = gVoffsetU-1-(newId[e]-gVoffsetL);
+    }
+  }
+
   /*we now have a new local odering*/
+  Reorder(newId);
+}
+
+/*Apply a new rank-local ordering of the elements*/
+void graph_t::Reorder(memory<hlong>& newId) {
 
   /*Share the new ids*/
   //TODO halo exchange here
@@ -0,0 +1,153 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "parAdogs.hpp"
+#include "parAdogs/parAdogsGraph.hpp"
+#include <vector>
+
+namespace libp {
+
+namespace paradogs {
+
+/*************************************************/
+/* Face-Neighbor Blocking                        */
+/*************************************************/
+/* Elements are grouped into tiles of tileSize elements which are grown
+   greedily over shared faces, always adding the frontier element with the
+   most faces already in the tile. Each tile is seeded from the frontier of
+   the previous one, so consecutive tiles are also face neighbors. When a
+   tile fits in cache, most neighbor reads in the surface kernels and
+   vmapP gathers hit data which was loaded for the tile.
+*/
+void graph_t::FaceBlockOrdering(const int tileSize) {
+
+  memory<hlong> newId(Nelements);
+
+  memory<bool> assigned(Nelements, false);
+  memory<int> Nshared(Nelements, 0); //faces shared with current tile
+
+  std::vector<dlong> frontier;
+
+  auto isLocal = [&](const hlong eN) {
+    return (eN!=-1) && (eN>=gVoffsetL) && (eN<gVoffsetU);
+  };
+
+  /*Start with the lowest degree element*/
+  int minDegree=Nfaces+1;
+  dlong seed=-1;
+  for (dlong e=0;e<Nelements;++e) {
+    int degree=0;
+    for (int f=0;f<Nfaces;++f) {
+      if (isLocal(elements[e].E[f])) degree++;
+    }
+    if (degree<minDegree) {
+      minDegree=degree;
+      seed=e;
+    }
+  }
+
+  dlong cnt=0;
+  dlong cursor=0;
+  while (cnt<Nelements) {
+
+    /*Disconnected? Pick the next unassigned element*/
+    if (seed==-1) {
+      while (assigned[cursor]) cursor++;
+      seed = cursor;
+    }
+
+    frontier.clear();
+
+    dlong e = seed;
+    for (int n=0;n<tileSize && e!=-1;++n) {
+      /*Give this element a new global index*/
+      assigned[e] = true;
+      newId[e] = gVoffsetL+cnt++;
+
+      /*Grow the frontier*/
+      for (int f=0;f<Nfaces;++f) {
+        const hlong eN = elements[e].E[f];
+        if (isLocal(eN)) {
+          const dlong eL = static_cast<dlong>(eN-gVoffsetL); //local id
+          if (!assigned[eL]) {
+            if (Nshared[eL]==0) frontier.push_back(eL);
+            Nshared[eL]++;
+          }
+        }
+      }
+
+      /*Next element is the most connected unassigned frontier element*/
+      e = -1;
+      int maxShared=0;
+      for (const dlong eF : frontier) {
+        if (!assigned[eF] && Nshared[eF]>maxShared) {
+          maxShared = Nshared[eF];
+          e = eF;
+        }
+      }
+    }
+
+    /*Seed next tile from this tile's frontier*/
+    seed = e;
+
+    for (const dlong eF : frontier) Nshared[eF]=0;
+  }
+
+  /*we now have a new local odering*/
+  Reorder(newId);
+}
+
+/*Fraction of local face neighbor reads within window elements of the
+  reading element. Approximates cache reuse of a sweep over the elements*/
+dfloat graph_t::SurfaceReuse(const int window) {
+
+  hlong Nreads=0, Nhits=0;
+  for (dlong e=0;e<Nelements;++e) {
+    for (int f=0;f<Nfaces;++f) {
+      const hlong eN = elements[e].E[f];
+      if ((eN!=-1) && (eN>=gVoffsetL) && (eN<gVoffsetU) ) {
+        const dlong eL = static_cast<dlong>(eN-gVoffsetL); //local id
+        Nreads++;
+        if (std::abs(eL-e)<window) Nhits++;
+      }
+    }
+  }
+
+  gcomm.Allreduce(Nreads);
+  gcomm.Allreduce(Nhits);
+
+  return (Nreads) ? static_cast<dfloat>(Nhits)/Nreads : 1.0;
+}
+
+void graph_t::SetReuseWindow(const int window) {
+  reuseWindow = window;
+  reuseBefore = SurfaceReuse(window);
+}
+
+} //namespace paradogs
+
+} //namespace libp
@@ -141,7 +141,7 @@ void graph_t::Split(const memory<int>& partition) {
   }
 
   /*Determine number of ranks to hold left and right partitions*/
-  const int size0 = (size+1)/2;
+  const int size0 = BisectionSize();
   const int size1 = size-size0;
 
   const hlong chunk0 = globalNverts0/size0;
@@ -371,6 +371,34 @@ void graph_t::Report() {
             static_cast<long long int>(maxCut));
     printf("-----------------------------------------------------------------------------------------------\n");
   }
+
+  if (refined) {
+    hlong cutAfter=0, volumeAfter=0;
+    CutStats(cutAfter, volumeAfter);
+
+    if(grank==0) {
+      printf("   Boundary refinement  |   Halo Faces (before,after)        |  Comm. Volume (before,after)   |\n");
+      printf("                        |   %12lld -> %12lld     |  %12lld -> %12lld  |\n",
+              static_cast<long long int>(cutBefore),
+              static_cast<long long int>(cutAfter),
+              static_cast<long long int>(volumeBefore),
+              static_cast<long long int>(volumeAfter));
+      printf("-----------------------------------------------------------------------------------------------\n");
+    }
+  }
+
+  if (reuseWindow) {
+    const dfloat reuseAfter = SurfaceReuse(reuseWindow);
+
+    if(grank==0) {
+      printf("   Local ordering       |   Face neighbors within %6d elements (before,after)              |\n",
+              reuseWindow);
+      printf("                        |   %11.1f%% -> %11.1f%%                                      |\n",
+              100.0*reuseBefore,
+              100.0*reuseAfter);
+      printf("-----------------------------------------------------------------------------------------------\n");
+    }
+  }
 }
 
 void graph_t::ExtractMesh(dlong &Nelements_,
@@ -0,0 +1,197 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "parAdogs.hpp"
+#include "parAdogs/parAdogsGraph.hpp"
+#include <numeric>
+#include <limits>
+
+namespace libp {
+
+namespace paradogs {
+
+/* Morton to Hilbert index conversions taken from:
+   http://and-what-happened.blogspot.com/2011/08/fast-2d-and-3d-hilbert-curves-and.html */
+static unsigned int MortonToHilbert2D(const unsigned int morton, const unsigned int bits) {
+  unsigned int hilbert = 0;
+  unsigned int remap = 0xb4;
+  unsigned int block = ( bits << 1 );
+  while( block ) {
+    block -= 2;
+    unsigned int mcode = ( ( morton >> block ) & 3 );
+    unsigned int hcode = ( ( remap >> ( mcode << 1 ) ) & 3 );
+    remap ^= ( 0x82000028 >> ( hcode << 3 ) );
+    hilbert = ( ( hilbert << 2 ) + hcode );
+  }
+  return( hilbert );
+}
+
+static unsigned int MortonToHilbert3D(const unsigned int morton, const unsigned int bits) {
+  unsigned int hilbert = morton;
+  if( bits > 1 ) {
+    unsigned int block = ( ( bits * 3 ) - 3 );
+    unsigned int hcode = ( ( hilbert >> block ) & 7 );
+    unsigned int mcode, shift, signs;
+    shift = signs = 0;
+    while( block ) {
+      block -= 3;
+      hcode <<= 2;
+      mcode = ( ( 0x20212021 >> hcode ) & 3 );
+      shift = ( ( 0x48 >> ( 7 - shift - mcode ) ) & 3 );
+      signs = ( ( signs | ( signs << 3 ) ) >> mcode );
+      signs = ( ( signs ^ ( 0x53560300 >> hcode ) ) & 7 );
+      mcode = ( ( hilbert >> block ) & 7 );
+      hcode = mcode;
+      hcode = ( ( ( hcode | ( hcode << 3 ) ) >> shift ) & 7 );
+      hcode ^= signs;
+      hilbert ^= ( ( mcode ^ hcode ) << block );
+    }
+  }
+  hilbert ^= ( ( hilbert >> 1 ) & 0x92492492 );
+  hilbert ^= ( ( hilbert & 0x92492492 ) >> 1 );
+  return( hilbert );
+}
+
+/*Spread the low 16 bits of x to the even bits*/
+static unsigned int Spread2(unsigned int x) {
+  x &= 0x0000ffff;
+  x = (x | (x << 8)) & 0x00ff00ff;
+  x = (x | (x << 4)) & 0x0f0f0f0f;
+  x = (x | (x << 2)) & 0x33333333;
+  x = (x | (x << 1)) & 0x55555555;
+  return x;
+}
+
+/*Spread the low 10 bits of x to every third bit*/
+static unsigned int Spread3(unsigned int x) {
+  x &= 0x000003ff;
+  x = (x | (x << 16)) & 0x030000ff;
+  x = (x | (x <<  8)) & 0x0300f00f;
+  x = (x | (x <<  4)) & 0x030c30c3;
+  x = (x | (x <<  2)) & 0x09249249;
+  return x;
+}
+
+/*Number of bits in a Hilbert key. Keys are stored in hlong and must
+  leave room for the bisection search's maxKey, so use at most
+  8*sizeof(hlong)-2 bits, rounded down to a multiple of dim*/
+int graph_t::HilbertKeyBits() {
+  const int maxBits = static_cast<int>(8*sizeof(hlong)) - 2;
+  const int bits = (dim==2) ? 32 : 30;
+  return std::min(bits, maxBits - maxBits%dim);
+}
+
+/*Hilbert curve index of each element's center of mass. Coordinates are
+  scaled to the bounding box of the local elements, or of the whole graph
+  if local==false */
+void graph_t::HilbertKeys(memory<hlong>& keys, const bool local) {
+
+  const unsigned int bits = HilbertKeyBits()/dim;
+  const dfloat scale = static_cast<dfloat>(1u << bits);
+  const unsigned int maxCoord = (1u << bits) - 1;
+
+  /*Compute center of mass of each element*/
+  memory<dfloat> x(Nverts), y(Nverts), z(Nverts, 0.0);
+  for (dlong e=0;e<Nverts;++e) {
+    x[e]=0.0;
+    y[e]=0.0;
+    for (int v=0;v<NelementVerts;++v) {
+      x[e] += elements[e].EX[v];
+      y[e] += elements[e].EY[v];
+      if (dim==3) z[e] += elements[e].EZ[v];
+    }
+    x[e] /= NelementVerts;
+    y[e] /= NelementVerts;
+    z[e] /= NelementVerts;
+  }
+
+  /*Bounding box*/
+  memory<dfloat> bmin(3, std::numeric_limits<dfloat>::max());
+  memory<dfloat> bmax(3, std::numeric_limits<dfloat>::lowest());
+  for (dlong e=0;e<Nverts;++e) {
+    bmin[0] = std::min(bmin[0], x[e]); bmax[0] = std::max(bmax[0], x[e]);
+    bmin[1] = std::min(bmin[1], y[e]); bmax[1] = std::max(bmax[1], y[e]);
+    bmin[2] = std::min(bmin[2], z[e]); bmax[2] = std::max(bmax[2], z[e]);
+  }
+  if (!local) {
+    comm.Allreduce(bmin, Comm::Min);
+    comm.Allreduce(bmax, Comm::Max);
+  }
+
+  /*Use a uniform scaling to keep the curve's aspect ratio*/
+  dfloat width = std::max(bmax[0]-bmin[0], bmax[1]-bmin[1]);
+  if (dim==3) width = std::max(width, bmax[2]-bmin[2]);
+  const dfloat invWidth = (width>0.0) ? 1.0/width : 0.0;
+
+  auto quantize = [&](const dfloat c, const dfloat cmin) {
+    const dfloat s = (c-cmin)*invWidth*scale;
+    return std::min(static_cast<unsigned int>(std::max(s, static_cast<dfloat>(0.0))), maxCoord);
+  };
+
+  keys.malloc(Nverts);
+
+  if (dim==2) {
+    #pragma omp parallel for
+    for (dlong e=0;e<Nverts;++e) {
+      const unsigned int morton = Spread2(quantize(x[e], bmin[0]))
+                                | (Spread2(quantize(y[e], bmin[1])) << 1);
+      keys[e] = static_cast<hlong>(MortonToHilbert2D(morton, bits));
+    }
+  } else {
+    #pragma omp parallel for
+    for (dlong e=0;e<Nverts;++e) {
+      const unsigned int morton = Spread3(quantize(x[e], bmin[0]))
+                                | (Spread3(quantize(y[e], bmin[1])) << 1)
+                                | (Spread3(quantize(z[e], bmin[2])) << 2);
+      keys[e] = static_cast<hlong>(MortonToHilbert3D(morton, bits));
+    }
+  }
+}
+
+/*Reorder rank-local elements along a Hilbert curve*/
+void graph_t::HilbertOrdering() {
+
+  memory<hlong> keys;
+  HilbertKeys(keys, true);
+
+  memory<dlong> order(Nelements);
+  std::iota(order.ptr(), order.ptr()+Nelements, 0);
+  std::stable_sort(order.ptr(), order.ptr()+Nelements,
+                   [&](const dlong a, const dlong b) {
+                     return keys[a] < keys[b];
+                   });
+
+  memory<hlong> newId(Nelements);
+  for (dlong n=0;n<Nelements;++n) {
+    newId[order[n]] = gVoffsetL+n;
+  }
+
+  Reorder(newId);
+}
+
+} //namespace paradogs
+
+} //namespace libp
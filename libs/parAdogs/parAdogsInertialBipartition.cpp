@@ -41,7 +41,10 @@ namespace paradogs {
 /****************************************/
 void graph_t::InertialBipartition(const dfloat targetFraction[2]) {
 
-  memory<int> partition(Nverts);
+  /*Refinement needs the graph connectivity and halo*/
+  if (refine) CreateLaplacian();
+
+  memory<int> partition(Nverts+Nhalo);
 
   memory<double> I;
   I.calloc(9);
@@ -192,8 +195,18 @@ void graph_t::InertialBipartition(const dfloat targetFraction[2]) {
     }
   }
 
+  if (refine) {
+    /*Fill halo region of partition vector*/
+    L[0].A.halo.Exchange(partition, 1);
+
+    /*Improve the cut*/
+    RefineBipartition(partition, targetFraction);
+  }
+
   /*Split the graph according to this partitioning*/
   Split(partition);
+
+  if (refine) MultigridDestroy();
 }
 
 } //namespace paradogs
@@ -68,9 +68,24 @@ void MeshPartition(platform_t &platform,
                 EZ,
                 comm);
 
+  /*Partition across compute nodes first*/
+  if (settings.compareSetting("PARADOGS NODE HIERARCHY", "TRUE")) {
+    graph.NodeHierarchy();
+  }
+
+  const bool refine = settings.compareSetting("PARADOGS REFINEMENT", "GREEDY");
+  if (refine) {
+    dfloat tolerance;
+    settings.getSetting("PARADOGS IMBALANCE TOLERANCE", tolerance);
+    graph.SetRefinement(tolerance);
+  }
+
   timePoint_t timeStart = GlobalTime(comm);
 
   if (settings.compareSetting("PARADOGS PARTITIONING", "INERTIAL")) {
+    /*Connect element faces before partitioning if refining bisections*/
+    if (refine && comm.size()>1) graph.Connect();
+
     /*Inertial partitioning*/
     graph.InertialPartition();
   } else if (settings.compareSetting("PARADOGS PARTITIONING", "SPECTRAL")) {
@@ -79,13 +94,31 @@ void MeshPartition(platform_t &platform,
 
     /*Spectral partitioning*/
     graph.SpectralPartition();
+  } else if (settings.compareSetting("PARADOGS PARTITIONING", "SFC")) {
+    /*Space-filling curve partitioning*/
+    graph.SFCPartition();
   }
 
   /*Connect element faces after partitioning*/
   graph.Connect();
 
+  /*Improve the final k-way cut*/
+  if (refine) graph.RefinePartition();
+
   /*Reorder rank-local element list for better locality*/
-  graph.CuthillMckee();
+  int tileSize=64;
+  settings.getSetting("PARADOGS TILE SIZE", tileSize);
+  graph.SetReuseWindow(tileSize);
+
+  if (settings.compareSetting("PARADOGS ORDERING", "HILBERT")) {
+    graph.HilbertOrdering();
+  } else if (settings.compareSetting("PARADOGS ORDERING", "REVERSE-CUTHILL-MCKEE")) {
+    graph.CuthillMckee(true);
+  } else if (settings.compareSetting("PARADOGS ORDERING", "FACE-BLOCKING")) {
+    graph.FaceBlockOrdering(tileSize);
+  } else {
+    graph.CuthillMckee();
+  }
 
   timePoint_t timeEnd = GlobalTime(comm);
   double elaplsed = ElapsedTime(timeStart, timeEnd);
@@ -0,0 +1,73 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "parAdogs.hpp"
+#include "parAdogs/parAdogsGraph.hpp"
+
+namespace libp {
+
+namespace paradogs {
+
+/*Find a new owning rank for each element of an already partitioned mesh,
+  balancing the total element weight on each rank. Mesh data is not moved*/
+void MeshRebalance(platform_t &platform,
+                   settings_t &settings,
+                   const dlong Nelements,
+                   const  int dim,
+                   const  int Nverts,
+                   const  int Nfaces,
+                   const  int NfaceVertices,
+                   const  memory<int>& faceVertices,
+                   const  memory<hlong>& EToV,
+                   const  memory<dfloat>& EX,
+                   const  memory<dfloat>& EY,
+                   const  memory<dfloat>& EZ,
+                   const  memory<dfloat>& weights,
+                   memory<int>& dest,
+                   comm_t comm) {
+
+  /* Create graph from mesh info*/
+  graph_t graph(platform,
+                Nelements,
+                dim,
+                Nverts,
+                Nfaces,
+                NfaceVertices,
+                faceVertices,
+                EToV,
+                EX,
+                EY,
+                EZ,
+                comm);
+
+  /*Weighted space-filling curve partition*/
+  graph.SFCRebalance(weights, dest);
+}
+
+} //namespace paradogs
+
+} //namespace libp
@@ -0,0 +1,97 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "parAdogs.hpp"
+#include "parAdogs/parAdogsGraph.hpp"
+
+namespace libp {
+
+namespace paradogs {
+
+/*************************************************/
+/* Node-aware Hierarchical Partitioning          */
+/*************************************************/
+/* Ranks are reordered so each compute node holds a contiguous block of
+   ranks. Recursive bisections then split along node boundaries until a
+   piece of the graph lives on a single node, so the first (and largest)
+   cuts are the ones that cross the network.
+*/
+void graph_t::NodeHierarchy() {
+
+  nodeAware = true;
+
+  /*Identify each node by the lowest rank it holds*/
+  comm_t nodeComm = gcomm.SplitShared(grank);
+  nodeId = grank;
+  nodeComm.Bcast(nodeId, 0);
+  nodeComm.Free();
+
+  /*Order ranks by node. Ties keep their original rank order*/
+  comm_t newComm = gcomm.Split(0, nodeId);
+  gcomm.Free();
+  comm.Free();
+  gcomm = newComm;
+  comm  = newComm.Dup();
+
+  grank = gcomm.rank();
+  gsize = gcomm.size();
+  rank = comm.rank();
+  size = comm.size();
+
+  /*Get global element count offsets*/
+  hlong localNverts=static_cast<hlong>(Nverts);
+  comm.Scan(localNverts, VoffsetU);
+  VoffsetL = VoffsetU-Nverts;
+
+  gVoffsetL = VoffsetL;
+  gVoffsetU = VoffsetU;
+}
+
+int graph_t::BisectionSize() {
+
+  const int half = (size+1)/2;
+
+  if (!nodeAware) return half;
+
+  /*Node of each rank in this communicator*/
+  memory<int> nodes(size);
+  comm.Allgather(nodeId, nodes);
+
+  /*Pick the node boundary closest to an even split*/
+  int best = half;
+  int bestDist = size;
+  for (int r=1;r<size;++r) {
+    if (nodes[r]!=nodes[r-1] && std::abs(r-half)<bestDist) {
+      best = r;
+      bestDist = std::abs(r-half);
+    }
+  }
+  return best;
+}
+
+} //namespace paradogs
+
+} //namespace libp
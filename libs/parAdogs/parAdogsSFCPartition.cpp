@@ -0,0 +1,257 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "parAdogs.hpp"
+#include "parAdogs/parAdogsGraph.hpp"
+#include "parAdogs/parAdogsPartition.hpp"
+#include <numeric>
+
+namespace libp {
+
+namespace paradogs {
+
+/*************************************************/
+/* k-Way Space-Filling Curve Partitioning        */
+/*************************************************/
+/* Elements are ordered along a Hilbert curve through their centers of
+   mass and the curve is cut into equally sized pieces. Splitter keys
+   are found with a simultaneous bisection search over the key range,
+   and elements are migrated to their destination rank in one exchange.
+*/
+void graph_t::SFCPartition() {
+
+  if (size==1) return;
+
+  /*Hilbert keys of each element*/
+  memory<hlong> keys;
+  HilbertKeys(keys, false);
+
+  /*Sort local elements along the curve*/
+  memory<dlong> order(Nverts);
+  std::iota(order.ptr(), order.ptr()+Nverts, 0);
+  std::sort(order.ptr(), order.ptr()+Nverts,
+            [&](const dlong a, const dlong b) {
+              return keys[a] < keys[b];
+            });
+
+  memory<hlong> sortedKeys(Nverts);
+  for (dlong n=0;n<Nverts;++n) sortedKeys[n] = keys[order[n]];
+  keys.free();
+
+  hlong* kStart = sortedKeys.ptr();
+  hlong* kEnd   = sortedKeys.ptr()+Nverts;
+
+  /*Number of elements which should preceed each rank's piece of the curve*/
+  const int Nsplit = size-1;
+  const hlong chunk = NVertsGlobal/size;
+  const int remainder = static_cast<int>(NVertsGlobal - chunk*size);
+
+  memory<hlong> target(Nsplit);
+  for (int r=0;r<Nsplit;++r) {
+    target[r] = (r+1)*chunk + std::min(r+1, remainder);
+  }
+
+  /*Bisection search for the smallest key whose global count of
+    keys <= key reaches each target, i.e. cnt(lo) < target <= cnt(hi)*/
+  const int keyBits = HilbertKeyBits();
+  const hlong maxKey = (static_cast<hlong>(1) << keyBits) - 1;
+
+  memory<hlong> lo(Nsplit, -1);
+  memory<hlong> hi(Nsplit, maxKey);
+  memory<hlong> cnt(Nsplit);
+
+  for (int it=0;it<=keyBits;++it) {
+    for (int r=0;r<Nsplit;++r) {
+      const hlong mid = lo[r] + (hi[r]-lo[r])/2;
+      cnt[r] = std::upper_bound(kStart, kEnd, mid) - kStart;
+    }
+    comm.Allreduce(cnt);
+    for (int r=0;r<Nsplit;++r) {
+      if (hi[r]-lo[r]>1) {
+        const hlong mid = lo[r] + (hi[r]-lo[r])/2;
+        if (cnt[r]>=target[r]) hi[r] = mid;
+        else                   lo[r] = mid;
+      }
+    }
+  }
+
+  /*Global count of keys strictly less than each splitter key*/
+  memory<hlong> Nless(Nsplit);
+  memory<hlong> Nties(Nsplit);
+  memory<hlong> tieOffsets(Nsplit);
+  for (int r=0;r<Nsplit;++r) {
+    Nless[r] = std::lower_bound(kStart, kEnd, hi[r]) - kStart;
+    Nties[r] = (std::upper_bound(kStart, kEnd, hi[r]) - kStart) - Nless[r];
+  }
+
+  /*Local position of each split. Elements sharing a splitter key are
+    divided among ranks in rank order*/
+  memory<dlong> splits(Nsplit);
+  for (int r=0;r<Nsplit;++r) splits[r] = static_cast<dlong>(Nless[r]);
+
+  comm.Allreduce(Nless);
+  comm.Scan(Nties, tieOffsets);
+
+  for (int r=0;r<Nsplit;++r) {
+    const hlong need = target[r] - Nless[r];
+    const hlong offset = tieOffsets[r] - Nties[r];
+    const hlong take = std::max(std::min(need-offset, Nties[r]), static_cast<hlong>(0));
+    splits[r] += static_cast<dlong>(take);
+  }
+  sortedKeys.free();
+
+  /*Send counts*/
+  memory<int> Nsend(size);
+  memory<int> Nrecv(size);
+  memory<int> sendOffsets(size);
+  memory<int> recvOffsets(size);
+
+  for (int r=0;r<size;++r) {
+    const dlong start = (r==0) ? 0 : splits[r-1];
+    const dlong end   = (r==Nsplit) ? Nverts : splits[r];
+    Nsend[r] = end-start;
+  }
+
+  comm.Alltoall(Nsend, Nrecv);
+
+  sendOffsets[0]=0;
+  recvOffsets[0]=0;
+  for (int r=1;r<size;++r) {
+    sendOffsets[r] = sendOffsets[r-1] + Nsend[r-1];
+    recvOffsets[r] = recvOffsets[r-1] + Nrecv[r-1];
+  }
+
+  dlong newNverts=0;
+  for (int r=0;r<size;++r) newNverts += Nrecv[r];
+
+  /*make send buffer in curve order*/
+  memory<element_t> sendElements(Nverts);
+  for (dlong n=0;n<Nverts;++n) {
+    sendElements[n] = elements[order[n]];
+  }
+
+  /*make new list*/
+  Nverts = newNverts;
+  Nelements = newNverts;
+  elements.malloc(Nverts);
+
+  comm.Alltoallv(sendElements, Nsend, sendOffsets,
+                     elements, Nrecv, recvOffsets);
+
+  /*Global number of elements*/
+  NVertsGlobal=static_cast<hlong>(Nverts);
+  comm.Allreduce(NVertsGlobal);
+
+  /*Get global element count offsets*/
+  hlong localNverts=static_cast<hlong>(Nverts);
+  comm.Scan(localNverts, VoffsetU);
+  VoffsetL = VoffsetU-Nverts;
+}
+
+/*************************************************/
+/* Weighted Space-Filling Curve Rebalancing      */
+/*************************************************/
+/* Cut the Hilbert curve through the elements' centers of mass into
+   pieces of equal total weight, and find the destination rank of each
+   local element. Elements are not moved. Since the curve depends only on
+   the global bounding box, small changes in the weights only move the
+   cuts a little, and rebalancing an SFC partition migrates few elements.
+*/
+void graph_t::SFCRebalance(const memory<dfloat>& weights,
+                           memory<int>& dest) {
+
+  dest.malloc(Nverts, 0);
+
+  if (size==1) return;
+
+  /*Hilbert keys of each element*/
+  memory<hlong> keys;
+  HilbertKeys(keys, false);
+
+  /*Sort local elements along the curve*/
+  memory<dlong> order(Nverts);
+  std::iota(order.ptr(), order.ptr()+Nverts, 0);
+  std::sort(order.ptr(), order.ptr()+Nverts,
+            [&](const dlong a, const dlong b) {
+              return keys[a] < keys[b];
+            });
+
+  /*Sorted keys and running sum of weights along the local curve*/
+  memory<hlong> sortedKeys(Nverts);
+  memory<dfloat> weightSum(Nverts+1);
+  weightSum[0] = 0.0;
+  for (dlong n=0;n<Nverts;++n) {
+    sortedKeys[n] = keys[order[n]];
+    weightSum[n+1] = weightSum[n] + weights[order[n]];
+  }
+
+  hlong* kStart = sortedKeys.ptr();
+  hlong* kEnd   = sortedKeys.ptr()+Nverts;
+
+  dfloat totalWeight = weightSum[Nverts];
+  comm.Allreduce(totalWeight);
+
+  /*Weight which should preceed each rank's piece of the curve*/
+  const int Nsplit = size-1;
+  memory<dfloat> target(Nsplit);
+  for (int r=0;r<Nsplit;++r) {
+    target[r] = ((r+1)*totalWeight)/size;
+  }
+
+  /*Bisection search for the smallest key whose global weight of
+    keys <= key reaches each target*/
+  const int keyBits = HilbertKeyBits();
+  const hlong maxKey = (static_cast<hlong>(1) << keyBits) - 1;
+
+  memory<hlong> lo(Nsplit, -1);
+  memory<hlong> hi(Nsplit, maxKey);
+  memory<dfloat> wgt(Nsplit);
+
+  for (int it=0;it<=keyBits;++it) {
+    for (int r=0;r<Nsplit;++r) {
+      const hlong mid = lo[r] + (hi[r]-lo[r])/2;
+      wgt[r] = weightSum[std::upper_bound(kStart, kEnd, mid) - kStart];
+    }
+    comm.Allreduce(wgt);
+    for (int r=0;r<Nsplit;++r) {
+      if (hi[r]-lo[r]>1) {
+        const hlong mid = lo[r] + (hi[r]-lo[r])/2;
+        if (wgt[r]>=target[r]) hi[r] = mid;
+        else                   lo[r] = mid;
+      }
+    }
+  }
+
+  /*Elements with keys <= hi[r] belong to ranks <= r*/
+  for (dlong e=0;e<Nverts;++e) {
+    dest[e] = static_cast<int>(std::lower_bound(hi.ptr(), hi.ptr()+Nsplit, keys[e])
+                               - hi.ptr());
+  }
+}
+
+} //namespace paradogs
+
+} //namespace libp
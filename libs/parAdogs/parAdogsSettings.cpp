@@ -35,12 +35,62 @@ void AddSettings(settings_t& settings) {
   settings.newSetting("PARADOGS PARTITIONING",
                       "INERTIAL",
                       "Type of Mesh partitioning",
-                      {"NONE", "INERTIAL", "SPECTRAL"});
+                      {"NONE", "INERTIAL", "SPECTRAL", "SFC"});
+
+  settings.newSetting("PARADOGS NODE HIERARCHY",
+                      "FALSE",
+                      "Partition into compute nodes first, then into ranks within each node",
+                      {"TRUE", "FALSE"});
+
+  settings.newSetting("PARADOGS ORDERING",
+                      "CUTHILL-MCKEE",
+                      "Type of rank-local element ordering",
+                      {"CUTHILL-MCKEE", "REVERSE-CUTHILL-MCKEE", "HILBERT", "FACE-BLOCKING"});
+
+  settings.newSetting("PARADOGS TILE SIZE",
+                      "64",
+                      "Elements per cache tile. Used by FACE-BLOCKING ordering and the surface reuse report");
+
+  settings.newSetting("PARADOGS REFINEMENT",
+                      "NONE",
+                      "Type of partition boundary refinement",
+                      {"NONE", "GREEDY"});
+
+  settings.newSetting("PARADOGS IMBALANCE TOLERANCE",
+                      "0.03",
+                      "Allowed relative load imbalance of partition refinement");
+
+  settings.newSetting("PARADOGS REBALANCING",
+                      "NONE",
+                      "Repartition the mesh during time stepping when rank work becomes imbalanced",
+                      {"NONE", "DYNAMIC"});
+
+  settings.newSetting("PARADOGS REBALANCE THRESHOLD",
+                      "1.1",
+                      "Ratio of maximum to mean rank step time which triggers a rebalance");
+
+  settings.newSetting("PARADOGS REBALANCE INTERVAL",
+                      "100",
+                      "Number of time steps between load imbalance checks");
 }
 
 void ReportSettings(settings_t& settings) {
 
   settings.reportSetting("PARADOGS PARTITIONING");
+  settings.reportSetting("PARADOGS NODE HIERARCHY");
+  settings.reportSetting("PARADOGS ORDERING");
+  if (settings.compareSetting("PARADOGS ORDERING", "FACE-BLOCKING"))
+    settings.reportSetting("PARADOGS TILE SIZE");
+  settings.reportSetting("PARADOGS REFINEMENT");
+
+  if (!settings.compareSetting("PARADOGS REFINEMENT", "NONE"))
+    settings.reportSetting("PARADOGS IMBALANCE TOLERANCE");
+
+  settings.reportSetting("PARADOGS REBALANCING");
+  if (!settings.compareSetting("PARADOGS REBALANCING", "NONE")) {
+    settings.reportSetting("PARADOGS REBALANCE THRESHOLD");
+    settings.reportSetting("PARADOGS REBALANCE INTERVAL");
+  }
 }
 
 } //namespace paradogs
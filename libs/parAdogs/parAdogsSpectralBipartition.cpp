@@ -60,6 +60,9 @@ void graph_t::SpectralBipartition(const dfloat targetFraction[2]) {
   /*Fill halo region of partition vector*/
   L[0].A.halo.Exchange(partition, 1);
 
+  /*Improve the cut*/
+  if (refine) RefineBipartition(partition, targetFraction);
+
   /*Split the graph according to this partitioning*/
   Split(partition);
 
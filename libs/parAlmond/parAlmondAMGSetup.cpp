@@ -37,19 +37,41 @@ void parAlmond_t::AMGSetup(parCOO& cooA,
                          memory<dfloat> nullVector,
                          dfloat nullSpacePenalty){
 
-  int rank = cooA.comm.rank();
-  int size = cooA.comm.size();
+  if(Comm::World().rank()==0) {printf("Setting up AMG...");fflush(stdout);}
+
+  //make csr matrix from coo input
+  parCSR A(cooA);
+
+  AMGSetupLevels(A, nullSpace, nullVector, nullSpacePenalty);
+}
+
+void parAlmond_t::AMGSetup(parGlobalCSR& csrA,
+                         bool nullSpace,
+                         memory<dfloat> nullVector,
+                         dfloat nullSpacePenalty){
 
   if(Comm::World().rank()==0) {printf("Setting up AMG...");fflush(stdout);}
 
+  //make csr matrix from globally indexed csr input
+  parCSR A(csrA);
+
+  AMGSetupLevels(A, nullSpace, nullVector, nullSpacePenalty);
+}
+
+void parAlmond_t::AMGSetupLevels(parCSR& A,
+                                 bool nullSpace,
+                                 memory<dfloat> nullVector,
+                                 dfloat nullSpacePenalty){
+
+  int rank = A.comm.rank();
+  int size = A.comm.size();
+
   /*Get multigrid solver*/
   multigrid_t& mg = *multigrid;
 
   /*Get coarse solver*/
   coarseSolver_t& coarse = *(mg.coarseSolver);
 
-  //make csr matrix from coo input
-  parCSR A(cooA);
   A.diagSetup();
 
   //copy fine nullvector
@@ -0,0 +1,93 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "parAlmond.hpp"
+
+namespace libp {
+
+namespace parAlmond {
+
+//compress a row-sorted distributed COO matrix
+parGlobalCSR::parGlobalCSR(parCOO& A):
+  platform(A.platform),
+  comm(A.comm),
+  nnz(A.nnz) {
+
+  int rank = comm.rank();
+
+  //copy global partition
+  globalRowStarts = A.globalRowStarts;
+  globalColStarts = A.globalColStarts;
+
+  const hlong globalRowOffset = globalRowStarts[rank];
+  Nrows = static_cast<dlong>(globalRowStarts[rank+1]-globalRowStarts[rank]);
+
+  rowStarts.malloc(Nrows+1, 0);
+  cols.malloc(nnz);
+  vals.malloc(nnz);
+
+  for (dlong n=0;n<nnz;n++) {
+    const dlong row = static_cast<dlong>(A.entries[n].row - globalRowOffset);
+    rowStarts[row+1]++;
+    cols[n] = A.entries[n].col;
+    vals[n] = A.entries[n].val;
+  }
+
+  for (dlong i=0;i<Nrows;i++) {
+    rowStarts[i+1] += rowStarts[i];
+  }
+}
+
+//expand a distributed CSR matrix
+parCOO::parCOO(parGlobalCSR& A):
+  platform(A.platform),
+  comm(A.comm),
+  nnz(A.nnz) {
+
+  int rank = comm.rank();
+
+  //copy global partition
+  globalRowStarts = A.globalRowStarts;
+  globalColStarts = A.globalColStarts;
+
+  const hlong globalRowOffset = globalRowStarts[rank];
+
+  entries.malloc(nnz);
+
+  #pragma omp parallel for
+  for (dlong i=0;i<A.Nrows;i++) {
+    for (dlong jj=A.rowStarts[i];jj<A.rowStarts[i+1];jj++) {
+      entries[jj].row = i + globalRowOffset;
+      entries[jj].col = A.cols[jj];
+      entries[jj].val = A.vals[jj];
+    }
+  }
+}
+
+} //namespace parAlmond
+
+} //namespace libp
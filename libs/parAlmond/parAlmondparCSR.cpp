@@ -233,6 +233,102 @@ parCSR::parCSR(parCOO& A):       // number of nonzeros on this rank
   }
 }
 
+//build a parCSR matrix from a distributed, globally indexed CSR matrix
+parCSR::parCSR(parGlobalCSR& A):
+  platform(A.platform),
+  comm(A.comm) {
+
+  int rank = comm.rank();
+
+  //copy global partition
+  globalRowStarts = A.globalRowStarts;
+  globalColStarts = A.globalColStarts;
+
+  const hlong globalColOffset = globalColStarts[rank];
+
+  Nrows = static_cast<dlong>(globalRowStarts[rank+1]-globalRowStarts[rank]);
+  Ncols = static_cast<dlong>(globalColStarts[rank+1]-globalColStarts[rank]);
+
+  LIBP_ABORT("parCSR: input matrix has " << A.Nrows << " local rows, expected " << Nrows,
+             A.Nrows != Nrows);
+
+  diag.rowStarts.malloc(Nrows+1, 0);
+  offd.rowStarts.malloc(Nrows+1, 0);
+
+  //count the entries in each row
+  #pragma omp parallel for
+  for (dlong i=0;i<Nrows;i++) {
+    for (dlong jj=A.rowStarts[i];jj<A.rowStarts[i+1];jj++) {
+      if (   (A.cols[jj] < globalColOffset)
+          || (A.cols[jj] > globalColOffset+Ncols-1))
+        offd.rowStarts[i+1]++;
+      else
+        diag.rowStarts[i+1]++;
+    }
+  }
+
+  offd.nzRows=0;
+
+  // count how many rows are shared
+  for(dlong i=0; i<Nrows; i++)
+    if (offd.rowStarts[i+1]>0) offd.nzRows++;
+
+  offd.rows.malloc(offd.nzRows);
+  offd.mRowStarts.malloc(offd.nzRows+1);
+
+  // cumulative sum
+  dlong cnt=0;
+  offd.mRowStarts[0] = 0;
+  for(dlong i=0; i<Nrows; i++) {
+    if (offd.rowStarts[i+1]>0) {
+      offd.rows[cnt] = i; //record row id
+      offd.mRowStarts[cnt+1] = offd.mRowStarts[cnt] + offd.rowStarts[i+1];
+      cnt++;
+    }
+    diag.rowStarts[i+1] += diag.rowStarts[i];
+    offd.rowStarts[i+1] += offd.rowStarts[i];
+  }
+  diag.nnz = diag.rowStarts[Nrows];
+  offd.nnz = offd.rowStarts[Nrows];
+
+  // Halo setup
+  memory<hlong> colIds(offd.nnz);
+  #pragma omp parallel for
+  for (dlong i=0;i<Nrows;i++) {
+    dlong offdCnt = offd.rowStarts[i];
+    for (dlong jj=A.rowStarts[i];jj<A.rowStarts[i+1];jj++) {
+      if (   (A.cols[jj] < globalColOffset)
+          || (A.cols[jj] > globalColOffset+Ncols-1))
+        colIds[offdCnt++] = A.cols[jj];
+    }
+  }
+  haloSetup(colIds); //setup halo, and transform colIds to a local indexing
+
+  //fill the CSR matrices
+  diag.cols.malloc(diag.nnz);
+  offd.cols.malloc(offd.nnz);
+  diag.vals.malloc(diag.nnz);
+  offd.vals.malloc(offd.nnz);
+
+  #pragma omp parallel for
+  for (dlong i=0;i<Nrows;i++) {
+    dlong diagCnt = diag.rowStarts[i];
+    dlong offdCnt = offd.rowStarts[i];
+    for (dlong jj=A.rowStarts[i];jj<A.rowStarts[i+1];jj++) {
+      if (   (A.cols[jj] < globalColOffset)
+          || (A.cols[jj] > globalColOffset+NlocalCols-1)) {
+        offd.cols[offdCnt] = colIds[offdCnt];
+        offd.vals[offdCnt] = A.vals[jj];
+        offdCnt++;
+      } else {
+        diag.cols[diagCnt] = static_cast<dlong>(A.cols[jj] - globalColOffset);
+        diag.vals[diagCnt] = A.vals[jj];
+        diagCnt++;
+      }
+    }
+  }
+}
+
 //------------------------------------------------------------------------
 //
 //  parCSR halo setup
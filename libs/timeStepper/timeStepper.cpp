@@ -33,7 +33,31 @@ void timeStepper_t::Run(solver_t& solver,
                         deviceMemory<dfloat>& o_q,
                         dfloat start, dfloat end) {
   assertInitialized();
+
+  //optional performance counters and timeline, see platform settings
+  settings_t& platformSettings = solver.platform.settings();
+  profiler_t& profiler = solver.platform.profiler();
+
+  const bool profile = platformSettings.compareSetting("PROFILE","TRUE");
+  if (profile) {
+    hlong Ndofs = ts->N;
+    solver.comm.Allreduce(Ndofs);
+    profiler.Enable(Ndofs, platformSettings.compareSetting("PROFILE TRACE","TRUE"));
+  }
+
   ts->Run(solver, o_q, start, end);
+
+  if (profile) {
+    profiler.Report(solver.comm);
+
+    if (platformSettings.compareSetting("PROFILE TRACE","TRUE")) {
+      std::string prefix;
+      platformSettings.getSetting("PROFILE TRACE FILE NAME", prefix);
+      const int rank = solver.comm.rank();
+      profiler.WriteTrace(prefix + "_" + std::to_string(rank) + ".json", rank);
+    }
+    profiler.Disable();
+  }
 }
 
 void timeStepper_t::SetTimeStep(dfloat dt_) {
@@ -51,9 +75,42 @@ dfloat timeStepper_t::GetGamma() {
   return ts->GetGamma();
 }
 
+void timeStepper_t::EnableAdaptiveTimeStep() {
+  assertInitialized();
+  ts->EnableAdaptiveTimeStep();
+}
+
 void timeStepper_t::assertInitialized() {
   LIBP_ABORT("timeStepper_t not initialized",
              ts==nullptr);
 }
 
+namespace TimeStepper {
+
+dfloat timeStepperBase_t::ControlTimeStep(solver_t& solver, deviceMemory<dfloat>& o_q,
+                                          const dfloat time, const dfloat maxGrowth) {
+  //limit growth so the variable-step coefficients stay well conditioned
+  return std::min(solver.MaxTimeStep(o_q, time), maxGrowth*dt);
+}
+
+void timeStepperBase_t::LagrangePolynomial(const int Nnodes, const memory<dfloat> nodes,
+                                           const int i, memory<dfloat> c) {
+  for (int n=0;n<Nnodes;++n) c[n] = 0.0;
+  c[0] = 1.0;
+
+  //multiply out prod_{j!=i} (t-t_j)/(t_i-t_j)
+  int degree = 0;
+  for (int j=0;j<Nnodes;++j) {
+    if (j==i) continue;
+    const dfloat scale = 1.0/(nodes[i]-nodes[j]);
+    for (int n=degree+1;n>0;--n) {
+      c[n] = (c[n-1] - nodes[j]*c[n])*scale;
+    }
+    c[0] = -nodes[j]*c[0]*scale;
+    degree++;
+  }
+}
+
+} //namespace TimeStepper
+
 } //namespace libp
@@ -66,13 +66,42 @@ ab3::ab3(dlong Nelements, dlong NhaloElements,
   ab_a.copyFrom(_ab_a);
 
   o_ab_a = platform.malloc<dfloat>(ab_a);
+
+  adaptive = false;
+  dtHistory.malloc(Nstages, 0.0);
+}
+
+/* Variable step AB coefficients: average of the Lagrange basis through the
+   previous rhs times over the new step */
+void ab3::UpdateCoefficients(const int order, const dfloat _dt) {
+  const int Nnodes = order+1;
+
+  memory<dfloat> nodes(Nnodes);
+  nodes[0] = 0.0;
+  for (int n=1;n<Nnodes;++n) nodes[n] = nodes[n-1] - dtHistory[n-1];
+
+  memory<dfloat> c(Nnodes);
+  for (int i=0;i<Nnodes;++i) {
+    LagrangePolynomial(Nnodes, nodes, i, c);
+
+    dfloat a = 0.0, hn = 1.0;
+    for (int n=0;n<Nnodes;++n) {
+      a += c[n]*hn/(n+1);
+      hn *= _dt;
+    }
+    ab_a[order*Nstages+i] = a;
+  }
+
+  o_ab_a.copyFrom(ab_a + order*Nstages, Nstages, order*Nstages);
 }
 
 void ab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloat end) {
 
   dfloat time = start;
 
+  platform.profiler().Tic(profiler_t::Output);
   solver.Report(time,0);
+  platform.profiler().Toc(profiler_t::Output);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -81,18 +110,56 @@ void ab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloat
 
   int tstep=0;
   int order=0;
+  dfloat dtMin=dt, dtMax=dt;
   while (time < end) {
+    if (adaptive) {
+      if (tstep>0) dt = ControlTimeStep(solver, o_q, time, 1.2);
+      UpdateCoefficients(order, dt);
+      dtMin = std::min(dtMin, dt);
+      dtMax = std::max(dtMax, dt);
+    }
+
+    platform.profiler().Tic(profiler_t::Update);
     Step(solver, o_q, time, dt, order);
+    platform.profiler().Toc(profiler_t::Update);
     time += dt;
     tstep++;
     if (order<Nstages-1) order++;
 
+    if (adaptive) {
+      for (int s=Nstages-1;s>0;--s) dtHistory[s] = dtHistory[s-1];
+      dtHistory[0] = dt;
+    }
+
     if (time>outputTime) {
       //report state
+      platform.profiler().Tic(profiler_t::Output);
       solver.Report(time,tstep);
+      platform.profiler().Toc(profiler_t::Output);
       outputTime += outputInterval;
     }
+
+    Rebalance(solver, o_q);
+  }
+
+  if (adaptive && comm.rank()==0)
+    printf("Adaptive time step: %d steps, dt in [%g, %g]\n", tstep, dtMin, dtMax);
+}
+
+void ab3::Migrate(solver_t& solver, const dlong Nelements, const dlong NhaloElements) {
+  const dlong Nnew = Nelements*Nentries;
+
+  //migrate each stage of the rhs history
+  deviceMemory<dfloat> o_newrhsq = platform.malloc<dfloat>(Nstages*Nnew);
+  for (int s=0;s<Nstages;++s) {
+    deviceMemory<dfloat> o_rhsqs = o_rhsq + s*N;
+    solver.Migrate(o_rhsqs, Nentries);
+    o_newrhsq.copyFrom(o_rhsqs, Nnew, s*Nnew);
   }
+  o_rhsq = o_newrhsq;
+
+  N = Nnew;
+  Nhalo = NhaloElements*Nentries;
 }
 
 void ab3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt, int order) {
@@ -104,11 +171,13 @@ void ab3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat
   deviceMemory<dfloat> o_A = o_ab_a + order*Nstages;
 
   //evaluate ODE rhs = f(q,t)
+  platform.profiler().Tic(profiler_t::Rhs);
   solver.rhsf(o_q, o_rhsq0, time);
+  platform.profiler().Toc(profiler_t::Rhs);
 
   //update q
   updateKernel(N,
-               dt,
+               _dt,
                shiftIndex,
                o_A,
                o_rhsq,
@@ -147,18 +216,20 @@ void ab3_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfl
   deviceMemory<dfloat> o_A = o_ab_a + order*Nstages;
 
   //evaluate ODE rhs = f(q,t)
+  platform.profiler().Tic(profiler_t::Rhs);
   solver.rhsf_pml(o_q, o_pmlq, o_rhsq0, o_rhspmlq0, time);
+  platform.profiler().Toc(profiler_t::Rhs);
 
   //update q & pmlq
   updateKernel(N,
-               dt,
+               _dt,
                shiftIndex,
                o_A,
                o_rhsq,
                o_q);
   if (Npml)
     updateKernel(Npml,
-                 dt,
+                 _dt,
                  shiftIndex,
                  o_A,
                  o_rhspmlq,
@@ -0,0 +1,356 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "core.hpp"
+#include "timeStepper.hpp"
+
+namespace libp {
+
+namespace TimeStepper {
+
+ark::ark(dlong Nelements, dlong NhaloElements,
+         int Np, int Nfields,
+         platform_t& _platform, comm_t _comm,
+         const std::string scheme):
+  timeStepperBase_t(Nelements, NhaloElements,
+                    Np, Nfields, _platform, _comm) {
+
+  LoadTableau(scheme);
+
+  AllocateStages();
+
+  hlong Ntotal = N;
+  comm.Allreduce(Ntotal);
+
+  properties_t kernelInfo = platform.props(); //copy base occa properties from solver
+
+  const int blocksize = 256;
+
+  //add defines
+  kernelInfo["defines/" "p_blockSize"] = (int)blocksize;
+  kernelInfo["defines/" "p_Nrk"] = Nrk;
+
+  rkStageKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
+                                    "timeStepperARK.okl",
+                                    "arkStage",
+                                    kernelInfo);
+
+  rkImplicitKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
+                                    "timeStepperARK.okl",
+                                    "arkImplicit",
+                                    kernelInfo);
+
+  rkUpdateKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
+                                    "timeStepperARK.okl",
+                                    "arkUpdate",
+                                    kernelInfo);
+
+  rkErrorEstimateKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
+                                    "timeStepperDOPRI5.okl",
+                                    "dopri5ErrorEstimate",
+                                    kernelInfo);
+
+  dtMIN = 1E-9; //minumum allowed timestep
+  ATOL = 1E-6;  //absolute error tolerance
+  RTOL = 1E-6;  //relative error tolerance
+  safe = 0.8;   //safety factor
+
+  //error control parameters
+  beta = 0.05;
+  factor1 = 0.2;
+  factor2 = 10.0;
+
+  exp1 = 1.0/(embeddedOrder+1) - 0.75*beta;
+  invfactor1 = 1.0/factor1;
+  invfactor2 = 1.0/factor2;
+  facold = 1E-4;
+  sqrtinvNtotal = 1.0/sqrt(Ntotal);
+}
+
+/* Kennedy & Carpenter, Additive Runge-Kutta schemes for
+   convection-diffusion-reaction equations, Appl. Numer. Math. 44 (2003) */
+void ark::LoadTableau(const std::string scheme) {
+
+  if (scheme=="ARK3") {
+    // ARK3(2)4L[2]SA
+    Nrk = 4;
+    embeddedOrder = 2;
+    const dfloat g = 1767732205903.0/4055673282236.0;
+
+    dfloat _rkC[4] = {0.0, 1767732205903.0/2027836641118.0, 3.0/5.0, 1.0};
+    dfloat _rkAe[4*4] = {
+                                      0.0,                                0.0,                                  0.0, 0.0,
+         1767732205903.0/2027836641118.0,                                0.0,                                  0.0, 0.0,
+        5535828885825.0/10492691773637.0,   788022342437.0/10882634858940.0,                                  0.0, 0.0,
+        6485989280629.0/16251701735622.0, -4246266847089.0/9704473918619.0, 10755448449292.0/10357097424841.0, 0.0};
+    dfloat _rkAi[4*4] = {
+                                      0.0,                                0.0,                                  0.0, 0.0,
+                                        g,                                  g,                                  0.0, 0.0,
+        2746238789719.0/10658868560708.0,  -640167445237.0/6845629431997.0,                                    g, 0.0,
+         1471266399579.0/7840856788654.0, -4482444167858.0/7529755066697.0, 11266239266428.0/11593286722821.0,   g};
+    dfloat _rkBhat[4] = {2756255671327.0/12835298489170.0, -10771552573575.0/22201958757719.0,
+                         9247589265047.0/10645013368117.0,   2193209047091.0/5459859503100.0};
+
+    rkGamma = g;
+    rkC.malloc(Nrk);  rkC.copyFrom(_rkC);
+    rkAe.malloc(Nrk*Nrk); rkAe.copyFrom(_rkAe);
+    rkAi.malloc(Nrk*Nrk); rkAi.copyFrom(_rkAi);
+    rkE.malloc(Nrk); rkE.copyFrom(_rkBhat);
+
+  } else if (scheme=="ARK4") {
+    // ARK4(3)6L[2]SA
+    Nrk = 6;
+    embeddedOrder = 3;
+    const dfloat g = 1.0/4.0;
+
+    dfloat _rkC[6] = {0.0, 1.0/2.0, 83.0/250.0, 31.0/50.0, 17.0/20.0, 1.0};
+    dfloat _rkAe[6*6] = {
+                                    0.0,                                 0.0,                                  0.0,                                 0.0,           0.0, 0.0,
+                                1.0/2.0,                                 0.0,                                  0.0,                                 0.0,           0.0, 0.0,
+                        13861.0/62500.0,                      6889.0/62500.0,                                  0.0,                                 0.0,           0.0, 0.0,
+      -116923316275.0/2393684061468.0, -2731218467317.0/15368042101831.0,  9408046702089.0/11113171139209.0,                                 0.0,           0.0, 0.0,
+      -451086348788.0/2902428689909.0,  -2682348792572.0/7519795681897.0, 12662868775082.0/11960479115383.0, 3355817975965.0/11060851509271.0,           0.0, 0.0,
+       647845179188.0/3216320057751.0,     73281519250.0/8382639484533.0,    552539513391.0/3454668386233.0,  3354512671639.0/8306763924573.0, 4040.0/17871.0, 0.0};
+    dfloat _rkAi[6*6] = {
+                                0.0,                       0.0,                         0.0,                     0.0,             0.0, 0.0,
+                                  g,                         g,                         0.0,                     0.0,             0.0, 0.0,
+                    8611.0/62500.0,          -1743.0/31250.0,                            g,                     0.0,             0.0, 0.0,
+                5012029.0/34652500.0,        -654441.0/2922500.0,          174375.0/388108.0,                       g,             0.0, 0.0,
+        15267082809.0/155376265600.0,   -71443401.0/120774400.0,   730878875.0/902184768.0,    2285395.0/8070912.0,               g, 0.0,
+                   82889.0/524892.0,                       0.0,           15625.0/83664.0,       69875.0/102672.0,  -2260.0/8211.0,   g};
+    dfloat _rkBhat[6] = {4586570599.0/29645900160.0, 0.0, 178811875.0/945068544.0,
+                         814220225.0/1159782912.0, -3700637.0/11593932.0, 61727.0/225920.0};
+
+    rkGamma = g;
+    rkC.malloc(Nrk);  rkC.copyFrom(_rkC);
+    rkAe.malloc(Nrk*Nrk); rkAe.copyFrom(_rkAe);
+    rkAi.malloc(Nrk*Nrk); rkAi.copyFrom(_rkAi);
+    rkE.malloc(Nrk); rkE.copyFrom(_rkBhat);
+
+  } else {
+    LIBP_FORCE_ABORT("Unknown ARK scheme: " << scheme);
+  }
+
+  //both schemes are stiffly accurate, so the weights are the last implicit row
+  rkB.malloc(Nrk);
+  rkB.copyFrom(rkAi + (Nrk-1)*Nrk, Nrk);
+
+  //error weights are the difference to the embedded scheme
+  for (int i=0;i<Nrk;++i) rkE[i] = rkB[i] - rkE[i];
+
+  o_rkAe = platform.malloc<dfloat>(rkAe);
+  o_rkAi = platform.malloc<dfloat>(rkAi);
+  o_rkB  = platform.malloc<dfloat>(rkB);
+  o_rkE  = platform.malloc<dfloat>(rkE);
+}
+
+void ark::AllocateStages() {
+  o_rkq   = platform.malloc<dfloat>(N+Nhalo);
+  o_rkF   = platform.malloc<dfloat>(Nrk*N);
+  o_rkG   = platform.malloc<dfloat>(Nrk*N);
+  o_rkS   = platform.malloc<dfloat>(N);
+  o_rhs   = platform.malloc<dfloat>(N);
+  o_rkerr = platform.malloc<dfloat>(N);
+
+  const int blocksize = 256;
+
+  Nblock = (N+blocksize-1)/blocksize;
+  h_errtmp = platform.hostMalloc<dfloat>(Nblock);
+  o_errtmp = platform.malloc<dfloat>(Nblock);
+}
+
+dfloat ark::GetGamma() {
+  return rkGamma;
+}
+
+void ark::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloat end) {
+
+  dfloat time = start;
+
+  platform.profiler().Tic(profiler_t::Output);
+  solver.Report(time,0);
+  platform.profiler().Toc(profiler_t::Output);
+
+  dfloat outputInterval=0.0;
+  solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
+
+  dfloat outputTime = time + outputInterval;
+
+  int tstep=0;
+
+  while (time < end) {
+
+    LIBP_ABORT("Time step became too small at time step = " << tstep,
+               dt<dtMIN);
+    LIBP_ABORT("Solution became unstable at time step = " << tstep,
+               std::isnan(dt));
+
+    //land on the next output time, or the final time
+    dfloat stepdt = dt;
+    if (time+stepdt > outputTime) stepdt = outputTime-time;
+    if (time+stepdt > end)        stepdt = end-time;
+
+    platform.profiler().Tic(profiler_t::Update);
+    Step(solver, o_q, time, stepdt);
+    platform.profiler().Toc(profiler_t::Update);
+
+    // compute embedded error estimate
+    dfloat err = Estimater(o_q);
+
+    // build controller
+    dfloat fac1 = pow(err,exp1);
+    dfloat fac = fac1/pow(facold,beta);
+
+    fac = std::max(invfactor2, std::min(invfactor1,fac/safe));
+
+    if (err<1.0) { //step is accepted
+      o_q.copyFrom(o_rkq, N);
+      time += stepdt;
+
+      constexpr dfloat errMax = 1.0e-4;
+      facold = std::max(err,errMax);
+
+      tstep++;
+
+      //only grow from a full step, not from a shortened output step
+      if (stepdt==dt) dt = dt/fac;
+
+      if (time>=outputTime) {
+        //report state
+        platform.profiler().Tic(profiler_t::Output);
+        solver.Report(time,tstep);
+        platform.profiler().Toc(profiler_t::Output);
+        while (time>=outputTime) outputTime += outputInterval;
+      }
+
+      Rebalance(solver, o_q);
+    } else {
+      dt = stepdt/(std::max(invfactor1,fac1/safe));
+    }
+  }
+}
+
+void ark::Migrate(solver_t& solver, const dlong Nelements, const dlong NhaloElements) {
+  //no history is kept between steps, so just resize the stage storage
+  N = Nelements*Nentries;
+  Nhalo = NhaloElements*Nentries;
+
+  AllocateStages();
+}
+
+void ark::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt) {
+
+  const dfloat invDtGamma = 1.0/(_dt*rkGamma);
+
+  //first stage is explicit: Q_0 = q
+  o_rkq.copyFrom(o_q, N);
+
+  deviceMemory<dfloat> o_F0 = o_rkF;
+  deviceMemory<dfloat> o_G0 = o_rkG;
+  platform.profiler().Tic(profiler_t::Rhs);
+  solver.rhs_imex_f(o_rkq, o_F0, time);
+  platform.profiler().Toc(profiler_t::Rhs);
+  platform.profiler().Tic(profiler_t::Rhs);
+  solver.rhs_imex_g(o_rkq, o_G0, time);
+  platform.profiler().Toc(profiler_t::Rhs);
+
+  for(int rk=1;rk<Nrk;++rk){
+
+    // t_rk = t + C_rk*_dt
+    dfloat currentTime = time + rkC[rk]*_dt;
+
+    // S = q + _dt sum_{j<rk} (Ae_{rk,j} F_j + Ai_{rk,j} G_j)
+    rkStageKernel(N,
+                  rk,
+                  _dt,
+                  invDtGamma,
+                  o_rkAe,
+                  o_rkAi,
+                  o_q,
+                  o_rkF,
+                  o_rkG,
+                  o_rkS,
+                  o_rhs);
+
+    //solve implicit stage, using the previous stage as initial guess:
+    // find Q_rk such that Q_rk/(_dt*gamma) - G(Q_rk) = S/(_dt*gamma)
+    platform.profiler().Tic(profiler_t::Rhs);
+    solver.rhs_imex_invg(o_rhs, o_rkq, invDtGamma, currentTime);
+    platform.profiler().Toc(profiler_t::Rhs);
+
+    //G_rk follows from the stage equation without another evaluation
+    rkImplicitKernel(N,
+                     rk,
+                     invDtGamma,
+                     o_rkS,
+                     o_rkq,
+                     o_rkG);
+
+    //evaluate explicit part F(Q_rk)
+    deviceMemory<dfloat> o_Frk = o_rkF + rk*N;
+    platform.profiler().Tic(profiler_t::Rhs);
+    solver.rhs_imex_f(o_rkq, o_Frk, currentTime);
+    platform.profiler().Toc(profiler_t::Rhs);
+  }
+
+  // rkq = q + _dt sum_j B_j (F_j + G_j)
+  rkUpdateKernel(N,
+                 _dt,
+                 o_rkB,
+                 o_rkE,
+                 o_q,
+                 o_rkF,
+                 o_rkG,
+                 o_rkq,
+                 o_rkerr);
+}
+
+dfloat ark::Estimater(deviceMemory<dfloat>& o_q){
+
+  rkErrorEstimateKernel(N,
+                        ATOL,
+                        RTOL,
+                        o_q,
+                        o_rkq,
+                        o_rkerr,
+                        o_errtmp);
+
+  h_errtmp.copyFrom(o_errtmp);
+  dfloat err = 0;
+  for(dlong n=0;n<Nblock;++n){
+    err += h_errtmp[n];
+  }
+  comm.Allreduce(err);
+
+  err = sqrt(err)*sqrtinvNtotal;
+
+  return err;
+}
+
+} //namespace TimeStepper
+
+} //namespace libp
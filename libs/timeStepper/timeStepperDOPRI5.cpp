@@ -121,7 +121,9 @@ void dopri5::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dflo
   // int rank;
   // comm_rank_t(comm, &rank);
 
+  platform.profiler().Tic(profiler_t::Output);
   solver.Report(time,0);
+  platform.profiler().Toc(profiler_t::Output);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -142,7 +144,9 @@ void dopri5::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dflo
       dt = end-time;
     }
 
+    platform.profiler().Tic(profiler_t::Update);
     Step(solver, o_q, time, dt);
+    platform.profiler().Toc(profiler_t::Update);
 
     // compute Dopri estimator
     dfloat err = Estimater(o_q);
@@ -170,14 +174,18 @@ void dopri5::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dflo
         //   printf("Taking output mini step: %g\n", dt);
 
         // time step to output
+        platform.profiler().Tic(profiler_t::Update);
         Step(solver, o_q, time, dt);
+        platform.profiler().Toc(profiler_t::Update);
 
         // shift for output
         o_rkq.copyTo(o_q);
 
         // output  (print from rkq)
         // if (!rank) printf("\n");
+        platform.profiler().Tic(profiler_t::Output);
         solver.Report(outputTime,tstep);
+        platform.profiler().Toc(profiler_t::Output);
 
         // restore time step
         dt = savedt;
@@ -203,6 +211,8 @@ void dopri5::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dflo
       //   printf("\r time = %g (%d), dt = %g accepted                      ", time, allStep,  dt);
 
       tstep++;
+
+      Rebalance(solver, o_q);
     } else {
       dtnew = dt/(std::max(invfactor1,fac1/safe));
 
@@ -219,6 +229,25 @@ void dopri5::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dflo
   //   printf("%d accepted steps and %d total steps\n", tstep, allStep);
 }
 
+void dopri5::Migrate(solver_t& solver, const dlong Nelements, const dlong NhaloElements) {
+  //no history is kept between steps, so just resize the stage storage
+  N = Nelements*Nentries;
+  Nhalo = NhaloElements*Nentries;
+
+  o_rhsq   = platform.malloc<dfloat>(N);
+  o_rkq    = platform.malloc<dfloat>(N+Nhalo);
+  o_rkrhsq = platform.malloc<dfloat>(Nrk*N);
+  o_rkerr  = platform.malloc<dfloat>(N);
+
+  o_saveq  = platform.malloc<dfloat>(N);
+
+  const int blocksize = 256;
+
+  Nblock = (N+blocksize-1)/blocksize;
+  h_errtmp = platform.hostMalloc<dfloat>(Nblock);
+  o_errtmp = platform.malloc<dfloat>(Nblock);
+}
+
 void dopri5::Backup(deviceMemory<dfloat> &o_Q) {
   o_saveq.copyFrom(o_Q, N);
 }
@@ -250,7 +279,9 @@ void dopri5::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dflo
                   o_rkq);
 
     //evaluate ODE rhs = f(q,t)
+    platform.profiler().Tic(profiler_t::Rhs);
     solver.rhsf(o_rkq, o_rhsq, currentTime);
+    platform.profiler().Toc(profiler_t::Rhs);
 
     // update solution using Runge-Kutta
     // rkrhsq_rk = rhsq
@@ -374,7 +405,9 @@ void dopri5_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time,
                     o_rkpmlq);
 
     //evaluate ODE rhs = f(q,t)
+    platform.profiler().Tic(profiler_t::Rhs);
     solver.rhsf_pml(o_rkq, o_rkpmlq, o_rhsq, o_rhspmlq, currentTime);
+    platform.profiler().Toc(profiler_t::Rhs);
 
     // update solution using Runge-Kutta
     // rkrhsq_rk = rhsq
@@ -78,6 +78,38 @@ extbdf3::extbdf3(dlong Nelements, dlong NhaloElements,
 
   o_extbdf_a = platform.malloc<dfloat>(extbdf_a);
   o_extbdf_b = platform.malloc<dfloat>(extbdf_b);
+
+  adaptive = false;
+  dtHistory.malloc(Nstages, 0.0);
+}
+
+/* Variable step BDF and EXT coefficients from Lagrange interpolants
+   through the previous step times */
+void extbdf3::UpdateCoefficients(const int order, const dfloat _dt) {
+  const int Nnodes = order+2;
+
+  //BDF: differentiate the interpolant through t^{n+1}, t^n, ...
+  memory<dfloat> nodes(Nnodes);
+  nodes[0] = 0.0;
+  nodes[1] = -_dt;
+  for (int n=2;n<Nnodes;++n) nodes[n] = nodes[n-1] - dtHistory[n-2];
+
+  memory<dfloat> c(Nnodes);
+  memory<dfloat> B = extbdf_b + order*(Nstages+1);
+  for (int i=0;i<Nnodes;++i) {
+    LagrangePolynomial(Nnodes, nodes, i, c);
+    B[i] = (i==0) ? _dt*c[1] : -_dt*c[1];
+  }
+
+  //EXT: evaluate the interpolant through t^n, t^{n-1}, ... at t^{n+1}
+  memory<dfloat> A = extbdf_a + order*Nstages;
+  for (int i=0;i<Nnodes-1;++i) {
+    LagrangePolynomial(Nnodes-1, nodes+1, i, c);
+    A[i] = c[0];
+  }
+
+  o_extbdf_a.copyFrom(A, Nstages, order*Nstages);
+  o_extbdf_b.copyFrom(B, Nstages+1, order*(Nstages+1));
 }
 
 dfloat extbdf3::GetGamma() {
@@ -88,7 +120,9 @@ void extbdf3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfl
 
   dfloat time = start;
 
+  platform.profiler().Tic(profiler_t::Output);
   solver.Report(time,0);
+  platform.profiler().Toc(profiler_t::Output);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -98,14 +132,28 @@ void extbdf3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfl
   int tstep=0;
   int order=0;
   while (time < end) {
+    if (adaptive) {
+      if (tstep>0) dt = ControlTimeStep(solver, o_q, time, 1.2);
+      UpdateCoefficients(order, dt);
+    }
+
+    platform.profiler().Tic(profiler_t::Update);
     Step(solver, o_q, time, dt, order);
+    platform.profiler().Toc(profiler_t::Update);
     time += dt;
     tstep++;
     if (order<Nstages-1) order++;
 
+    if (adaptive) {
+      for (int s=Nstages-1;s>0;--s) dtHistory[s] = dtHistory[s-1];
+      dtHistory[0] = dt;
+    }
+
     if (time>outputTime) {
       //report state
+      platform.profiler().Tic(profiler_t::Output);
       solver.Report(time,tstep);
+      platform.profiler().Toc(profiler_t::Output);
       outputTime += outputInterval;
     }
   }
@@ -122,7 +170,9 @@ void extbdf3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfl
   memory<dfloat> B = extbdf_b + order*(Nstages+1);
 
   //evaluate explicit part of rhs: F(q,t)
+  platform.profiler().Tic(profiler_t::Rhs);
   solver.rhs_imex_f(o_q, o_F0, time);
+  platform.profiler().Toc(profiler_t::Rhs);
 
   //build rhs for implicit step and update history
   rhsKernel(N,
@@ -139,7 +189,9 @@ void extbdf3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfl
 
   //solve implicit part:
   // find q such that gamma*q - G(q) = rhs
+  platform.profiler().Tic(profiler_t::Rhs);
   solver.rhs_imex_invg(o_rhs, o_q, gamma, time+_dt);
+  platform.profiler().Toc(profiler_t::Rhs);
 
   //rotate index
   shiftIndex = (shiftIndex+Nstages-1)%Nstages;
@@ -0,0 +1,367 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "core.hpp"
+#include "timeStepper.hpp"
+#include <fstream>
+
+namespace libp {
+
+namespace TimeStepper {
+
+namespace {
+
+struct lsrkTableau_t {
+  const char* name;
+  int order;
+  int Nstages;
+  const double* A;
+  const double* B;
+  const double* C;
+};
+
+/* Carpenter-Kennedy, 5 stages, order 4 (same as LSERK4) */
+const double ck54A[5] = {0.0,
+                        -567301805773.0/1357537059087.0,
+                        -2404267990393.0/2016746695238.0,
+                        -3550918686646.0/2091501179385.0,
+                        -1275806237668.0/842570457699.0};
+const double ck54B[5] = {1432997174477.0/9575080441755.0,
+                         5161836677717.0/13612068292357.0,
+                         1720146321549.0/2090206949498.0,
+                         3134564353537.0/4481467310338.0,
+                         2277821191437.0/14882151754819.0};
+const double ck54C[5] = {0.0,
+                         1432997174477.0/9575080441755.0,
+                         2526269341429.0/6820363962896.0,
+                         2006345519317.0/3224310063776.0,
+                         2802321613138.0/2924317926251.0};
+
+/* Niegemann-Diehl-Busch, 12 stages, order 4. Optimized for
+   imaginary-axis (advective) spectra */
+const double ndb124A[12] = {0.0,
+                           -0.0923311242368072,
+                           -0.9441056581158819,
+                           -4.3271273247576394,
+                           -2.1557771329026072,
+                           -0.9770727190189062,
+                           -0.7581835342571139,
+                           -1.7977525470825499,
+                           -2.6915667972700770,
+                           -4.6466798960268143,
+                           -0.1539613783825189,
+                           -0.5943293901830616};
+const double ndb124B[12] = {0.0650008435125904,
+                            0.0161459902249842,
+                            0.5758627178358159,
+                            0.1649758848361671,
+                            0.3934619494248182,
+                            0.0443509641602719,
+                            0.2074504268408778,
+                            0.6914247433015102,
+                            0.3766646883450449,
+                            0.0757190350155483,
+                            0.2027862031054088,
+                            0.2167029365631842};
+const double ndb124C[12] = {0.0,
+                            0.0650008435125904,
+                            0.0796560563081853,
+                            0.1620416710085376,
+                            0.2248877362907778,
+                            0.2952293985641261,
+                            0.3318332506149405,
+                            0.4094724050198658,
+                            0.6356954475753369,
+                            0.6806551557645497,
+                            0.7143773712418350,
+                            0.9032588871651854};
+
+/* Niegemann-Diehl-Busch, 14 stages, order 4. Optimized for
+   upwind DG spectra with large negative real parts */
+const double ndb144A[14] = {0.0,
+                           -0.7188012108672410,
+                           -0.7785331173421570,
+                           -0.0053282796654044,
+                           -0.8552979934029281,
+                           -3.9564138245774565,
+                           -1.5780575380587385,
+                           -2.0837094552574054,
+                           -0.7483334182761610,
+                           -0.7032861106563359,
+                            0.0013917096117681,
+                           -0.0932075369637460,
+                           -0.9514200470875948,
+                           -7.1151571693922548};
+const double ndb144B[14] = {0.0367762454319673,
+                            0.3136296607553959,
+                            0.1531848691869027,
+                            0.0030097086818182,
+                            0.3326293790646110,
+                            0.2440251405350864,
+                            0.3718879239592277,
+                            0.6204126221582444,
+                            0.1524043173028741,
+                            0.0760894927419266,
+                            0.0077604214040978,
+                            0.0024647284755382,
+                            0.0780348340049386,
+                            5.5059777270269628};
+const double ndb144C[14] = {0.0,
+                            0.0367762454319673,
+                            0.1249685262725025,
+                            0.2446177702277698,
+                            0.2476149531070420,
+                            0.2969311120382472,
+                            0.3978149645802642,
+                            0.5270854589440328,
+                            0.6981269994175695,
+                            0.8190890835352128,
+                            0.8527059887098624,
+                            0.8604711817462826,
+                            0.8627060376969976,
+                            0.8734213127600976};
+
+/* Williamson, 3 stages, order 3 */
+const double w3A[3] = {0.0, -5.0/9.0, -153.0/128.0};
+const double w3B[3] = {1.0/3.0, 15.0/16.0, 8.0/15.0};
+const double w3C[3] = {0.0, 1.0/3.0, 3.0/4.0};
+
+const lsrkTableau_t lsrkTableaus[] = {
+  {"LSERK4",  4,  5,  ck54A,  ck54B,  ck54C},
+  {"NDB124",  4, 12, ndb124A, ndb124B, ndb124C},
+  {"NDB144",  4, 14, ndb144A, ndb144B, ndb144C},
+  {"W3",      3,  3,  w3A,     w3B,     w3C}
+};
+
+} //namespace
+
+lsrk::lsrk(dlong Nelements, dlong NhaloElements,
+           int Np, int Nfields,
+           platform_t& _platform, comm_t _comm,
+           const std::string tableau,
+           const bool _fused):
+  timeStepperBase_t(Nelements, NhaloElements, Np, Nfields,
+                    _platform, _comm),
+  fused(_fused) {
+
+  LoadTableau(tableau);
+
+  //zero the residual so the first stage (rka[0]=0) never reads garbage
+  memory<dfloat> resq(N, 0.0);
+  o_resq = platform.malloc<dfloat>(resq);
+  o_rhsq = platform.malloc<dfloat>(N);
+
+  o_saveq = platform.malloc<dfloat>(N);
+
+  if (fused) o_qnext = platform.malloc<dfloat>(N+Nhalo);
+
+  properties_t kernelInfo = platform.props(); //copy base occa properties from solver
+
+  const int blocksize=256;
+
+  kernelInfo["defines/" "p_blockSize"] = blocksize;
+
+  // the 2N update is scheme independent, so reuse the LSERK4 kernel
+  updateKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
+                                    "timeStepperLSERK4.okl",
+                                    "lserk4Update",
+                                    kernelInfo);
+}
+
+void lsrk::LoadTableau(const std::string tableau) {
+
+  for (const lsrkTableau_t& t : lsrkTableaus) {
+    if (tableau==t.name) {
+      Nrk = t.Nstages;
+      rka.malloc(Nrk);
+      rkb.malloc(Nrk);
+      rkc.malloc(Nrk+1);
+      for (int rk=0;rk<Nrk;++rk) {
+        rka[rk] = static_cast<dfloat>(t.A[rk]);
+        rkb[rk] = static_cast<dfloat>(t.B[rk]);
+        rkc[rk] = static_cast<dfloat>(t.C[rk]);
+      }
+      rkc[Nrk] = 1.0;
+      return;
+    }
+  }
+
+  // not a built-in scheme, so treat the name as a tableau file.
+  // Format: optional '#' comment lines, then one "A B c" row per stage
+  std::ifstream file(tableau);
+  if (!file.is_open()) {
+    LIBP_FORCE_ABORT("Unknown LSRK tableau: " << tableau);
+  }
+
+  std::vector<double> A, B, C;
+  std::string line;
+  while (std::getline(file, line)) {
+    size_t pos = line.find_first_not_of(" \t\r");
+    if (pos==std::string::npos || line[pos]=='#') continue;
+
+    std::stringstream ss(line);
+    double a, b, c;
+    if (!(ss >> a >> b >> c)) {
+      LIBP_FORCE_ABORT("Malformed row in LSRK tableau file " << tableau << ": " << line);
+    }
+    A.push_back(a);
+    B.push_back(b);
+    C.push_back(c);
+  }
+
+  Nrk = static_cast<int>(A.size());
+  LIBP_ABORT("LSRK tableau file " << tableau << " has no stages",
+             Nrk==0);
+  LIBP_ABORT("LSRK tableau file " << tableau << " must have A[0]=0",
+             A[0]!=0.0);
+
+  rka.malloc(Nrk);
+  rkb.malloc(Nrk);
+  rkc.malloc(Nrk+1);
+  for (int rk=0;rk<Nrk;++rk) {
+    rka[rk] = static_cast<dfloat>(A[rk]);
+    rkb[rk] = static_cast<dfloat>(B[rk]);
+    rkc[rk] = static_cast<dfloat>(C[rk]);
+  }
+  rkc[Nrk] = 1.0;
+}
+
+void lsrk::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloat end) {
+
+  dfloat time = start;
+
+  platform.profiler().Tic(profiler_t::Output);
+  solver.Report(time,0);
+  platform.profiler().Toc(profiler_t::Output);
+
+  dfloat outputInterval=0.0;
+  solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
+
+  dfloat outputTime = time + outputInterval;
+
+  int tstep=0;
+  dfloat stepdt;
+  while (time < end) {
+
+    if (time<outputTime && time+dt>=outputTime) {
+
+      //save current state
+      o_saveq.copyFrom(o_q, N);
+
+      stepdt = outputTime-time;
+
+      //take small time step
+      platform.profiler().Tic(profiler_t::Update);
+      Step(solver, o_q, time, stepdt);
+      platform.profiler().Toc(profiler_t::Update);
+
+      //report state
+      platform.profiler().Tic(profiler_t::Output);
+      solver.Report(outputTime,tstep);
+      platform.profiler().Toc(profiler_t::Output);
+
+      //restore previous state
+      o_q.copyFrom(o_saveq, N);
+
+      outputTime += outputInterval;
+    }
+
+    //check for final timestep
+    if (time+dt > end){
+      stepdt = end-time;
+    } else {
+      stepdt = dt;
+    }
+
+    platform.profiler().Tic(profiler_t::Update);
+    Step(solver, o_q, time, stepdt);
+    platform.profiler().Toc(profiler_t::Update);
+    time += stepdt;
+    tstep++;
+
+    Rebalance(solver, o_q);
+  }
+}
+
+void lsrk::Migrate(solver_t& solver, const dlong Nelements, const dlong NhaloElements) {
+  //no history is kept between steps, so just resize the stage storage
+  N = Nelements*Nentries;
+  Nhalo = NhaloElements*Nentries;
+
+  memory<dfloat> resq(N, 0.0);
+  o_resq = platform.malloc<dfloat>(resq);
+  o_rhsq = platform.malloc<dfloat>(N);
+
+  o_saveq = platform.malloc<dfloat>(N);
+
+  if (fused) o_qnext = platform.malloc<dfloat>(N+Nhalo);
+}
+
+void lsrk::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt) {
+
+  if (fused) {
+    // the solver evaluates the rhs and applies the stage update in one pass,
+    // reading o_q and writing o_qnext so neighbor traces are never overwritten
+    for(int rk=0;rk<Nrk;++rk){
+      dfloat currentTime = time + rkc[rk]*_dt;
+
+      platform.profiler().Tic(profiler_t::Rhs);
+      solver.rhsf_lsrk(o_q, o_qnext, o_rhsq, o_resq, currentTime,
+                       _dt, rka[rk], rkb[rk]);
+      platform.profiler().Toc(profiler_t::Rhs);
+
+      std::swap(o_q, o_qnext);
+    }
+
+    //an odd stage count leaves the result in the scratch buffer. Hand the
+    // caller back its own buffer so other handles to it stay current
+    if (Nrk%2) {
+      std::swap(o_q, o_qnext);
+      o_q.copyFrom(o_qnext, N);
+    }
+    return;
+  }
+
+  // Low storage explicit Runge Kutta, one update kernel per stage
+  for(int rk=0;rk<Nrk;++rk){
+
+    dfloat currentTime = time + rkc[rk]*_dt;
+
+    //evaluate ODE rhs = f(q,t)
+    platform.profiler().Tic(profiler_t::Rhs);
+    solver.rhsf(o_q, o_rhsq, currentTime);
+    platform.profiler().Toc(profiler_t::Rhs);
+
+    // update solution using Runge-Kutta
+    updateKernel(N, _dt, rka[rk], rkb[rk],
+                 o_rhsq, o_resq, o_q);
+  }
+}
+
+} //namespace TimeStepper
+
+} //namespace libp
@@ -26,6 +26,7 @@ SOFTWARE.
 
 #include "core.hpp"
 #include "timeStepper.hpp"
+#include "timer.hpp"
 
 namespace libp {
 
@@ -110,7 +111,9 @@ void mrab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloa
   o_mrdt.copyFrom(mrdt);
   h_shiftIndex.copyTo(o_shiftIndex);
 
+  platform.profiler().Tic(profiler_t::Output);
   solver.Report(time,0);
+  platform.profiler().Toc(profiler_t::Output);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -135,18 +138,35 @@ void mrab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloa
 
   int tstep=0;
   int order=0;
+  //only a measured cost model compares its prediction with the achieved step time
+  const bool timeSteps = mesh.mrMeasuredCosts;
+  timeSingleRate = timeSteps;
+  singleRateTime = 0.0;
+  double stepTime=0.0;
   while (time < end) {
+    timePoint_t stepStart;
+    if (timeSteps) stepStart = PlatformTime(platform);
+    platform.profiler().Tic(profiler_t::Update);
     Step(solver, o_q, time, dt, order);
+    platform.profiler().Toc(profiler_t::Update);
+    if (timeSteps) stepTime += ElapsedTime(stepStart, PlatformTime(platform));
     time += DT;
     tstep++;
     if (order<Nstages-1) order++;
 
     if (time>outputTime) {
       //report state
+      platform.profiler().Tic(profiler_t::Output);
       solver.Report(outputTime,tstep);
+      platform.profiler().Toc(profiler_t::Output);
       outputTime += outputInterval;
     }
   }
+
+  //each step runs the all-level rhs and update once
+  if (timeSteps && tstep)
+    mesh.MultiRateReport(static_cast<hlong>(tstep)*(1 << (Nlevels-1)), stepTime,
+                         singleRateTime/tstep);
 }
 
 void mrab3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt, int order) {
@@ -163,12 +183,23 @@ void mrab3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloa
     for (;lev<Nlevels-1;lev++)
       if (Ntick % (1<<(lev+1)) != 0) break; //find the max lev to compute rhs
 
+    //the all-level rhs and update are the work of a single-rate step
+    const bool timeRhs = timeSingleRate && lev==Nlevels-1;
+    timePoint_t singleRateStart;
+    if (timeRhs) singleRateStart = PlatformTime(platform);
+
     //evaluate ODE rhs = f(q,t)
+    platform.profiler().Tic(profiler_t::Rhs);
     solver.rhsf_MR(o_q, o_rhsq0, o_fQM, currentTime, lev);
+    platform.profiler().Toc(profiler_t::Rhs);
+    if (timeRhs) singleRateTime += ElapsedTime(singleRateStart, PlatformTime(platform));
 
     for (lev=0;lev<Nlevels-1;lev++)
       if ((Ntick+1) % (1<<(lev+1)) !=0) break; //find the max lev to update
 
+    const bool timeUpdate = timeSingleRate && lev==Nlevels-1;
+    if (timeUpdate) singleRateStart = PlatformTime(platform);
+
     // update all elements of level <= lev
     if (mesh.mrNelements[lev])
       updateKernel(mesh.mrNelements[lev],
@@ -184,6 +215,8 @@ void mrab3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloa
                    o_fQM,
                    o_q);
 
+    if (timeUpdate) singleRateTime += ElapsedTime(singleRateStart, PlatformTime(platform));
+
     //rotate index
     if (Nstages>2)
       for (int l=0; l<=lev; l++)
@@ -266,14 +299,25 @@ void mrab3_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, d
     for (;lev<Nlevels-1;lev++)
       if (Ntick % (1<<(lev+1)) != 0) break; //find the max lev to compute rhs
 
+    //the all-level rhs and update are the work of a single-rate step
+    const bool timeRhs = timeSingleRate && lev==Nlevels-1;
+    timePoint_t singleRateStart;
+    if (timeRhs) singleRateStart = PlatformTime(platform);
+
     //evaluate ODE rhs = f(q,t)
+    platform.profiler().Tic(profiler_t::Rhs);
     solver.rhsf_MR_pml(o_q, o_pmlq,
                        o_rhsq0, o_rhspmlq0,
                        o_fQM, currentTime, lev);
+    platform.profiler().Toc(profiler_t::Rhs);
+    if (timeRhs) singleRateTime += ElapsedTime(singleRateStart, PlatformTime(platform));
 
     for (lev=0;lev<Nlevels-1;lev++)
       if ((Ntick+1) % (1<<(lev+1)) !=0) break; //find the max lev to update
 
+    const bool timeUpdate = timeSingleRate && lev==Nlevels-1;
+    if (timeUpdate) singleRateStart = PlatformTime(platform);
+
     // update all elements of level <= lev
     if (mesh.mrNelements[lev])
       updateKernel(mesh.mrNelements[lev],
@@ -303,6 +347,8 @@ void mrab3_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, d
                      o_rhspmlq,
                      o_pmlq);
 
+    if (timeUpdate) singleRateTime += ElapsedTime(singleRateStart, PlatformTime(platform));
+
     //rotate index
     if (Nstages>2)
       for (int l=0; l<=lev; l++)
@@ -26,6 +26,7 @@ SOFTWARE.
 
 #include "core.hpp"
 #include "timeStepper.hpp"
+#include "timer.hpp"
 #include <complex>
 
 namespace libp {
@@ -44,8 +45,7 @@ mrsaab3::mrsaab3(dlong _Nelements, dlong _NhaloElements,
   Nlevels(mesh.mrNlevels),
   Nfields(_Nfields) {
 
-  lambda.malloc(Nfields);
-  lambda.copyFrom(_lambda);
+  relaxation.Setup(Nfields, _lambda);
 
   Nstages = 3;
 
@@ -73,16 +73,18 @@ mrsaab3::mrsaab3(dlong _Nelements, dlong _NhaloElements,
 
   updateKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
                                     "timeStepperMRSAAB.okl",
-                                    "mrsaabUpdate",
+                                    relaxation.dense ? "mrsaabMatrixUpdate" : "mrsaabUpdate",
                                     kernelInfo);
   traceUpdateKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
                                     "timeStepperMRSAAB.okl",
-                                    "mrsaabTraceUpdate",
+                                    relaxation.dense ? "mrsaabMatrixTraceUpdate" : "mrsaabTraceUpdate",
                                     kernelInfo);
 
-  saab_x.malloc(Nlevels*Nfields);
-  saab_a.malloc(Nlevels*Nfields*Nstages*Nstages);
-  saab_b.malloc(Nlevels*Nfields*Nstages*Nstages);
+  const int Nlambda = relaxation.Nlambda;
+
+  saab_x.malloc(Nlevels*Nlambda);
+  saab_a.malloc(Nlevels*Nlambda*Nstages*Nstages);
+  saab_b.malloc(Nlevels*Nlambda*Nstages*Nstages);
 
   h_shiftIndex = platform.hostMalloc<int>(Nlevels);
   o_shiftIndex = platform.malloc<int>(Nlevels);
@@ -90,9 +92,9 @@ mrsaab3::mrsaab3(dlong _Nelements, dlong _NhaloElements,
   mrdt.malloc(Nlevels, 0.0);
   o_mrdt = platform.malloc<dfloat>(mrdt);
 
-  o_saab_x = platform.malloc<dfloat>(Nlevels*Nfields);
-  o_saab_a = platform.malloc<dfloat>(Nlevels*Nfields*Nstages*Nstages);
-  o_saab_b = platform.malloc<dfloat>(Nlevels*Nfields*Nstages*Nstages);
+  o_saab_x = platform.malloc<dfloat>(Nlevels*Nlambda);
+  o_saab_a = platform.malloc<dfloat>(Nlevels*Nlambda*Nstages*Nstages);
+  o_saab_b = platform.malloc<dfloat>(Nlevels*Nlambda*Nstages*Nstages);
 }
 
 void mrsaab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloat end) {
@@ -107,7 +109,9 @@ void mrsaab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfl
   o_mrdt.copyFrom(mrdt);
   h_shiftIndex.copyTo(o_shiftIndex);
 
+  platform.profiler().Tic(profiler_t::Output);
   solver.Report(time,0);
+  platform.profiler().Toc(profiler_t::Output);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -136,18 +140,35 @@ void mrsaab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfl
 
   int tstep=0;
   int order=0;
+  //only a measured cost model compares its prediction with the achieved step time
+  const bool timeSteps = mesh.mrMeasuredCosts;
+  timeSingleRate = timeSteps;
+  singleRateTime = 0.0;
+  double stepTime=0.0;
   while (time < end) {
+    timePoint_t stepStart;
+    if (timeSteps) stepStart = PlatformTime(platform);
+    platform.profiler().Tic(profiler_t::Update);
     Step(solver, o_q, time, dt, order);
+    platform.profiler().Toc(profiler_t::Update);
+    if (timeSteps) stepTime += ElapsedTime(stepStart, PlatformTime(platform));
     time += DT;
     tstep++;
     if (order<Nstages-1) order++;
 
     if (time>outputTime) {
       //report state
+      platform.profiler().Tic(profiler_t::Output);
       solver.Report(outputTime,tstep);
+      platform.profiler().Toc(profiler_t::Output);
       outputTime += outputInterval;
     }
   }
+
+  //each step runs the all-level rhs and update once
+  if (timeSteps && tstep)
+    mesh.MultiRateReport(static_cast<hlong>(tstep)*(1 << (Nlevels-1)), stepTime,
+                         singleRateTime/tstep);
 }
 
 void mrsaab3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloat _dt, int order) {
@@ -164,12 +185,23 @@ void mrsaab3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfl
     for (;lev<Nlevels-1;lev++)
       if (Ntick % (1<<(lev+1)) != 0) break; //find the max lev to compute rhs
 
+    //the all-level rhs and update are the work of a single-rate step
+    const bool timeRhs = timeSingleRate && lev==Nlevels-1;
+    timePoint_t singleRateStart;
+    if (timeRhs) singleRateStart = PlatformTime(platform);
+
     //evaluate ODE rhs = f(q,t)
+    platform.profiler().Tic(profiler_t::Rhs);
     solver.rhsf_MR(o_q, o_rhsq0, o_fQM, currentTime, lev);
+    platform.profiler().Toc(profiler_t::Rhs);
+    if (timeRhs) singleRateTime += ElapsedTime(singleRateStart, PlatformTime(platform));
 
     for (lev=0;lev<Nlevels-1;lev++)
       if ((Ntick+1) % (1<<(lev+1)) !=0) break; //find the max lev to update
 
+    const bool timeUpdate = timeSingleRate && lev==Nlevels-1;
+    if (timeUpdate) singleRateStart = PlatformTime(platform);
+
     // update all elements of level <= lev
     if (mesh.mrNelements[lev])
       updateKernel(mesh.mrNelements[lev],
@@ -186,6 +218,8 @@ void mrsaab3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfl
                    o_fQM,
                    o_q);
 
+    if (timeUpdate) singleRateTime += ElapsedTime(singleRateStart, PlatformTime(platform));
+
     //rotate index
     if (Nstages>2)
       for (int l=0; l<=lev; l++)
@@ -216,113 +250,55 @@ void mrsaab3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfl
 
 void mrsaab3::UpdateCoefficients() {
 
-  const int Nr = 32;
-  complex<dfloat> R[Nr];
-
-  //contour integral integration points
-  for(int ind=1; ind <= Nr; ++ind){
-    const dfloat theta = (dfloat) (ind - 0.5) / (dfloat) Nr;
-    complex<dfloat> z(0., M_PI* theta);
-    R[ind-1] = exp(z);
-  }
+  //exponential, AB, and half-step trace coefficients, computed via contour integral
+  const int Nlambda = relaxation.Nlambda;
+  const int Ncoeffs = 1 + 2*Nstages*Nstages;
+  memory<dfloat> coeffs(Nlambda*Ncoeffs);
 
   for(int lev=0; lev<Nlevels; ++lev){
 
-    for (int n=0;n<Nfields;n++) {
-
-      if (lambda[n]==0) { //Zero exponential term, usual AB coefficients
-
-        dfloat _saab_X[1]  = { 1.0 };
-        dfloat _saab_A[Nstages*Nstages]
-                      = {    1.0,      0.0,    0.0,
-                           3./2.,   -1./2.,    0.0,
-                         23./12., -16./12., 5./12.};
-        dfloat _saab_B[Nstages*Nstages] = {
-                           1./2.,      0.0,    0.0,
-                           5./8.,   -1./8.,    0.0,
-                         17./24.,  -7./24., 2./24.};
-
-        saab_x.copyFrom(_saab_X,               1, n                +lev*Nfields);
-        saab_a.copyFrom(_saab_A, Nstages*Nstages, n*Nstages*Nstages+lev*Nfields*Nstages*Nstages);
-        saab_b.copyFrom(_saab_B, Nstages*Nstages, n*Nstages*Nstages+lev*Nfields*Nstages*Nstages);
-
-      } else {
-
-        //Compute coefficients via contour integral
-        dfloat alpha = lambda[n]*dt*(1<<lev);
-
-        // Initialize complex variables for contour integral
-        complex<double> a11(0.,0.);
-        complex<double> a21(0.,0.);
-        complex<double> a22(0.,0.);
-        complex<double> a31(0.,0.);
-        complex<double> a32(0.,0.);
-        complex<double> a33(0.,0.);
-
-        complex<double> b11(0.,0.);
-        complex<double> b21(0.,0.);
-        complex<double> b22(0.,0.);
-        complex<double> b31(0.,0.);
-        complex<double> b32(0.,0.);
-        complex<double> b33(0.,0.);
-
-        for(int i = 0; i<Nr; ++i ){
-          complex<double> lr = alpha  + R[i];
-
-          a11 +=  (exp(lr) - 1.)/lr;
-          b11 +=  (exp(lr/2.) - 1.)/lr;
-
-          a21 +=  (-2.*lr + (1.+lr)*exp(lr) - 1.)/pow(lr,2);
-          a22 +=  (lr - exp(lr) + 1.)/pow(lr,2);
-          b21 +=  (-1.5*lr + (1.+lr)*exp(lr/2.) - 1.)/pow(lr,2);
-          b22 +=  (0.5*lr - exp(lr/2.) + 1.)/pow(lr,2);
-
-          a31 += (-2.5*lr - 3.*pow(lr,2) + (1.+pow(lr,2)+1.5*lr)*exp(lr) - 1.)/pow(lr,3);
-          a32 += (4.*lr + 3.*pow(lr,2)- (2.*lr + 2.0)*exp(lr) + 2.)/pow(lr,3);
-          a33 +=-(1.5*lr + pow(lr,2)- (0.5*lr + 1.)*exp(lr) + 1.)/pow(lr,3);
-          b31 += (exp(lr/2.)- 2.*lr - (15.*pow(lr,2))/8. + (pow(lr,2) + 1.5*lr)*exp(lr/2.) - 1.)/pow(lr,3);
-          b32 += (3.*lr - 2.*exp(lr/2.0) + 1.25*pow(lr,2) - 2.*lr*exp(lr/2.) + 2.)/pow(lr,3);
-          b33 +=-(lr - exp(lr/2.) + 0.375*pow(lr,2) - 0.5*lr*exp(lr/2.) + 1.)/pow(lr,3);
-        }
-
-
-        dfloat aa11=real(a11)/ (double) Nr;
-        dfloat bb11=real(b11)/ (double) Nr;
-
-        dfloat aa21=real(a21)/ (double) Nr;
-        dfloat aa22=real(a22)/ (double) Nr;
-        dfloat bb21=real(b21)/ (double) Nr;
-        dfloat bb22=real(b22)/ (double) Nr;
-
-        dfloat aa31=real(a31)/ (double) Nr;
-        dfloat aa32=real(a32)/ (double) Nr;
-        dfloat aa33=real(a33)/ (double) Nr;
-
-        dfloat bb31=real(b31)/ (double) Nr;
-        dfloat bb32=real(b32)/ (double) Nr;
-        dfloat bb33=real(b33)/ (double) Nr;
-
-        dfloat _saab_X[1]  = { std::exp(alpha) };
-        dfloat _saab_A[Nstages*Nstages]
-                        ={   aa11,   0.0,   0.0,
-                             aa21,  aa22,   0.0,
-                             aa31,  aa32,  aa33 };
-        dfloat _saab_B[Nstages*Nstages]
-                        ={   bb11,   0.0,   0.0,
-                             bb21,  bb22,   0.0,
-                             bb31,  bb32,  bb33 };
-
-        saab_x.copyFrom(_saab_X,               1, n                +lev*Nfields);
-        saab_a.copyFrom(_saab_A, Nstages*Nstages, n*Nstages*Nstages+lev*Nfields*Nstages*Nstages);
-        saab_b.copyFrom(_saab_B, Nstages*Nstages, n*Nstages*Nstages+lev*Nfields*Nstages*Nstages);
-      }
+    relaxation.Evaluate(dt*(1<<lev), Ncoeffs,
+                        [this](const complex<double> lr, complex<double>* c) {
+      complex<double>* A = c + 1;
+      complex<double>* B = c + 1 + Nstages*Nstages;
+
+      c[0] = exp(lr);
+
+      A[0] =  (exp(lr) - 1.)/lr;
+      A[1] = 0.;
+      A[2] = 0.;
+      B[0] =  (exp(lr/2.) - 1.)/lr;
+      B[1] = 0.;
+      B[2] = 0.;
+
+      A[3] =  (-2.*lr + (1.+lr)*exp(lr) - 1.)/pow(lr,2);
+      A[4] =  (lr - exp(lr) + 1.)/pow(lr,2);
+      A[5] = 0.;
+      B[3] =  (-1.5*lr + (1.+lr)*exp(lr/2.) - 1.)/pow(lr,2);
+      B[4] =  (0.5*lr - exp(lr/2.) + 1.)/pow(lr,2);
+      B[5] = 0.;
+
+      A[6] = (-2.5*lr - 3.*pow(lr,2) + (1.+pow(lr,2)+1.5*lr)*exp(lr) - 1.)/pow(lr,3);
+      A[7] = (4.*lr + 3.*pow(lr,2)- (2.*lr + 2.0)*exp(lr) + 2.)/pow(lr,3);
+      A[8] =-(1.5*lr + pow(lr,2)- (0.5*lr + 1.)*exp(lr) + 1.)/pow(lr,3);
+      B[6] = (exp(lr/2.)- 2.*lr - (15.*pow(lr,2))/8. + (pow(lr,2) + 1.5*lr)*exp(lr/2.) - 1.)/pow(lr,3);
+      B[7] = (3.*lr - 2.*exp(lr/2.0) + 1.25*pow(lr,2) - 2.*lr*exp(lr/2.) + 2.)/pow(lr,3);
+      B[8] =-(lr - exp(lr/2.) + 0.375*pow(lr,2) - 0.5*lr*exp(lr/2.) + 1.)/pow(lr,3);
+    }, coeffs);
+
+    for (int m=0;m<Nlambda;m++) {
+      saab_x[m+lev*Nlambda] = coeffs[m*Ncoeffs];
+      saab_a.copyFrom(coeffs + m*Ncoeffs + 1,
+                      Nstages*Nstages, m*Nstages*Nstages+lev*Nlambda*Nstages*Nstages);
+      saab_b.copyFrom(coeffs + m*Ncoeffs + 1 + Nstages*Nstages,
+                      Nstages*Nstages, m*Nstages*Nstages+lev*Nlambda*Nstages*Nstages);
     }
-
-    // move data to platform
-    o_saab_x.copyFrom(saab_x);
-    o_saab_a.copyFrom(saab_a);
-    o_saab_b.copyFrom(saab_b);
   }
+
+  // move data to platform
+  o_saab_x.copyFrom(saab_x);
+  o_saab_a.copyFrom(saab_a);
+  o_saab_b.copyFrom(saab_b);
 }
 
 /**************************************************/
@@ -403,14 +379,25 @@ void mrsaab3_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time,
     for (;lev<Nlevels-1;lev++)
       if (Ntick % (1<<(lev+1)) != 0) break; //find the max lev to compute rhs
 
+    //the all-level rhs and update are the work of a single-rate step
+    const bool timeRhs = timeSingleRate && lev==Nlevels-1;
+    timePoint_t singleRateStart;
+    if (timeRhs) singleRateStart = PlatformTime(platform);
+
     //evaluate ODE rhs = f(q,t)
+    platform.profiler().Tic(profiler_t::Rhs);
     solver.rhsf_MR_pml(o_q, o_pmlq,
                        o_rhsq0, o_rhspmlq0,
                        o_fQM, currentTime, lev);
+    platform.profiler().Toc(profiler_t::Rhs);
+    if (timeRhs) singleRateTime += ElapsedTime(singleRateStart, PlatformTime(platform));
 
     for (lev=0;lev<Nlevels-1;lev++)
       if ((Ntick+1) % (1<<(lev+1)) !=0) break; //find the max lev to update
 
+    const bool timeUpdate = timeSingleRate && lev==Nlevels-1;
+    if (timeUpdate) singleRateStart = PlatformTime(platform);
+
     // update all elements of level <= lev
     if (mesh.mrNelements[lev])
       updateKernel(mesh.mrNelements[lev],
@@ -441,6 +428,8 @@ void mrsaab3_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time,
                      o_rhspmlq,
                      o_pmlq);
 
+    if (timeUpdate) singleRateTime += ElapsedTime(singleRateStart, PlatformTime(platform));
+
     //rotate index
     if (Nstages>2)
       for (int l=0; l<=lev; l++)
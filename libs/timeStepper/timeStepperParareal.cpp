@@ -0,0 +1,269 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "timeStepper.hpp"
+#include "timer.hpp"
+
+namespace libp {
+
+namespace TimeStepper {
+
+namespace {
+
+//Forwards rhs evaluations to the solver but suppresses its reports, so
+// the propagators can be run over a single time slice
+class sliceSolver_t: public solver_t {
+  solver_t& solver;
+
+public:
+  sliceSolver_t(solver_t& _solver):
+    solver_t(_solver.platform, _solver.settings, _solver.comm),
+    solver(_solver) {
+    //propagators never reach an output time
+    settings.changeSetting("OUTPUT INTERVAL", "1.0e+30");
+  }
+
+  void Report(dfloat time, int tstep) override {}
+
+  dfloat MaxTimeStep(deviceMemory<dfloat>& o_q, const dfloat time) override {
+    return solver.MaxTimeStep(o_q, time);
+  }
+
+  void rhsf(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time) override {
+    solver.rhsf(o_q, o_rhs, time);
+  }
+
+  void rhs_imex_f(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time) override {
+    solver.rhs_imex_f(o_q, o_rhs, time);
+  }
+
+  void rhs_imex_g(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time) override {
+    solver.rhs_imex_g(o_q, o_rhs, time);
+  }
+
+  void rhs_imex_invg(deviceMemory<dfloat>& o_rhs, deviceMemory<dfloat>& o_q, const dfloat gamma, const dfloat time) override {
+    solver.rhs_imex_invg(o_rhs, o_q, gamma, time);
+  }
+
+  void rhs_subcycle_f(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_QHAT,
+                      const dfloat T, const memory<dfloat> dt, const memory<dfloat> B,
+                      const int order, const int shiftIndex, const int maxOrder) override {
+    solver.rhs_subcycle_f(o_Q, o_QHAT, T, dt, B, order, shiftIndex, maxOrder);
+  }
+
+  void rhsf_MR(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, deviceMemory<dfloat>& o_fQM, const dfloat time, const int level) override {
+    solver.rhsf_MR(o_q, o_rhs, o_fQM, time, level);
+  }
+
+  void rhsf_lsrk(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_qnext,
+                 deviceMemory<dfloat>& o_rhs, deviceMemory<dfloat>& o_res,
+                 const dfloat time, const dfloat dt,
+                 const dfloat rka, const dfloat rkb) override {
+    solver.rhsf_lsrk(o_q, o_qnext, o_rhs, o_res, time, dt, rka, rkb);
+  }
+
+  void rhsf_pml(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_pmlq,
+                deviceMemory<dfloat>& o_rhs, deviceMemory<dfloat>& o_pmlrhs, const dfloat time) override {
+    solver.rhsf_pml(o_q, o_pmlq, o_rhs, o_pmlrhs, time);
+  }
+
+  void rhsf_MR_pml(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_pmlq,
+                   deviceMemory<dfloat>& o_rhs, deviceMemory<dfloat>& o_pmlrhs,
+                   deviceMemory<dfloat>& o_fQM, const dfloat time, const int level) override {
+    solver.rhsf_MR_pml(o_q, o_pmlq, o_rhs, o_pmlrhs, o_fQM, time, level);
+  }
+
+  void Operator(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Aq) override {
+    solver.Operator(o_q, o_Aq);
+  }
+};
+
+} //namespace
+
+parareal::parareal(dlong Nelements, dlong NhaloElements,
+                   int Np, int Nfields,
+                   platform_t& _platform, comm_t _comm, comm_t _timeComm,
+                   timeStepper_t& _fine, timeStepper_t& _coarse,
+                   const dfloat _coarseFactor,
+                   const int _maxIterations, const dfloat _tolerance):
+  timeStepperBase_t(Nelements, NhaloElements, Np, Nfields,
+                    _platform, _comm),
+  timeComm(_timeComm),
+  fine(_fine),
+  coarse(_coarse),
+  coarseFactor(_coarseFactor),
+  maxIterations(_maxIterations),
+  tolerance(_tolerance) {
+
+  //a coarse step no larger than the fine one saves nothing
+  LIBP_ABORT("Parareal coarse time step factor must be greater than 1",
+             coarseFactor<=1.0);
+  LIBP_ABORT("Parareal needs at least one iteration",
+             maxIterations<1);
+
+  platform.linAlg().InitKernels({"axpy", "norm2"});
+
+  //propagators step in place, so slice states carry halo space
+  o_U    = platform.malloc<dfloat>(N+Nhalo);
+  o_F    = platform.malloc<dfloat>(N+Nhalo);
+  o_G    = platform.malloc<dfloat>(N+Nhalo);
+  o_Gnew = platform.malloc<dfloat>(N+Nhalo);
+
+  o_Unext = platform.malloc<dfloat>(N);
+
+  h_U.malloc(N);
+}
+
+void parareal::SplitComm(comm_t comm, const int Nslices,
+                         comm_t& spaceComm, comm_t& timeComm) {
+
+  LIBP_ABORT("Number of time slices must be positive",
+             Nslices<1);
+  LIBP_ABORT("Number of ranks (" << comm.size() << ") must be a multiple of the number of time slices (" << Nslices << ")",
+             comm.size()%Nslices);
+
+  const int NspaceRanks = comm.size()/Nslices;
+  const int slice = comm.rank()/NspaceRanks;
+  const int spaceRank = comm.rank()%NspaceRanks;
+
+  spaceComm = comm.Split(slice, spaceRank);
+  timeComm  = comm.Split(spaceRank, slice);
+}
+
+void parareal::Propagate(solver_t& solver, timeStepper_t& stepper,
+                         deviceMemory<dfloat>& o_in, deviceMemory<dfloat>& o_out,
+                         dfloat start, dfloat end) {
+  o_out.copyFrom(o_in, N);
+  stepper.Run(solver, o_out, start, end);
+}
+
+void parareal::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloat end) {
+
+  const int Nslices = timeComm.size();
+  const int slice = timeComm.rank();
+  const bool root = (slice==0 && comm.rank()==0);
+
+  //time interval of this slice
+  const dfloat sliceStart = start + (slice  )*(end-start)/Nslices;
+  const dfloat sliceEnd   = start + (slice+1)*(end-start)/Nslices;
+
+  if (slice==0) solver.Report(start,0);
+
+  fine.SetTimeStep(dt);
+  coarse.SetTimeStep(coarseFactor*dt);
+
+  sliceSolver_t sliceSolver(solver);
+
+  timePoint_t runStart = PlatformTime(platform);
+
+  //initial coarse sweep
+  if (slice==0) {
+    o_U.copyFrom(o_q, N);
+  } else {
+    timeComm.Recv(h_U, slice-1);
+    o_U.copyFrom(h_U, N);
+  }
+
+  Propagate(sliceSolver, coarse, o_U, o_G, sliceStart, sliceEnd);
+  o_Unext.copyFrom(o_G, N);
+
+  if (slice<Nslices-1) {
+    o_Unext.copyTo(h_U, N);
+    timeComm.Send(h_U, slice+1);
+  }
+
+  //the first k slices are exact after k iterations
+  const int Niterations = std::min(maxIterations, Nslices);
+
+  double fineTime = 0.0;
+  int iter=1;
+  for (;iter<=Niterations;++iter) {
+
+    //fine propagation of all slices in parallel
+    timePoint_t fineStart = PlatformTime(platform);
+    Propagate(sliceSolver, fine, o_U, o_F, sliceStart, sliceEnd);
+    timePoint_t fineEnd = PlatformTime(platform);
+    if (iter==1) fineTime = ElapsedTime(fineStart, fineEnd);
+
+    //sequential coarse correction
+    if (slice>0) {
+      timeComm.Recv(h_U, slice-1);
+      o_U.copyFrom(h_U, N);
+    }
+
+    Propagate(sliceSolver, coarse, o_U, o_Gnew, sliceStart, sliceEnd);
+
+    // F = Gnew + F - G
+    platform.linAlg().axpy(N, -1.0, o_G, 1.0, o_F);
+    platform.linAlg().axpy(N,  1.0, o_Gnew, 1.0, o_F);
+
+    //change in the slice end state
+    platform.linAlg().axpy(N, 1.0, o_F, -1.0, o_Unext);
+    dfloat change = platform.linAlg().norm2(N, o_Unext, comm);
+    dfloat norm   = platform.linAlg().norm2(N, o_F, comm);
+
+    o_Unext.copyFrom(o_F, N);
+    std::swap(o_G, o_Gnew);
+
+    if (slice<Nslices-1) {
+      o_Unext.copyTo(h_U, N);
+      timeComm.Send(h_U, slice+1);
+    }
+
+    dfloat update = (norm>0.0) ? change/norm : change;
+    timeComm.Allreduce(update, Comm::Max);
+
+    if (root)
+      printf("Parareal iteration %d, max relative update = %g\n", iter, update);
+
+    if (update<tolerance) break;
+  }
+  iter = std::min(iter, Niterations);
+
+  //the final state lives on the last slice
+  o_Unext.copyTo(h_U, N);
+  timeComm.Bcast(h_U, Nslices-1);
+  o_q.copyFrom(h_U, N);
+
+  timePoint_t runEnd = PlatformTime(platform);
+  double runTime = ElapsedTime(runStart, runEnd);
+  comm.Allreduce(runTime, Comm::Max);
+  timeComm.Allreduce(runTime, Comm::Max);
+
+  //sequential fine stepping would traverse every slice in turn
+  comm.Allreduce(fineTime, Comm::Max);
+  timeComm.Allreduce(fineTime, Comm::Sum);
+
+  if (root) {
+    printf("Parareal: %d slices, %d iterations, %g s (sequential fine estimate %g s, speedup %g)\n",
+           Nslices, iter, runTime, fineTime, fineTime/runTime);
+  }
+}
+
+} //namespace TimeStepper
+
+} //namespace libp
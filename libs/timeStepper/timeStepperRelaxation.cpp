@@ -0,0 +1,183 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "core.hpp"
+#include "timeStepper.hpp"
+#include "linAlg.hpp"
+
+namespace libp {
+
+namespace TimeStepper {
+
+using std::complex;
+
+void relaxation_t::Setup(const int _Nfields, const memory<dfloat> L) {
+
+  Nfields = _Nfields;
+
+  LIBP_ABORT("Relaxation operator must have " << Nfields << " diagonal or "
+             << Nfields*Nfields << " dense entries, got " << L.length(),
+             L.length()!=static_cast<size_t>(Nfields)
+          && L.length()!=static_cast<size_t>(Nfields*Nfields));
+
+  lambda.malloc(Nfields);
+
+  //the form L is given in selects the update kernels
+  dense = (L.length()==static_cast<size_t>(Nfields*Nfields));
+  if (!dense) {
+    lambda.copyFrom(L, Nfields);
+  } else {
+    for (int f=0;f<Nfields;f++) lambda[f] = L[f*Nfields+f];
+  }
+
+  Nlambda = dense ? Nfields*Nfields : Nfields;
+  if (!dense) return;
+
+  //eigendecomposition L = V W V^{-1}
+  memory<dfloat> VR(Nfields*Nfields);
+  memory<dfloat> WR(Nfields), WI(Nfields);
+  linAlg_t::matrixEigenVectors(Nfields, L, VR, WR, WI);
+
+  W.malloc(Nfields);
+  V.malloc(Nfields*Nfields);
+  for (int k=0;k<Nfields;k++) {
+    W[k] = complex<double>(WR[k], WI[k]);
+    if (WI[k]==0.0) {
+      for (int f=0;f<Nfields;f++)
+        V[f*Nfields+k] = complex<double>(VR[f*Nfields+k], 0.0);
+    } else {
+      //complex conjugate pair stored as (real, imaginary) columns
+      for (int f=0;f<Nfields;f++) {
+        V[f*Nfields+k  ] = complex<double>(VR[f*Nfields+k], VR[f*Nfields+k+1]);
+        V[f*Nfields+k+1] = complex<double>(VR[f*Nfields+k],-VR[f*Nfields+k+1]);
+      }
+      W[k+1] = complex<double>(WR[k+1], WI[k+1]);
+      k++;
+    }
+  }
+
+  //invert V by Gauss-Jordan elimination with partial pivoting
+  memory<complex<double>> A(Nfields*Nfields);
+  A.copyFrom(V);
+  invV.malloc(Nfields*Nfields, complex<double>(0.0,0.0));
+  for (int f=0;f<Nfields;f++) invV[f*Nfields+f] = 1.0;
+
+  for (int k=0;k<Nfields;k++) {
+    int piv = k;
+    for (int f=k+1;f<Nfields;f++)
+      if (std::abs(A[f*Nfields+k]) > std::abs(A[piv*Nfields+k])) piv = f;
+
+    LIBP_ABORT("Relaxation matrix is not diagonalizable",
+               std::abs(A[piv*Nfields+k]) < 1.0e-12);
+
+    if (piv!=k) {
+      for (int g=0;g<Nfields;g++) {
+        std::swap(A[k*Nfields+g], A[piv*Nfields+g]);
+        std::swap(invV[k*Nfields+g], invV[piv*Nfields+g]);
+      }
+    }
+
+    const complex<double> invPiv = 1.0/A[k*Nfields+k];
+    for (int g=0;g<Nfields;g++) {
+      A[k*Nfields+g] *= invPiv;
+      invV[k*Nfields+g] *= invPiv;
+    }
+
+    for (int f=0;f<Nfields;f++) {
+      if (f==k) continue;
+      const complex<double> s = A[f*Nfields+k];
+      for (int g=0;g<Nfields;g++) {
+        A[f*Nfields+g] -= s*A[k*Nfields+g];
+        invV[f*Nfields+g] -= s*invV[k*Nfields+g];
+      }
+    }
+  }
+}
+
+void relaxation_t::ContourIntegral(const complex<double> alpha, const int Ncoeffs,
+                                   integrand_t& integrand, complex<double>* c) const {
+
+  const int Nr = 32;
+
+  memory<complex<double>> cr(Ncoeffs);
+  for (int n=0;n<Ncoeffs;n++) c[n] = 0.0;
+
+  if (alpha.imag()==0.0) {
+    //real argument, integrate over the upper half circle and take real part
+    for(int ind=1; ind <= Nr; ++ind){
+      const double theta = (double) (ind - 0.5) / (double) Nr;
+      const complex<double> lr = alpha + std::exp(complex<double>(0., M_PI*theta));
+      integrand(lr, cr.ptr());
+      for (int n=0;n<Ncoeffs;n++) c[n] += cr[n].real();
+    }
+    for (int n=0;n<Ncoeffs;n++) c[n] /= (double) Nr;
+  } else {
+    //complex eigenvalue, integrate over the full circle
+    for(int ind=1; ind <= 2*Nr; ++ind){
+      const double theta = (double) (ind - 0.5) / (double) Nr;
+      const complex<double> lr = alpha + std::exp(complex<double>(0., M_PI*theta));
+      integrand(lr, cr.ptr());
+      for (int n=0;n<Ncoeffs;n++) c[n] += cr[n];
+    }
+    for (int n=0;n<Ncoeffs;n++) c[n] /= (double) (2*Nr);
+  }
+}
+
+void relaxation_t::Evaluate(const dfloat h, const int Ncoeffs,
+                            integrand_t integrand, memory<dfloat> coeffs) const {
+
+  memory<complex<double>> c(Ncoeffs);
+
+  if (!dense) {
+    for (int f=0;f<Nfields;f++) {
+      ContourIntegral(complex<double>(lambda[f]*h, 0.0), Ncoeffs, integrand, c.ptr());
+      for (int n=0;n<Ncoeffs;n++)
+        coeffs[n + f*Ncoeffs] = c[n].real();
+    }
+    return;
+  }
+
+  //phi(hL) = V phi(hW) V^{-1}
+  memory<complex<double>> phi(Nfields*Nfields*Ncoeffs, complex<double>(0.0,0.0));
+  for (int k=0;k<Nfields;k++) {
+    ContourIntegral(W[k]*static_cast<double>(h), Ncoeffs, integrand, c.ptr());
+    for (int f=0;f<Nfields;f++) {
+      for (int g=0;g<Nfields;g++) {
+        const complex<double> vv = V[f*Nfields+k]*invV[k*Nfields+g];
+        for (int n=0;n<Ncoeffs;n++)
+          phi[n + (f*Nfields+g)*Ncoeffs] += vv*c[n];
+      }
+    }
+  }
+
+  for (int m=0;m<Nfields*Nfields*Ncoeffs;m++)
+    coeffs[m] = phi[m].real();
+}
+
+} //namespace TimeStepper
+
+} //namespace libp
@@ -45,8 +45,7 @@ saab3::saab3(dlong _Nelements, dlong _NhaloElements,
   Nelements(_Nelements),
   NhaloElements(_NhaloElements) {
 
-  lambda.malloc(Nfields);
-  lambda.copyFrom(_lambda);
+  relaxation.Setup(Nfields, _lambda);
 
   Nstages = 3;
   shiftIndex = 0;
@@ -64,21 +63,25 @@ saab3::saab3(dlong _Nelements, dlong _NhaloElements,
 
   updateKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
                                     "timeStepperSAAB.okl",
-                                    "saabUpdate",
+                                    relaxation.dense ? "saabMatrixUpdate" : "saabUpdate",
                                     kernelInfo);
 
-  h_saab_x = platform.hostMalloc<dfloat>(Nfields);
-  o_saab_x = platform.malloc<dfloat>(Nfields);
+  const int Nlambda = relaxation.Nlambda;
 
-  h_saab_a = platform.hostMalloc<dfloat>(Nfields*Nstages*Nstages);
-  o_saab_a = platform.malloc<dfloat>(Nfields*Nstages*Nstages);
+  h_saab_x = platform.hostMalloc<dfloat>(Nlambda);
+  o_saab_x = platform.malloc<dfloat>(Nlambda);
+
+  h_saab_a = platform.hostMalloc<dfloat>(Nlambda*Nstages*Nstages);
+  o_saab_a = platform.malloc<dfloat>(Nlambda*Nstages*Nstages);
 }
 
 void saab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloat end) {
 
   dfloat time = start;
 
+  platform.profiler().Tic(profiler_t::Output);
   solver.Report(time,0);
+  platform.profiler().Toc(profiler_t::Output);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -91,14 +94,18 @@ void saab3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloa
   int tstep=0;
   int order=0;
   while (time < end) {
+    platform.profiler().Tic(profiler_t::Update);
     Step(solver, o_q, time, dt, order);
+    platform.profiler().Toc(profiler_t::Update);
     time += dt;
     tstep++;
     if (order<Nstages-1) order++;
 
     if (time>outputTime) {
       //report state
+      platform.profiler().Tic(profiler_t::Output);
       solver.Report(time,tstep);
+      platform.profiler().Toc(profiler_t::Output);
       outputTime += outputInterval;
     }
   }
@@ -114,7 +121,9 @@ void saab3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloa
   deviceMemory<dfloat> o_A = o_saab_a + order*Nstages;
 
   //evaluate ODE rhs = f(q,t)
+  platform.profiler().Tic(profiler_t::Rhs);
   solver.rhsf(o_q, o_rhsq0, time);
+  platform.profiler().Toc(profiler_t::Rhs);
 
   //update q
   updateKernel(Nelements,
@@ -131,79 +140,35 @@ void saab3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloa
 
 void saab3::UpdateCoefficients() {
 
-  const int Nr = 32;
-  complex<dfloat> R[Nr];
-
-  //contour integral integration points
-  for(int ind=1; ind <= Nr; ++ind){
-    const dfloat theta = (dfloat) (ind - 0.5) / (dfloat) Nr;
-    complex<dfloat> z(0., M_PI* theta);
-    R[ind-1] = exp(z);
-  }
-
-  for (int n=0;n<Nfields;n++) {
-
-    if (lambda[n]==0) { //Zero exponential term, usual AB coefficients
-
-      dfloat _saab_X[1]  = { 1.0 };
-      dfloat _saab_A[Nstages*Nstages]
-                    = {    1.0,      0.0,    0.0,
-                         3./2.,   -1./2.,    0.0,
-                       23./12., -16./12., 5./12.};
-
-      h_saab_x.copyFrom(_saab_X,               1, n                );
-      h_saab_a.copyFrom(_saab_A, Nstages*Nstages, n*Nstages*Nstages);
-
-    } else {
-
-      //Compute coefficients via contour integral
-      dfloat alpha = lambda[n]*dt;
+  //exponential and AB coefficients of each order, computed via contour integral
+  const int Ncoeffs = 1 + Nstages*Nstages;
+  memory<dfloat> coeffs(relaxation.Nlambda*Ncoeffs);
 
-      // Initialize complex variables for contour integral
-      complex<double> a11(0.,0.);
-      complex<double> a21(0.,0.);
-      complex<double> a22(0.,0.);
-      complex<double> a31(0.,0.);
-      complex<double> a32(0.,0.);
-      complex<double> a33(0.,0.);
+  relaxation.Evaluate(dt, Ncoeffs,
+                      [](const complex<double> lr, complex<double>* c) {
+    c[0] = exp(lr);
 
-      for(int i = 0; i<Nr; ++i ){
-        complex<double> lr = alpha  + R[i];
+    c[1] = (exp(lr) - 1.)/lr;
+    c[2] = 0.;
+    c[3] = 0.;
 
-        a11 +=  (exp(lr) - 1.)/lr;
+    c[4] = (-2.*lr + (1.+lr)*exp(lr) - 1.)/pow(lr,2);
+    c[5] = (lr - exp(lr) + 1.)/pow(lr,2);
+    c[6] = 0.;
 
-        a21 +=  (-2.*lr + (1.+lr)*exp(lr) - 1.)/pow(lr,2);
-        a22 +=  (lr - exp(lr) + 1.)/pow(lr,2);
+    c[7] = (-2.5*lr - 3.*pow(lr,2) + (1.+pow(lr,2)+1.5*lr)*exp(lr) - 1.)/pow(lr,3);
+    c[8] = (4.*lr + 3.*pow(lr,2)- (2.*lr + 2.0)*exp(lr) + 2.)/pow(lr,3);
+    c[9] =-(1.5*lr + pow(lr,2)- (0.5*lr + 1.)*exp(lr) + 1.)/pow(lr,3);
+  }, coeffs);
 
-        a31 += (-2.5*lr - 3.*pow(lr,2) + (1.+pow(lr,2)+1.5*lr)*exp(lr) - 1.)/pow(lr,3);
-        a32 += (4.*lr + 3.*pow(lr,2)- (2.*lr + 2.0)*exp(lr) + 2.)/pow(lr,3);
-        a33 +=-(1.5*lr + pow(lr,2)- (0.5*lr + 1.)*exp(lr) + 1.)/pow(lr,3);
-      }
-
-
-      dfloat aa11=real(a11)/ (double) Nr;
-
-      dfloat aa21=real(a21)/ (double) Nr;
-      dfloat aa22=real(a22)/ (double) Nr;
-
-      dfloat aa31=real(a31)/ (double) Nr;
-      dfloat aa32=real(a32)/ (double) Nr;
-      dfloat aa33=real(a33)/ (double) Nr;
-
-      dfloat _saab_X[1]  = { std::exp(alpha) };
-      dfloat _saab_A[Nstages*Nstages]
-                      ={   aa11,   0.0,   0.0,
-                           aa21,  aa22,   0.0,
-                           aa31,  aa32,  aa33 };
-
-      h_saab_x.copyFrom(_saab_X,               1, n                );
-      h_saab_a.copyFrom(_saab_A, Nstages*Nstages, n*Nstages*Nstages);
-    }
-
-    // move data to platform
-    h_saab_x.copyTo(o_saab_x);
-    h_saab_a.copyTo(o_saab_a);
+  for (int m=0;m<relaxation.Nlambda;m++) {
+    h_saab_x[m] = coeffs[m*Ncoeffs];
+    h_saab_a.copyFrom(coeffs + m*Ncoeffs + 1, Nstages*Nstages, m*Nstages*Nstages);
   }
+
+  // move data to platform
+  h_saab_x.copyTo(o_saab_x);
+  h_saab_a.copyTo(o_saab_a);
 }
 
 
@@ -270,7 +235,9 @@ void saab3_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, d
   }
 
   //evaluate ODE rhs = f(q,t)
+  platform.profiler().Tic(profiler_t::Rhs);
   solver.rhsf_pml(o_q, o_pmlq, o_rhsq0, o_rhspmlq0, time);
+  platform.profiler().Toc(profiler_t::Rhs);
 
   //update q
   updateKernel(Nelements,
@@ -46,8 +46,7 @@ sark4::sark4(dlong _Nelements, dlong _NhaloElements,
   Nelements(_Nelements),
   NhaloElements(_NhaloElements) {
 
-  lambda.malloc(Nfields);
-  lambda.copyFrom(_lambda);
+  relaxation.Setup(Nfields, _lambda);
 
   Nrk = 5;
   order = 4;
@@ -83,12 +82,12 @@ sark4::sark4(dlong _Nelements, dlong _NhaloElements,
 
   rkUpdateKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
                                     "timeStepperSARK.okl",
-                                    "sarkRkUpdate",
+                                    relaxation.dense ? "sarkRkMatrixUpdate" : "sarkRkUpdate",
                                     kernelInfo);
 
   rkStageKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
                                     "timeStepperSARK.okl",
-                                    "sarkRkStage",
+                                    relaxation.dense ? "sarkRkMatrixStage" : "sarkRkStage",
                                     kernelInfo);
 
   rkErrorEstimateKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
@@ -101,13 +100,15 @@ sark4::sark4(dlong _Nelements, dlong _NhaloElements,
   rkC.malloc(Nrk);
   rkC.copyFrom(_rkC);
 
-  h_rkX = platform.hostMalloc<dfloat>(Nfields*Nrk);
-  h_rkA = platform.hostMalloc<dfloat>(Nfields*Nrk*Nrk);
-  h_rkE = platform.hostMalloc<dfloat>(Nfields*Nrk);
+  const int Nlambda = relaxation.Nlambda;
 
-  o_rkX = platform.malloc<dfloat>(Nfields*Nrk);
-  o_rkA = platform.malloc<dfloat>(Nfields*Nrk*Nrk);
-  o_rkE = platform.malloc<dfloat>(Nfields*Nrk);
+  h_rkX = platform.hostMalloc<dfloat>(Nlambda*Nrk);
+  h_rkA = platform.hostMalloc<dfloat>(Nlambda*Nrk*Nrk);
+  h_rkE = platform.hostMalloc<dfloat>(Nlambda*Nrk);
+
+  o_rkX = platform.malloc<dfloat>(Nlambda*Nrk);
+  o_rkA = platform.malloc<dfloat>(Nlambda*Nrk*Nrk);
+  o_rkE = platform.malloc<dfloat>(Nlambda*Nrk);
 
   dtMIN = 1E-9; //minumum allowed timestep
   ATOL = 1E-5;  //absolute error tolerance
@@ -132,7 +133,9 @@ void sark4::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloa
 
   int rank = comm.rank();
 
+  platform.profiler().Tic(profiler_t::Output);
   solver.Report(time,0);
+  platform.profiler().Toc(profiler_t::Output);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -156,7 +159,9 @@ void sark4::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloa
       dt = end-time;
     }
 
+    platform.profiler().Tic(profiler_t::Update);
     Step(solver, o_q, time, dt);
+    platform.profiler().Toc(profiler_t::Update);
 
     // compute Dopri estimator
     dfloat err = Estimater(o_q);
@@ -187,14 +192,18 @@ void sark4::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloa
         UpdateCoefficients();
 
         // time step to output
+        platform.profiler().Tic(profiler_t::Update);
         Step(solver, o_q, time, dt);
+        platform.profiler().Toc(profiler_t::Update);
 
         // shift for output
         o_rkq.copyTo(o_q);
 
         // output  (print from rkq)
         // if (!rank) printf("\n");
+        platform.profiler().Tic(profiler_t::Output);
         solver.Report(outputTime,tstep);
+        platform.profiler().Toc(profiler_t::Output);
 
         // restore time step
         dt = savedt;
@@ -273,7 +282,9 @@ void sark4::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloa
                   o_rkq);
 
     //evaluate ODE rhs = f(q,t)
+    platform.profiler().Tic(profiler_t::Rhs);
     solver.rhsf(o_rkq, o_rhsq, currentTime);
+    platform.profiler().Toc(profiler_t::Rhs);
 
     // update solution using Runge-Kutta
     // rkrhsq_rk = rhsq
@@ -321,107 +332,54 @@ dfloat sark4::Estimater(deviceMemory<dfloat>& o_q){
 
 void sark4::UpdateCoefficients() {
 
-  const int Nr = 32;
-  complex<dfloat> R[Nr];
-
-  //contour integral integration points
-  for(int ind=1; ind <= Nr; ++ind){
-    const dfloat theta = (dfloat) (ind - 0.5) / (dfloat) Nr;
-    complex<dfloat> z(0., M_PI* theta);
-    R[ind-1] = exp(z);
-  }
-
-  for (int n=0;n<Nfields;n++) {
-
-    if (lambda[n]==0) { //Zero exponential term, usual RK coefficients
-
-      dfloat _rkX[Nrk]  = {1.0, 1.0, 1.0, 1.0, 1.0 };
-      dfloat _rkA[Nrk*Nrk]
-                    = {      0.0,      0.0,       0.0,      0.0,       0.0,
-                             0.5,      0.0,       0.0,      0.0,       0.0,
-                             0.0,      0.5,       0.0,      0.0,       0.0,
-                             0.0,      0.0,       1.0,      0.0,       0.0,
-                         1.0/6.0,  1.0/3.0,   1.0/3.0,   1.0/6.0,      0.0};
-      dfloat _rkE[Nrk]= {    0.0,      0.0,       0.0,  -1.0/6.0,  1.0/6.0};
-
-      h_rkX.copyFrom(_rkX,    Nrk,n*Nrk    );
-      h_rkA.copyFrom(_rkA,Nrk*Nrk,n*Nrk*Nrk);
-      h_rkE.copyFrom(_rkE,    Nrk,n*Nrk    );
+  //exponential, stage, and error coefficients, computed via contour integral
+  const int Ncoeffs = Nrk + Nrk*Nrk + Nrk;
+  memory<dfloat> coeffs(relaxation.Nlambda*Ncoeffs);
 
-    } else {
+  relaxation.Evaluate(dt, Ncoeffs,
+                      [this](const complex<double> lr, complex<double>* c) {
+    complex<double>* X = c;
+    complex<double>* A = c + Nrk;
+    complex<double>* E = c + Nrk + Nrk*Nrk;
 
-      //Compute RK coefficients via contour integral
-      dfloat alpha = lambda[n]*dt;
+    for (int n=0;n<Nrk*Nrk;n++) A[n] = 0.;
 
-      // Initialize complex variables for contour integral
-      complex<double> ca21(0.,0.);
-      complex<double> ca31(0.,0.);
-      complex<double> ca32(0.,0.);
-      complex<double> ca41(0.,0.);
-      complex<double> ca43(0.,0.);
-      complex<double> ca51(0.,0.);
-      complex<double> ca52(0.,0.);
-      complex<double> ca53(0.,0.);
-      complex<double> ca54(0.,0.);
+    X[0] = 1.0;
+    X[1] = exp(lr/2.);
+    X[2] = exp(lr/2.);
+    X[3] = exp(lr);
+    X[4] = exp(lr);
 
-      for(int i = 0; i<Nr; ++i ){
-        complex<double> lr = alpha  + R[i];
+    A[1*Nrk+0] = (exp(lr/2.) - 1.)/lr;
 
-        ca21 +=  (exp(lr/2.) - 1.)/lr;
+    A[2*Nrk+0] = (4. + exp(lr/2.)*(-4. + lr) + lr)/pow(lr,2);
+    A[2*Nrk+1] = (4.*exp(lr/2.) -2.*lr -4.)/pow(lr,2);
 
-        ca31 +=  (4. + exp(lr/2.)*(-4. + lr) + lr)/pow(lr,2);
-        ca32 +=  (4.*exp(lr/2.) -2.*lr -4.)/pow(lr,2);
+    A[3*Nrk+0] = ((exp(lr) + 1.)*lr + 2. - 2.*exp(lr))/pow(lr,2);
+    A[3*Nrk+2] = (2.*exp(lr) - 2.*lr - 2.)/pow(lr,2);
 
-        ca41 +=  ((exp(lr) + 1.)*lr + 2. - 2.*exp(lr))/pow(lr,2);
-        ca43 +=  (2.*exp(lr) - 2.*lr - 2.)/pow(lr,2);
+    A[4*Nrk+0] = (exp(lr)*pow(lr,2) + (- 3.*exp(lr) - 1.)*lr + 4.*exp(lr) - 4.)/pow(lr,3);
+    A[4*Nrk+1] = ((2.*exp(lr) + 2.)*lr + 4. - 4.*exp(lr))/pow(lr,3);
+    A[4*Nrk+2] = ((2.*exp(lr) + 2.)*lr + 4. - 4.*exp(lr))/pow(lr,3);
+    A[4*Nrk+3] = ((-exp(lr) - 3.)*lr - pow(lr,2) + 4.*exp(lr) - 4.)/pow(lr,3);
 
-        ca51 +=  (exp(lr)*pow(lr,2) + (- 3.*exp(lr) - 1.)*lr + 4.*exp(lr) - 4.)/pow(lr,3);
-        ca52 +=  ((2.*exp(lr) + 2.)*lr + 4. - 4.*exp(lr))/pow(lr,3);
-        ca53 +=  ((2.*exp(lr) + 2.)*lr + 4. - 4.*exp(lr))/pow(lr,3);
-        ca54 +=  ((-exp(lr) - 3.)*lr - pow(lr,2) + 4.*exp(lr) - 4.)/pow(lr,3);
-      }
+    E[0] = 0.;
+    E[1] = 0.;
+    E[2] = 0.;
+    E[3] = -A[4*Nrk+3];
+    E[4] =  A[4*Nrk+3];
+  }, coeffs);
 
-
-      dfloat a21=real(ca21)/ (double) Nr;
-
-      dfloat a31=real(ca31)/ (double) Nr;
-      dfloat a32=real(ca32)/ (double) Nr;
-
-      dfloat a41=real(ca41)/ (double) Nr;
-      dfloat a43=real(ca43)/ (double) Nr;
-
-      dfloat a51=real(ca51)/ (double) Nr;
-      dfloat a52=real(ca52)/ (double) Nr;
-      dfloat a53=real(ca53)/ (double) Nr;
-      dfloat a54=real(ca54)/ (double) Nr;
-
-      // first set non-semianalytic part of the integrator
-      dfloat _rkX[Nrk]  = {1.0,
-                           std::exp(dfloat(0.5)*alpha),
-                           std::exp(dfloat(0.5)*alpha),
-                           std::exp(alpha),
-                           std::exp(alpha) };
-      dfloat _rkA[Nrk*Nrk]
-                      ={   0.0,  0.0,  0.0,   0.0,  0.0,
-                           a21,  0.0,  0.0,   0.0,  0.0,
-                           a31,  a32,  0.0,   0.0,  0.0,
-                           a41,  0.0,  a43,   0.0,  0.0,
-                           a51,  a52,  a53,   a54,  0.0};
-      dfloat _rkE[Nrk]= {  0.0,  0.0,  0.0,  -a54,  a54};
-
-      h_rkX.copyFrom(_rkX,    Nrk,n*Nrk    );
-      h_rkA.copyFrom(_rkA,Nrk*Nrk,n*Nrk*Nrk);
-      h_rkE.copyFrom(_rkE,    Nrk,n*Nrk    );
-    }
-
-    // move data to platform
-    // o_rkX.copyFrom(rkX, properties_t("async", true));
-    // o_rkA.copyFrom(rkA, properties_t("async", true));
-    // o_rkE.copyFrom(rkE, properties_t("async", true));
-    h_rkX.copyTo(o_rkX);
-    h_rkA.copyTo(o_rkA);
-    h_rkE.copyTo(o_rkE);
+  for (int m=0;m<relaxation.Nlambda;m++) {
+    h_rkX.copyFrom(coeffs + m*Ncoeffs,               Nrk, m*Nrk    );
+    h_rkA.copyFrom(coeffs + m*Ncoeffs + Nrk,     Nrk*Nrk, m*Nrk*Nrk);
+    h_rkE.copyFrom(coeffs + m*Ncoeffs + Nrk+Nrk*Nrk, Nrk, m*Nrk    );
   }
+
+  // move data to platform
+  h_rkX.copyTo(o_rkX);
+  h_rkA.copyTo(o_rkA);
+  h_rkE.copyTo(o_rkE);
 }
 
 
@@ -529,7 +487,9 @@ void sark4_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, d
                       o_rkpmlq);
 
     //evaluate ODE rhs = f(q,t)
+    platform.profiler().Tic(profiler_t::Rhs);
     solver.rhsf_pml(o_rkq, o_rkpmlq, o_rhsq, o_rhspmlq, currentTime);
+    platform.profiler().Toc(profiler_t::Rhs);
 
     // update solution using Runge-Kutta
     // rkrhsq_rk = rhsq
@@ -46,8 +46,7 @@ sark5::sark5(dlong _Nelements, dlong _NhaloElements,
   Nelements(_Nelements),
   NhaloElements(_NhaloElements) {
 
-  lambda.malloc(Nfields);
-  lambda.copyFrom(_lambda);
+  relaxation.Setup(Nfields, _lambda);
 
   Nrk = 7; //number of stages
   order = 5;
@@ -82,12 +81,12 @@ sark5::sark5(dlong _Nelements, dlong _NhaloElements,
 
   rkUpdateKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
                                     "timeStepperSARK.okl",
-                                    "sarkRkUpdate",
+                                    relaxation.dense ? "sarkRkMatrixUpdate" : "sarkRkUpdate",
                                     kernelInfo);
 
   rkStageKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
                                     "timeStepperSARK.okl",
-                                    "sarkRkStage",
+                                    relaxation.dense ? "sarkRkMatrixStage" : "sarkRkStage",
                                     kernelInfo);
 
   rkErrorEstimateKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
@@ -100,13 +99,15 @@ sark5::sark5(dlong _Nelements, dlong _NhaloElements,
   rkC.malloc(Nrk);
   rkC.copyFrom(_rkC);
 
-  h_rkX = platform.hostMalloc<dfloat>(Nfields*Nrk);
-  h_rkA = platform.hostMalloc<dfloat>(Nfields*Nrk*Nrk);
-  h_rkE = platform.hostMalloc<dfloat>(Nfields*Nrk);
+  const int Nlambda = relaxation.Nlambda;
 
-  o_rkX = platform.malloc<dfloat>(Nfields*Nrk);
-  o_rkA = platform.malloc<dfloat>(Nfields*Nrk*Nrk);
-  o_rkE = platform.malloc<dfloat>(Nfields*Nrk);
+  h_rkX = platform.hostMalloc<dfloat>(Nlambda*Nrk);
+  h_rkA = platform.hostMalloc<dfloat>(Nlambda*Nrk*Nrk);
+  h_rkE = platform.hostMalloc<dfloat>(Nlambda*Nrk);
+
+  o_rkX = platform.malloc<dfloat>(Nlambda*Nrk);
+  o_rkA = platform.malloc<dfloat>(Nlambda*Nrk*Nrk);
+  o_rkE = platform.malloc<dfloat>(Nlambda*Nrk);
 
   dtMIN = 1E-9; //minumum allowed timestep
   ATOL = 1E-5;  //absolute error tolerance
@@ -131,7 +132,9 @@ void sark5::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloa
 
   int rank = comm.rank();
 
+  platform.profiler().Tic(profiler_t::Output);
   solver.Report(time,0);
+  platform.profiler().Toc(profiler_t::Output);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -155,7 +158,9 @@ void sark5::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloa
       dt = end-time;
     }
 
+    platform.profiler().Tic(profiler_t::Update);
     Step(solver, o_q, time, dt);
+    platform.profiler().Toc(profiler_t::Update);
 
     // compute Dopri estimator
     dfloat err = Estimater(o_q);
@@ -186,14 +191,18 @@ void sark5::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dfloa
         UpdateCoefficients();
 
         // time step to output
+        platform.profiler().Tic(profiler_t::Update);
         Step(solver, o_q, time, dt);
+        platform.profiler().Toc(profiler_t::Update);
 
         // shift for output
         o_rkq.copyTo(o_q);
 
         // output  (print from rkq)
         // if (!rank) printf("\n");
+        platform.profiler().Tic(profiler_t::Output);
         solver.Report(outputTime,tstep);
+        platform.profiler().Toc(profiler_t::Output);
 
         // restore time step
         dt = savedt;
@@ -272,7 +281,9 @@ void sark5::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dfloa
                   o_rkq);
 
     //evaluate ODE rhs = f(q,t)
+    platform.profiler().Tic(profiler_t::Rhs);
     solver.rhsf(o_rkq, o_rhsq, currentTime);
+    platform.profiler().Toc(profiler_t::Rhs);
 
     // update solution using Runge-Kutta
     // rkrhsq_rk = rhsq
@@ -320,166 +331,70 @@ dfloat sark5::Estimater(deviceMemory<dfloat>& o_q){
 
 void sark5::UpdateCoefficients() {
 
-  const int Nr = 32;
-  complex<dfloat> R[Nr];
-
-  //contour integral integration points
-  for(int ind=1; ind <= Nr; ++ind){
-    const dfloat theta = (dfloat) (ind - 0.5) / (dfloat) Nr;
-    complex<dfloat> z(0., M_PI* theta);
-    R[ind-1] = exp(z);
+  //exponential, stage, and error coefficients, computed via contour integral
+  const int Ncoeffs = Nrk + Nrk*Nrk + Nrk;
+  memory<dfloat> coeffs(relaxation.Nlambda*Ncoeffs);
+
+  relaxation.Evaluate(dt, Ncoeffs,
+                      [this](const complex<double> lr, complex<double>* c) {
+    complex<double>* X = c;
+    complex<double>* A = c + Nrk;
+    complex<double>* E = c + Nrk + Nrk*Nrk;
+
+    for (int n=0;n<Nrk*Nrk;n++) A[n] = 0.;
+
+    X[0] = 1.0;
+    X[1] = exp(lr/4.);
+    X[2] = exp(lr/4.);
+    X[3] = exp(lr/2.);
+    X[4] = exp((3.*lr)/4.);
+    X[5] = exp(lr);
+    X[6] = exp(lr);
+
+    A[1*Nrk+0] =  (exp(lr/4.) - 1.)/lr;
+
+    A[2*Nrk+0] =  (exp(lr/4.)*lr + 4. - 4.*exp(lr/4.))/pow(lr,2);
+    A[2*Nrk+1] =  (4.*exp(lr/4.) - lr - 4.)/pow(lr,2);
+
+    A[3*Nrk+0] =  ((exp(lr/2.) + 1.)*lr + 4. - 4.*exp(lr/2.))/pow(lr,2);
+    A[3*Nrk+2] =  (4.*exp(lr/2.) - 2.*lr - 4.)/pow(lr,2);
+
+    A[4*Nrk+0] =  ((2.*exp((3.*lr)/4.) + 1.)*lr + 4. - 4.*exp((3.*lr)/4.))/(2.*pow(lr,2));
+    A[4*Nrk+1] =   -(exp((3.*lr)/4.) - 1.)/(2.*lr);
+    A[4*Nrk+2] =  (exp((3.*lr)/4.) - 1.)/(2.*lr);
+    A[4*Nrk+3] =  (4.*exp((3.*lr)/4.) - 3.*lr - 4.)/(2.*pow(lr,2));
+
+    A[5*Nrk+0] =  ((- 77.*exp(lr) - 41.)*lr + 118.*exp(lr) - 118.)/(42.*pow(lr,2));
+    A[5*Nrk+1] =  (8.*exp(lr) - 8.)/(7.*lr);
+    A[5*Nrk+2] =  ((111.*exp(lr) + 63.)*lr + 174. - 174.*exp(lr))/(28.*pow(lr,2));
+    A[5*Nrk+3] = -(12.*exp(lr) - 12.)/(7.*lr);
+    A[5*Nrk+4] =  ((- 47.*exp(lr) - 239.)*lr + 286.*exp(lr) - 286.)/(84.*pow(lr,2));
+
+    A[6*Nrk+0] =  ((1799.*exp(lr) - 511.)*pow(lr,2) + (- 6958.*exp(lr) - 4382.)*lr + 11340.*exp(lr) - 11340.)/(2700.*pow(lr,3));
+    A[6*Nrk+2] =  ((1097.*exp(lr) + 287.)*pow(lr,2) + (1834. - 934.*exp(lr))*lr + 900. - 900.*exp(lr))/(1350.*pow(lr,3));
+    A[6*Nrk+3] =  ((112. - 98.*exp(lr))*pow(lr,2) + (796.*exp(lr) + 824.)*lr + 1620. - 1620.*exp(lr))/(225.*pow(lr,3));
+    A[6*Nrk+4] =  ((- 313.*exp(lr) - 1183.)*pow(lr,2) + (1766.*exp(lr) - 1226.)*lr + 540. - 540.*exp(lr))/(1350.*pow(lr,3));
+    A[6*Nrk+5] =  ((509.*exp(lr) - 1741.)*pow(lr,2) + (- 4258.*exp(lr) - 6722.)*lr + 10980.*exp(lr) - 10980.)/(2700.*pow(lr,3));
+
+    E[0] =  ((313.*exp(lr) + 1183.)*pow(lr,2) + (1226. - 1766.*exp(lr))*lr + 540.*exp(lr) - 540.)/(5400.*pow(lr,3));
+    E[1] = 0.;
+    E[2] =  ((- 313.*exp(lr) - 1183.)*pow(lr,2) + (1766.*exp(lr) - 1226.)*lr + 540. - 540.*exp(lr))/(1350.*pow(lr,3));
+    E[3] =  ((313.*exp(lr) + 1183.)*pow(lr,2) + (1226. - 1766.*exp(lr))*lr + 540.*exp(lr) - 540.)/(900.*pow(lr,3));
+    E[4] =  A[6*Nrk+4];
+    E[5] =  ((313.*exp(lr) + 1183.)*pow(lr,2) + (1226. - 1766.*exp(lr))*lr + 540.*exp(lr) - 540.)/(5400.*pow(lr,3));
+    E[6] = 0.;
+  }, coeffs);
+
+  for (int m=0;m<relaxation.Nlambda;m++) {
+    h_rkX.copyFrom(coeffs + m*Ncoeffs,               Nrk, m*Nrk    );
+    h_rkA.copyFrom(coeffs + m*Ncoeffs + Nrk,     Nrk*Nrk, m*Nrk*Nrk);
+    h_rkE.copyFrom(coeffs + m*Ncoeffs + Nrk+Nrk*Nrk, Nrk, m*Nrk    );
   }
 
-  for (int n=0;n<Nfields;n++) {
-
-    if (lambda[n]==0) { //Zero exponential term, usual RK coefficients
-
-      dfloat _rkX[Nrk]   = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
-      dfloat _rkA[Nrk*Nrk]  =  {     0,      0,       0,       0,       0,      0,   0,
-                                   1/4,      0,       0,       0,       0,      0,   0,
-                                   1/8,    1/8,       0,       0,       0,      0,   0,
-                                     0,      0,     1/2,       0,       0,      0,   0,
-                                3./16., -3./8.,   3./8.,  9./16.,       0,      0,   0,
-                                -3./7.,  8./7.,   6./7., -12./7.,   8./7.,      0,   0,
-                                7./90.,     0., 16./45.,  2./15., 16./45., 7./90.,   0};
-
-      dfloat _rkE[Nrk]=  {-4./45., 0, 16./45., -8./15., 16./45., -4./45., 0.};
-
-      h_rkX.copyFrom(_rkX,    Nrk,n*Nrk    );
-      h_rkA.copyFrom(_rkA,Nrk*Nrk,n*Nrk*Nrk);
-      h_rkE.copyFrom(_rkE,    Nrk,n*Nrk    );
-
-    } else {
-
-      //Compute RK coefficients via contour integral
-      dfloat alpha = lambda[n]*dt;
-
-      // Initialize complex variables for contour integral
-      complex<double> ca21(0., 0.);
-      complex<double> ca31(0., 0.);
-      complex<double> ca32(0., 0.);
-      complex<double> ca41(0., 0.);
-      complex<double> ca43(0., 0.);
-      complex<double> ca51(0., 0.);
-      complex<double> ca52(0., 0.);
-      complex<double> ca53(0., 0.);
-      complex<double> ca54(0., 0.);
-      complex<double> ca61(0., 0.);
-      complex<double> ca62(0., 0.);
-      complex<double> ca63(0., 0.);
-      complex<double> ca64(0., 0.);
-      complex<double> ca65(0., 0.);
-      complex<double> ca71(0., 0.);
-      complex<double> ca73(0., 0.);
-      complex<double> ca74(0., 0.);
-      complex<double> ca75(0., 0.);
-      complex<double> ca76(0., 0.);
-      complex<double> cb1 (0., 0.);
-      complex<double> cb3 (0., 0.);
-      complex<double> cb4 (0., 0.);
-      complex<double> cb6 (0., 0.);
-
-      for(int i = 0; i<Nr; ++i ){
-        complex<double> lr = alpha  + R[i];
-
-        ca21 +=  (exp(lr/4.) - 1.)/lr;
-
-        ca31 +=  (exp(lr/4.)*lr + 4. - 4.*exp(lr/4.))/pow(lr,2);
-        ca32 +=  (4.*exp(lr/4.) - lr - 4.)/pow(lr,2);
-
-        ca41 +=  ((exp(lr/2.) + 1.)*lr + 4. - 4.*exp(lr/2.))/pow(lr,2);
-        ca43 +=  (4.*exp(lr/2.) - 2.*lr - 4.)/pow(lr,2);
-
-        ca51 +=  ((2.*exp((3.*lr)/4.) + 1.)*lr + 4. - 4.*exp((3.*lr)/4.))/(2.*pow(lr,2));
-        ca52 +=   -(exp((3.*lr)/4.) - 1.)/(2.*lr);
-        ca53 +=  (exp((3.*lr)/4.) - 1.)/(2.*lr);
-        ca54 +=  (4.*exp((3.*lr)/4.) - 3.*lr - 4.)/(2.*pow(lr,2));
-
-
-        ca61 +=  ((- 77.*exp(lr) - 41.)*lr + 118.*exp(lr) - 118.)/(42.*pow(lr,2));
-        ca62 +=  (8.*exp(lr) - 8.)/(7.*lr);
-        ca63 +=  ((111.*exp(lr) + 63.)*lr + 174. - 174.*exp(lr))/(28.*pow(lr,2));
-        ca64 += -(12.*exp(lr) - 12.)/(7.*lr);
-        ca65 +=  ((- 47.*exp(lr) - 239.)*lr + 286.*exp(lr) - 286.)/(84.*pow(lr,2));
-
-
-        ca71 +=  ((1799.*exp(lr) - 511.)*pow(lr,2) + (- 6958.*exp(lr) - 4382.)*lr + 11340.*exp(lr) - 11340.)/(2700.*pow(lr,3));
-        // ca72 +=  (8.*exp(lr) - 8.)/(7.*lr);
-        ca73 +=  ((1097.*exp(lr) + 287.)*pow(lr,2) + (1834. - 934.*exp(lr))*lr + 900. - 900.*exp(lr))/(1350.*pow(lr,3));
-        ca74 +=  ((112. - 98.*exp(lr))*pow(lr,2) + (796.*exp(lr) + 824.)*lr + 1620. - 1620.*exp(lr))/(225.*pow(lr,3));
-        ca75 +=  ((- 313.*exp(lr) - 1183.)*pow(lr,2) + (1766.*exp(lr) - 1226.)*lr + 540. - 540.*exp(lr))/(1350.*pow(lr,3));
-        ca76 +=  ((509.*exp(lr) - 1741.)*pow(lr,2) + (- 4258.*exp(lr) - 6722.)*lr + 10980.*exp(lr) - 10980.)/(2700.*pow(lr,3));
-
-
-        cb1 +=  ((313.*exp(lr) + 1183.)*pow(lr,2) + (1226. - 1766.*exp(lr))*lr + 540.*exp(lr) - 540.)/(5400.*pow(lr,3));
-        // cb2 +=  (8.*exp(lr) - 8.)/(7.*lr);
-        cb3 +=  ((- 313.*exp(lr) - 1183.)*pow(lr,2) + (1766.*exp(lr) - 1226.)*lr + 540. - 540.*exp(lr))/(1350.*pow(lr,3));
-
-        cb4 +=  ((313.*exp(lr) + 1183.)*pow(lr,2) + (1226. - 1766.*exp(lr))*lr + 540.*exp(lr) - 540.)/(900.*pow(lr,3));
-        // cb5 +=  ((- 313.*exp(lr) - 1183.)*pow(lr,2) + (1766.*exp(lr) - 1226.)*lr + 540. - 540.*exp(lr))/(1350.*pow(lr,3));
-        cb6 += ((313.*exp(lr) + 1183.)*pow(lr,2) + (1226. - 1766.*exp(lr))*lr + 540.*exp(lr) - 540.)/(5400.*pow(lr,3));
-      }
-
-      dfloat a21=real(ca21)/ (double) Nr;
-
-      dfloat a31=real(ca31)/ (double) Nr;
-      dfloat a32=real(ca32)/ (double) Nr;
-
-      dfloat a41=real(ca41)/ (double) Nr;
-      dfloat a43=real(ca43)/ (double) Nr;
-
-      dfloat a51=real(ca51)/ (double) Nr;
-      dfloat a52=real(ca52)/ (double) Nr;
-      dfloat a53=real(ca53)/ (double) Nr;
-      dfloat a54=real(ca54)/ (double) Nr;
-
-      dfloat a61=real(ca61)/ (double) Nr;
-      dfloat a62=real(ca62)/ (double) Nr;
-      dfloat a63=real(ca63)/ (double) Nr;
-      dfloat a64=real(ca64)/ (double) Nr;
-      dfloat a65=real(ca65)/ (double) Nr;
-
-      dfloat a71=real(ca71)/ (double) Nr;
-      dfloat a73=real(ca73)/ (double) Nr;
-      dfloat a74=real(ca74)/ (double) Nr;
-      dfloat a75=real(ca75)/ (double) Nr;
-      dfloat a76=real(ca76)/ (double) Nr;
-
-      dfloat b1=real(cb1)/ (double) Nr;
-      dfloat b3=real(cb3)/ (double) Nr;
-      dfloat b4=real(cb4)/ (double) Nr;
-      dfloat b6=real(cb6)/ (double) Nr;
-
-      dfloat _rkX[Nrk]  = {1.0,
-                           std::exp(dfloat(0.25)*alpha),
-                           std::exp(dfloat(0.25)*alpha),
-                           std::exp(dfloat(0.5)*alpha),
-                           std::exp(dfloat(0.75)*alpha),
-                           std::exp(alpha),
-                           std::exp(alpha)};
-      dfloat _rkA[Nrk*Nrk]={   0,   0,     0,     0,     0,    0,   0,
-                             a21,   0,     0,     0,     0,    0,   0,
-                             a31, a32,     0,     0,     0,    0,   0,
-                             a41,   0,   a43,     0,     0,    0,   0,
-                             a51, a52,   a53,   a54,     0,    0,   0,
-                             a61, a62,   a63,   a64,   a65,    0,   0,
-                             a71,   0,   a73,   a74,   a75,  a76,   0};
-
-      dfloat _rkE[Nrk]= {b1, 0, b3, b4, a75, b6, 0};
-
-      h_rkX.copyFrom(_rkX,    Nrk,n*Nrk    );
-      h_rkA.copyFrom(_rkA,Nrk*Nrk,n*Nrk*Nrk);
-      h_rkE.copyFrom(_rkE,    Nrk,n*Nrk    );
-    }
-
-    // move data to platform
-    // o_rkX.copyFrom(rkX, properties_t("async", true));
-    // o_rkA.copyFrom(rkA, properties_t("async", true));
-    // o_rkE.copyFrom(rkE, properties_t("async", true));
-    h_rkX.copyTo(o_rkX);
-    h_rkA.copyTo(o_rkA);
-    h_rkE.copyTo(o_rkE);
-  }
+  // move data to platform
+  h_rkX.copyTo(o_rkX);
+  h_rkA.copyTo(o_rkA);
+  h_rkE.copyTo(o_rkE);
 }
 
 /**************************************************/
@@ -527,9 +442,9 @@ sark5_pml::sark5_pml(dlong _Nelements, dlong _NpmlElements, dlong _NhaloElements
     pmlrkA.malloc(Nrk*Nrk);
 
     dfloat _pmlrkA[Nrk*Nrk] =  {     0,      0,       0,       0,       0,      0,   0,
-                                   1/4,      0,       0,       0,       0,      0,   0,
-                                   1/8,    1/8,       0,       0,       0,      0,   0,
-                                     0,      0,     1/2,       0,       0,      0,   0,
+                                 1./4.,      0,       0,       0,       0,      0,   0,
+                                 1./8.,  1./8.,       0,       0,       0,      0,   0,
+                                     0,      0,   1./2.,       0,       0,      0,   0,
                                 3./16., -3./8.,   3./8.,  9./16.,       0,      0,   0,
                                 -3./7.,  8./7.,   6./7., -12./7.,   8./7.,      0,   0,
                                 7./90.,     0., 16./45.,  2./15., 16./45., 7./90.,   0};
@@ -587,7 +502,9 @@ void sark5_pml::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, d
                       o_rkpmlq);
 
     //evaluate ODE rhs = f(q,t)
+    platform.profiler().Tic(profiler_t::Rhs);
     solver.rhsf_pml(o_rkq, o_rkpmlq, o_rhsq, o_rhspmlq, currentTime);
+    platform.profiler().Toc(profiler_t::Rhs);
 
     // update solution using Runge-Kutta
     // rkrhsq_rk = rhsq
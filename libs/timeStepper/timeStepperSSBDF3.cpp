@@ -67,6 +67,30 @@ ssbdf3::ssbdf3(dlong Nelements, dlong NhaloElements,
   ssbdf_b.copyFrom(_b);
 
   o_ssbdf_b = platform.malloc<dfloat>(ssbdf_b);
+
+  adaptive = false;
+  dtHistory.malloc(Nstages, 0.0);
+}
+
+/* Variable step BDF coefficients from Lagrange interpolants
+   through the previous step times */
+void ssbdf3::UpdateCoefficients(const int order, const dfloat _dt) {
+  const int Nnodes = order+2;
+
+  //differentiate the interpolant through t^{n+1}, t^n, ...
+  memory<dfloat> nodes(Nnodes);
+  nodes[0] = 0.0;
+  nodes[1] = -_dt;
+  for (int n=2;n<Nnodes;++n) nodes[n] = nodes[n-1] - dtHistory[n-2];
+
+  memory<dfloat> c(Nnodes);
+  memory<dfloat> B = ssbdf_b + order*(Nstages+1);
+  for (int i=0;i<Nnodes;++i) {
+    LagrangePolynomial(Nnodes, nodes, i, c);
+    B[i] = (i==0) ? _dt*c[1] : -_dt*c[1];
+  }
+
+  o_ssbdf_b.copyFrom(B, Nstages+1, order*(Nstages+1));
 }
 
 dfloat ssbdf3::GetGamma() {
@@ -77,7 +101,9 @@ void ssbdf3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dflo
 
   dfloat time = start;
 
+  platform.profiler().Tic(profiler_t::Output);
   solver.Report(time,0);
+  platform.profiler().Toc(profiler_t::Output);
 
   dfloat outputInterval=0.0;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -87,14 +113,27 @@ void ssbdf3::Run(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat start, dflo
   int tstep=0;
   int order=0;
   while (time < end) {
+    if (adaptive) {
+      if (tstep>0) dt = ControlTimeStep(solver, o_q, time, 1.2);
+      UpdateCoefficients(order, dt);
+    }
+
+    platform.profiler().Tic(profiler_t::Update);
     Step(solver, o_q, time, dt, order);
+    platform.profiler().Toc(profiler_t::Update);
     time += dt;
     tstep++;
     if (order<Nstages-1) order++;
 
+    //the subcycled history states are spaced by the previous steps
+    for (int s=Nstages-1;s>0;--s) dtHistory[s] = dtHistory[s-1];
+    dtHistory[0] = dt;
+
     if (time>outputTime) {
       //report state
+      platform.profiler().Tic(profiler_t::Output);
       solver.Report(time,tstep);
+      platform.profiler().Toc(profiler_t::Output);
       outputTime += outputInterval;
     }
   }
@@ -110,10 +149,17 @@ void ssbdf3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dflo
   deviceMemory<dfloat> o_qn0 = o_qn + shiftIndex*N;
   o_qn0.copyFrom(o_q, N);
 
+  //step sizes between the history states, starting with this step
+  memory<dfloat> stepSizes(Nstages);
+  stepSizes[0] = _dt;
+  for (int s=1;s<Nstages;++s) stepSizes[s] = dtHistory[s-1];
+
   // Compute qhat = sum_i=1^s B_i qhat(t_n+1-i) by
   // where qhat(t) is the Lagrangian state of q
   // by subcycling each of the history states q(t_n-i)
-  solver.rhs_subcycle_f(o_qn, o_qhat, time, _dt, B, order, shiftIndex, Nstages);
+  platform.profiler().Tic(profiler_t::Rhs);
+  solver.rhs_subcycle_f(o_qn, o_qhat, time, stepSizes, B, order, shiftIndex, Nstages);
+  platform.profiler().Toc(profiler_t::Rhs);
 
   //build rhs for implicit step and update history
   rhsKernel(N,
@@ -127,7 +173,9 @@ void ssbdf3::Step(solver_t& solver, deviceMemory<dfloat> &o_q, dfloat time, dflo
 
   //solve implicit part:
   // find q such that gamma*q - G(q) = rhs
+  platform.profiler().Tic(profiler_t::Rhs);
   solver.rhs_imex_invg(o_rhs, o_q, gamma, time+_dt);
+  platform.profiler().Toc(profiler_t::Rhs);
 
   //rotate index
   shiftIndex = (shiftIndex+Nstages-1)%Nstages;
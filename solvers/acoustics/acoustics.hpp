@@ -52,10 +52,15 @@ public:
   mesh_t mesh;
 
   int Nfields;
+  int Nensemble; //number of ensemble members
+
+  memory<dfloat> waveSpeed; //wave speed of each ensemble member
+  deviceMemory<dfloat> o_waveSpeed;
 
   timeStepper_t timeStepper;
 
   ogs::halo_t traceHalo;
+  memory<ogs::halo_t> multirateTraceHalo;
 
   memory<dfloat> q;
   deviceMemory<dfloat> o_q;
@@ -65,6 +70,9 @@ public:
   kernel_t volumeKernel;
   kernel_t surfaceKernel;
 
+  kernel_t volumeSurfaceUpdateKernel;
+  kernel_t surfaceUpdateKernel;
+
   kernel_t initialConditionKernel;
 
   acoustics_t() = default;
@@ -83,8 +91,21 @@ public:
 
   void PlotFields(memory<dfloat> Q, const std::string fileName);
 
+  void EnsembleNorms(memory<dfloat>& norms);
+
   void rhsf(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
 
+  void rhsf_lsrk(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_qnext,
+                 deviceMemory<dfloat>& o_rhs, deviceMemory<dfloat>& o_res,
+                 const dfloat time, const dfloat dt,
+                 const dfloat rka, const dfloat rkb);
+
+  void rhsf_MR(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs,
+               deviceMemory<dfloat>& o_fQM, const dfloat time, const int level);
+
+  void rhsVolume(dlong N, deviceMemory<dlong>& o_ids,
+                 deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs);
+
   dfloat MaxWaveSpeed();
 };
 
@@ -47,3 +47,19 @@ SOFTWARE.
   *(u) = 0.0;                           \
   *(v) = 0.0;                           \
 }
+
+// Ensemble member initial conditions: shifted and scaled copies of the
+// initial conditions, member 0 being the initial conditions themselves
+#define acousticsEnsembleInitialConditions2D(ens, t, x, y, r, u, v) \
+{                                                   \
+  const dfloat xs = x - 0.25*(ens);                 \
+  *(r) = 1.0 + (1.0 + 0.5*(ens))*exp(-3*(xs*xs+y*y)); \
+  *(u) = 0.0;                                       \
+  *(v) = 0.0;                                       \
+}
+
+// Ensemble member wave speeds, member 0 having unit wave speed
+#define acousticsEnsembleWaveSpeed(ens, c) \
+{                                       \
+  *(c) = 1.0 + 0.25*(ens);              \
+}
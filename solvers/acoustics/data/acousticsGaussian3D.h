@@ -51,3 +51,20 @@ SOFTWARE.
   *(v) = 0.0;                           \
   *(w) = 0.0;                           \
 }
+
+// Ensemble member initial conditions: shifted and scaled copies of the
+// initial conditions, member 0 being the initial conditions themselves
+#define acousticsEnsembleInitialConditions3D(ens, t, x, y, z, r, u, v, w) \
+{                                                        \
+  const dfloat xs = x - 0.25*(ens);                      \
+  *(r) = 1.0 + (1.0 + 0.5*(ens))*exp(-3*(xs*xs+y*y+z*z)); \
+  *(u) = 0.0;                                            \
+  *(v) = 0.0;                                            \
+  *(w) = 0.0;                                            \
+}
+
+// Ensemble member wave speeds, member 0 having unit wave speed
+#define acousticsEnsembleWaveSpeed(ens, c) \
+{                                       \
+  *(c) = 1.0 + 0.25*(ens);              \
+}
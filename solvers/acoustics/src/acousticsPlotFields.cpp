@@ -78,37 +78,47 @@ void acoustics_t::PlotFields(memory<dfloat> Q, const std::string fileName){
   memory<dfloat> Iv(mesh.plotNp);
   memory<dfloat> Iw(mesh.plotNp);
 
-  // write out density
   fprintf(fp, "      <PointData Scalars=\"scalars\">\n");
-  fprintf(fp, "        <DataArray type=\"Float32\" Name=\"Density\" Format=\"ascii\">\n");
-  for(dlong e=0;e<mesh.Nelements;++e){
-    mesh.PlotInterp(Q + e*mesh.Np*Nfields, Ip, scratch);
+  for(int ens=0;ens<Nensemble;++ens){
+    const dlong offset = ens*mesh.Np*Nfields;
 
-    for(int n=0;n<mesh.plotNp;++n){
-      fprintf(fp, "       ");
-      fprintf(fp, "%g\n", Ip[n]);
-    }
-  }
-  fprintf(fp, "       </DataArray>\n");
+    // write out density
+    if (Nensemble==1)
+      fprintf(fp, "        <DataArray type=\"Float32\" Name=\"Density\" Format=\"ascii\">\n");
+    else
+      fprintf(fp, "        <DataArray type=\"Float32\" Name=\"Density%d\" Format=\"ascii\">\n", ens);
+    for(dlong e=0;e<mesh.Nelements;++e){
+      mesh.PlotInterp(Q + offset + e*Nensemble*mesh.Np*Nfields, Ip, scratch);
 
-  // write out velocity
-  fprintf(fp, "        <DataArray type=\"Float32\" Name=\"Velocity\" NumberOfComponents=\"%d\" Format=\"ascii\">\n", mesh.dim);
-  for(dlong e=0;e<mesh.Nelements;++e){
-    mesh.PlotInterp(Q + 1*mesh.Np + e*mesh.Np*Nfields, Iu, scratch);
-    mesh.PlotInterp(Q + 2*mesh.Np + e*mesh.Np*Nfields, Iv, scratch);
-    if(mesh.dim==3)
-      mesh.PlotInterp(Q + 3*mesh.Np + e*mesh.Np*Nfields, Iw, scratch);
+      for(int n=0;n<mesh.plotNp;++n){
+        fprintf(fp, "       ");
+        fprintf(fp, "%g\n", Ip[n]);
+      }
+    }
+    fprintf(fp, "       </DataArray>\n");
+
+    // write out velocity
+    if (Nensemble==1)
+      fprintf(fp, "        <DataArray type=\"Float32\" Name=\"Velocity\" NumberOfComponents=\"%d\" Format=\"ascii\">\n", mesh.dim);
+    else
+      fprintf(fp, "        <DataArray type=\"Float32\" Name=\"Velocity%d\" NumberOfComponents=\"%d\" Format=\"ascii\">\n", ens, mesh.dim);
+    for(dlong e=0;e<mesh.Nelements;++e){
+      mesh.PlotInterp(Q + offset + 1*mesh.Np + e*Nensemble*mesh.Np*Nfields, Iu, scratch);
+      mesh.PlotInterp(Q + offset + 2*mesh.Np + e*Nensemble*mesh.Np*Nfields, Iv, scratch);
+      if(mesh.dim==3)
+        mesh.PlotInterp(Q + offset + 3*mesh.Np + e*Nensemble*mesh.Np*Nfields, Iw, scratch);
 
-    for(int n=0;n<mesh.plotNp;++n){
-      fprintf(fp, "       ");
-      fprintf(fp, "       ");
-      if (mesh.dim==2)
-        fprintf(fp, "%g %g\n", Iu[n], Iv[n]);
-      else
-        fprintf(fp, "%g %g %g\n", Iu[n], Iv[n], Iw[n]);
+      for(int n=0;n<mesh.plotNp;++n){
+        fprintf(fp, "       ");
+        fprintf(fp, "       ");
+        if (mesh.dim==2)
+          fprintf(fp, "%g %g\n", Iu[n], Iv[n]);
+        else
+          fprintf(fp, "%g %g %g\n", Iu[n], Iv[n], Iw[n]);
+      }
     }
+    fprintf(fp, "       </DataArray>\n");
   }
-  fprintf(fp, "       </DataArray>\n");
   fprintf(fp, "     </PointData>\n");
 
   fprintf(fp, "    <Cells>\n");
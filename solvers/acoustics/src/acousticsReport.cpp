@@ -33,12 +33,20 @@ void acoustics_t::Report(dfloat time, int tstep){
   //compute q.M*q
   mesh.MassMatrixApply(o_q, o_Mq);
 
-  dlong Nentries = mesh.Nelements*mesh.Np*Nfields;
+  dlong Nentries = mesh.Nelements*mesh.Np*Nfields*Nensemble;
   dfloat norm2 = sqrt(platform.linAlg().innerProd(Nentries, o_q, o_Mq, mesh.comm));
 
   if(mesh.rank==0)
     printf("%5.2f (%d), %5.2f (time, timestep, norm)\n", time, tstep, norm2);
 
+  if (Nensemble>1) {
+    memory<dfloat> norms;
+    EnsembleNorms(norms);
+    if(mesh.rank==0)
+      for(int ens=0;ens<Nensemble;++ens)
+        printf("      member %d, %5.2f (norm)\n", ens, norms[ens]);
+  }
+
   if (settings.compareSetting("OUTPUT TO FILE","TRUE")) {
 
     // copy data back to host
@@ -53,3 +61,27 @@ void acoustics_t::Report(dfloat time, int tstep){
     PlotFields(q, std::string(fname));
   }
 }
+
+//norms of the individual ensemble members, assumes o_Mq holds M*q
+void acoustics_t::EnsembleNorms(memory<dfloat>& norms){
+
+  dlong Nentries = mesh.Nelements*mesh.Np*Nfields*Nensemble;
+  memory<dfloat> Mq(Nentries);
+  o_q.copyTo(q, Nentries);
+  o_Mq.copyTo(Mq, Nentries);
+
+  norms.malloc(Nensemble, 0.0);
+  for(dlong e=0;e<mesh.Nelements;++e){
+    for(int ens=0;ens<Nensemble;++ens){
+      const dlong base = (e*Nensemble + ens)*mesh.Np*Nfields;
+      for(int n=0;n<mesh.Np*Nfields;++n){
+        norms[ens] += q[base+n]*Mq[base+n];
+      }
+    }
+  }
+  mesh.comm.Allreduce(norms, Comm::Sum);
+
+  for(int ens=0;ens<Nensemble;++ens){
+    norms[ens] = sqrt(norms[ens]);
+  }
+}
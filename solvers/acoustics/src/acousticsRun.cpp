@@ -56,9 +56,18 @@ void acoustics_t::Run(){
     //compute q.M*q
     mesh.MassMatrixApply(o_q, o_Mq);
 
-    dlong Nentries = mesh.Nelements*mesh.Np*Nfields;
+    dlong Nentries = mesh.Nelements*mesh.Np*Nfields*Nensemble;
     dfloat norm2 = sqrt(platform.linAlg().innerProd(Nentries, o_q, o_Mq, mesh.comm));
 
+    if (Nensemble>1) {
+      memory<dfloat> norms;
+      EnsembleNorms(norms);
+      if(mesh.rank==0)
+        for(int ens=0;ens<Nensemble;++ens)
+          printf("Member %d solution norm = %17.15lg\n", ens, norms[ens]);
+    }
+
+    //the total norm comes last, where the tests read it
     if(mesh.rank==0)
       printf("Solution norm = %17.15lg\n", norm2);
   }
@@ -37,7 +37,24 @@ acousticsSettings_t::acousticsSettings_t(comm_t _comm):
   newSetting("TIME INTEGRATOR",
              "DOPRI5",
              "Time integration method",
-             {"AB3", "DOPRI5", "LSERK4"});
+             {"AB3", "DOPRI5", "LSERK4", "LSRK", "MRAB3"});
+
+  newSetting("LSRK TABLEAU",
+             "NDB144",
+             "Low-storage Runge-Kutta scheme (LSERK4, NDB124, NDB144, W3) or tableau file name");
+
+  newSetting("FUSED RK UPDATE",
+             "FALSE",
+             "Fuse the rhs evaluation with the LSERK4/LSRK stage update",
+             {"TRUE", "FALSE"});
+
+  newSetting("ENSEMBLE SIZE",
+             "1",
+             "Number of independent simulations advanced together on the mesh");
+
+  newSetting("ENSEMBLE FIRST MEMBER",
+             "0",
+             "Index of the first ensemble member, passed to the member initial conditions and wave speeds");
 
   newSetting("CFL NUMBER",
              "1.0",
@@ -70,6 +87,14 @@ void acousticsSettings_t::report() {
     std::cout << "Acoustics Settings:\n\n";
     reportSetting("DATA FILE");
     reportSetting("TIME INTEGRATOR");
+    if (compareSetting("TIME INTEGRATOR","LSRK"))
+      reportSetting("LSRK TABLEAU");
+    if (compareSetting("TIME INTEGRATOR","LSERK4")
+        || compareSetting("TIME INTEGRATOR","LSRK"))
+      reportSetting("FUSED RK UPDATE");
+    reportSetting("ENSEMBLE SIZE");
+    if (!compareSetting("ENSEMBLE FIRST MEMBER","0"))
+      reportSetting("ENSEMBLE FIRST MEMBER");
     reportSetting("START TIME");
     reportSetting("FINAL TIME");
     reportSetting("OUTPUT INTERVAL");
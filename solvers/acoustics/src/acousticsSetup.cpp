@@ -36,8 +36,43 @@ void acoustics_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   Nfields = (mesh.dim==3) ? 4:3;
 
-  dlong Nlocal = mesh.Nelements*mesh.Np*Nfields;
-  dlong Nhalo  = mesh.totalHaloPairs*mesh.Np*Nfields;
+  //independent simulations stored as extra fields of one solution vector
+  settings.getSetting("ENSEMBLE SIZE", Nensemble);
+  LIBP_ABORT("ENSEMBLE SIZE must be positive", Nensemble<1);
+
+  int ensembleFirst=0;
+  settings.getSetting("ENSEMBLE FIRST MEMBER", ensembleFirst);
+
+  std::string dataFileName;
+  settings.getSetting("DATA FILE", dataFileName);
+
+  //wave speed of each member, from the data file
+  {
+    properties_t kernelInfo = mesh.props; //copy base occa properties
+    kernelInfo["includes"] += dataFileName;
+    kernelInfo["defines/" "p_ensFirst"]= ensembleFirst;
+
+    kernel_t waveSpeedKernel = platform.buildKernel(DACOUSTICS "/okl/acousticsEnsembleWaveSpeed.okl",
+                                                    "acousticsMemberWaveSpeed",
+                                                    kernelInfo);
+    o_waveSpeed = platform.malloc<dfloat>(Nensemble);
+    waveSpeedKernel(Nensemble, o_waveSpeed);
+
+    waveSpeed.malloc(Nensemble);
+    o_waveSpeed.copyTo(waveSpeed);
+  }
+
+  //the multirate and fused kernels advance one member at unit wave speed
+  bool singleUnitMember = (Nensemble==1);
+  for (int ens=0;ens<Nensemble;++ens)
+    if (waveSpeed[ens]!=1.0) singleUnitMember = false;
+  LIBP_ABORT("Ensemble runs and member wave speeds are not supported with MRAB3",
+             !singleUnitMember && settings.compareSetting("TIME INTEGRATOR","MRAB3"));
+  LIBP_ABORT("Ensemble runs and member wave speeds are not supported with FUSED RK UPDATE",
+             !singleUnitMember && settings.compareSetting("FUSED RK UPDATE","TRUE"));
+
+  dlong Nlocal = mesh.Nelements*mesh.Np*Nfields*Nensemble;
+  dlong Nhalo  = mesh.totalHaloPairs*mesh.Np*Nfields*Nensemble;
 
   //Trigger JIT kernel builds
   ogs::InitializeKernels(platform, ogs::Dfloat, ogs::Add);
@@ -46,21 +81,52 @@ void acoustics_t::Setup(platform_t& _platform, mesh_t& _mesh,
   platform.linAlg().InitKernels({"innerProd"});
 
   /*setup trace halo exchange */
-  traceHalo = mesh.HaloTraceSetup(Nfields);
+  traceHalo = mesh.HaloTraceSetup(Nfields*Nensemble); //all fields of all members
+
+  mesh.mrNlevels=0;
+  if (settings.compareSetting("TIME INTEGRATOR","MRAB3")) {
+    //make array of time step estimates for each element
+    memory<dfloat> EtoDT(mesh.Nelements);
+    dfloat vmax = MaxWaveSpeed();
+    for(dlong e=0;e<mesh.Nelements;++e){
+      dfloat h = mesh.ElementCharacteristicLength(e);
+      EtoDT[e] = h/(vmax*(mesh.N+1.)*(mesh.N+1.));
+    }
+
+    mesh.MultiRateSetup(EtoDT, Nfields);
+    multirateTraceHalo = mesh.MultiRateHaloTraceSetup(Nfields);
+  }
+
+  //fuse the rhs evaluation with the stage update of low-storage RK steppers
+  const bool fusedUpdate = settings.compareSetting("FUSED RK UPDATE","TRUE")
+                           && (settings.compareSetting("TIME INTEGRATOR","LSERK4")
+                               || settings.compareSetting("TIME INTEGRATOR","LSRK"));
 
   //setup timeStepper
   if (settings.compareSetting("TIME INTEGRATOR","AB3")){
     timeStepper.Setup<TimeStepper::ab3>(mesh.Nelements,
                                         mesh.totalHaloPairs,
-                                        mesh.Np, Nfields, platform, comm);
+                                        mesh.Np, Nfields*Nensemble, platform, comm);
   } else if (settings.compareSetting("TIME INTEGRATOR","LSERK4")){
     timeStepper.Setup<TimeStepper::lserk4>(mesh.Nelements,
                                            mesh.totalHaloPairs,
-                                           mesh.Np, Nfields, platform, comm);
+                                           mesh.Np, Nfields*Nensemble, platform, comm,
+                                           fusedUpdate);
+  } else if (settings.compareSetting("TIME INTEGRATOR","LSRK")){
+    std::string tableau;
+    settings.getSetting("LSRK TABLEAU", tableau);
+    timeStepper.Setup<TimeStepper::lsrk>(mesh.Nelements,
+                                         mesh.totalHaloPairs,
+                                         mesh.Np, Nfields*Nensemble, platform, comm,
+                                         tableau, fusedUpdate);
   } else if (settings.compareSetting("TIME INTEGRATOR","DOPRI5")){
     timeStepper.Setup<TimeStepper::dopri5>(mesh.Nelements,
                                            mesh.totalHaloPairs,
-                                           mesh.Np, Nfields, platform, comm);
+                                           mesh.Np, Nfields*Nensemble, platform, comm);
+  } else if (settings.compareSetting("TIME INTEGRATOR","MRAB3")){
+    timeStepper.Setup<TimeStepper::mrab3>(mesh.Nelements,
+                                          mesh.totalHaloPairs,
+                                          mesh.Np, Nfields, platform, mesh);
   }
 
   // set penalty parameter
@@ -72,17 +138,17 @@ void acoustics_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   //storage for M*q during reporting
   o_Mq = platform.malloc<dfloat>(q);
-  mesh.MassMatrixKernelSetup(Nfields); // mass matrix operator
+  mesh.MassMatrixKernelSetup(Nfields*Nensemble); // mass matrix operator
 
   // OCCA build stuff
   properties_t kernelInfo = mesh.props; //copy base occa properties
 
   //add boundary data to kernel info
-  std::string dataFileName;
-  settings.getSetting("DATA FILE", dataFileName);
   kernelInfo["includes"] += dataFileName;
 
   kernelInfo["defines/" "p_Nfields"]= Nfields;
+  kernelInfo["defines/" "p_Nens"]= Nensemble;
+  kernelInfo["defines/" "p_ensFirst"]= ensembleFirst;
 
   const dfloat p_half = 1./2.;
   kernelInfo["defines/" "p_half"]= p_half;
@@ -125,11 +191,25 @@ void acoustics_t::Setup(platform_t& _platform, mesh_t& _mesh,
                                          kernelInfo);
   // kernels from surface file
   fileName   = oklFilePrefix + "acousticsSurface" + suffix + oklFileSuffix;
-  kernelName = "acousticsSurface" + suffix;
+  if (settings.compareSetting("TIME INTEGRATOR","MRAB3")) {
+    kernelName = "acousticsMRSurface" + suffix;
+  } else {
+    kernelName = "acousticsSurface" + suffix;
+  }
 
   surfaceKernel = platform.buildKernel(fileName, kernelName,
                                          kernelInfo);
 
+  if (fusedUpdate) {
+    kernelName = "acousticsVolumeSurfaceUpdate" + suffix;
+    volumeSurfaceUpdateKernel = platform.buildKernel(fileName, kernelName,
+                                                     kernelInfo);
+
+    kernelName = "acousticsSurfaceUpdate" + suffix;
+    surfaceUpdateKernel = platform.buildKernel(fileName, kernelName,
+                                               kernelInfo);
+  }
+
   if (mesh.dim==2) {
     fileName   = oklFilePrefix + "acousticsInitialCondition2D" + oklFileSuffix;
     kernelName = "acousticsInitialCondition2D";
@@ -27,8 +27,10 @@ SOFTWARE.
 #include "acoustics.hpp"
 
 dfloat acoustics_t::MaxWaveSpeed(){
-  //wavespeed is constant 1 everywhere
-  const dfloat vmax = 1.0;
+  //wavespeed is constant in space, but may differ between ensemble members
+  dfloat vmax = 0.0;
+  for (int ens=0;ens<Nensemble;++ens)
+    vmax = std::max(vmax, waveSpeed[ens]);
   return vmax;
 }
 
@@ -38,11 +40,8 @@ void acoustics_t::rhsf(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, c
   // extract q halo on DEVICE
   traceHalo.ExchangeStart(o_Q, 1);
 
-  volumeKernel(mesh.Nelements,
-               mesh.o_vgeo,
-               mesh.o_D,
-               o_Q,
-               o_RHS);
+  rhsVolume(mesh.NinternalElements, mesh.o_internalElementIds, o_Q, o_RHS);
+  rhsVolume(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, o_RHS);
 
   if (mesh.NinternalElements)
     surfaceKernel(mesh.NinternalElements,
@@ -56,6 +55,7 @@ void acoustics_t::rhsf(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, c
                   mesh.o_x,
                   mesh.o_y,
                   mesh.o_z,
+                  o_waveSpeed,
                   o_Q,
                   o_RHS);
 
@@ -73,6 +73,105 @@ void acoustics_t::rhsf(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, c
                   mesh.o_x,
                   mesh.o_y,
                   mesh.o_z,
+                  o_waveSpeed,
                   o_Q,
                   o_RHS);
 }
+
+//evaluate ODE rhs = f(q,t) and apply the low-storage RK stage update
+//  res = rka*res + dt*f(q,t), qnext = q + rkb*res
+void acoustics_t::rhsf_lsrk(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_Qnext,
+                          deviceMemory<dfloat>& o_RHS, deviceMemory<dfloat>& o_RES,
+                          const dfloat T, const dfloat dt,
+                          const dfloat rka, const dfloat rkb){
+
+  // extract q halo on DEVICE
+  traceHalo.ExchangeStart(o_Q, 1);
+
+  // volume terms of halo elements wait in o_RHS for the exchanged traces
+  rhsVolume(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, o_RHS);
+
+  // internal elements only read local traces, so they can be fully updated
+  if (mesh.NinternalElements)
+    volumeSurfaceUpdateKernel(mesh.NinternalElements,
+                              mesh.o_internalElementIds,
+                              mesh.o_vgeo,
+                              mesh.o_D,
+                              mesh.o_sgeo,
+                              mesh.o_LIFT,
+                              mesh.o_vmapM,
+                              mesh.o_vmapP,
+                              mesh.o_EToB,
+                              T,
+                              mesh.o_x,
+                              mesh.o_y,
+                              mesh.o_z,
+                              o_Q,
+                              dt, rka, rkb,
+                              o_RES,
+                              o_Qnext);
+
+  traceHalo.ExchangeFinish(o_Q, 1);
+
+  if (mesh.NhaloElements)
+    surfaceUpdateKernel(mesh.NhaloElements,
+                        mesh.o_haloElementIds,
+                        mesh.o_sgeo,
+                        mesh.o_LIFT,
+                        mesh.o_vmapM,
+                        mesh.o_vmapP,
+                        mesh.o_EToB,
+                        T,
+                        mesh.o_x,
+                        mesh.o_y,
+                        mesh.o_z,
+                        o_Q,
+                        dt, rka, rkb,
+                        o_RHS,
+                        o_RES,
+                        o_Qnext);
+}
+
+//evaluate ODE rhs = f(q,t) on multirate level
+void acoustics_t::rhsf_MR(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS,
+                          deviceMemory<dfloat>& o_fQM, const dfloat T, const int lev){
+
+  // extract q trace halo and start exchange
+  multirateTraceHalo[lev].ExchangeStart(o_fQM, 1);
+
+  // compute volume contribution to acoustics RHS
+  rhsVolume(mesh.mrNelements[lev], mesh.o_mrElements[lev], o_Q, o_RHS);
+
+  // complete trace halo exchange
+  multirateTraceHalo[lev].ExchangeFinish(o_fQM, 1);
+
+  // compute surface contribution to acoustics RHS
+  if (mesh.mrNelements[lev])
+    surfaceKernel(mesh.mrNelements[lev],
+                  mesh.o_mrElements[lev],
+                  mesh.o_sgeo,
+                  mesh.o_LIFT,
+                  mesh.o_vmapM,
+                  mesh.o_mapP,
+                  mesh.o_EToB,
+                  T,
+                  mesh.o_x,
+                  mesh.o_y,
+                  mesh.o_z,
+                  o_fQM,
+                  o_RHS);
+}
+
+void acoustics_t::rhsVolume(dlong N, deviceMemory<dlong>& o_ids,
+                            deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS){
+
+  // compute volume contribution to acoustics RHS
+  if (N)
+    volumeKernel(N,
+                 o_ids,
+                 mesh.o_vgeo,
+                 mesh.o_D,
+                 o_waveSpeed,
+                 o_Q,
+                 o_RHS);
+}
@@ -52,7 +52,12 @@ public:
   mesh_t mesh;
   timeStepper_t timeStepper;
 
+  comm_t timeComm; //parallel-in-time slices
+
+  int Nensemble; //number of ensemble members
+
   ogs::halo_t traceHalo;
+  memory<ogs::halo_t> multirateTraceHalo;
 
   memory<dfloat> q;
   deviceMemory<dfloat> o_q;
@@ -62,28 +67,49 @@ public:
   kernel_t volumeKernel;
   kernel_t surfaceKernel;
 
+  kernel_t volumeSurfaceUpdateKernel;
+  kernel_t surfaceUpdateKernel;
+
   kernel_t initialConditionKernel;
   kernel_t maxWaveSpeedKernel;
 
   advection_t() = default;
   advection_t(platform_t &_platform, mesh_t &_mesh,
-              advectionSettings_t& _settings) {
-    Setup(_platform, _mesh, _settings);
+              advectionSettings_t& _settings, comm_t _timeComm) {
+    Setup(_platform, _mesh, _settings, _timeComm);
   }
 
   //setup
   void Setup(platform_t& platform, mesh_t& mesh,
-             advectionSettings_t& settings);
+             advectionSettings_t& settings, comm_t timeComm);
 
   void Run();
 
   void Report(dfloat time, int tstep);
 
+  void EnsembleNorms(memory<dfloat>& norms);
+
   void PlotFields(memory<dfloat> Q, const std::string fileName);
 
   void rhsf(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
 
+  void rhsf_lsrk(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_qnext,
+                 deviceMemory<dfloat>& o_rhs, deviceMemory<dfloat>& o_res,
+                 const dfloat time, const dfloat dt,
+                 const dfloat rka, const dfloat rkb);
+
+  void rhsf_MR(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs,
+               deviceMemory<dfloat>& o_fQM, const dfloat time, const int level);
+
+  void rhsVolume(dlong N, deviceMemory<dlong>& o_ids,
+                 deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
+
   dfloat MaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T);
+
+  dfloat MaxTimeStep(deviceMemory<dfloat>& o_Q, const dfloat T);
+
+  void ElementMaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T,
+                           deviceMemory<dfloat>& o_maxSpeed);
 };
 
 #endif
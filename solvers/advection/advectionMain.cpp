@@ -51,11 +51,18 @@ int main(int argc, char **argv){
     meshSettings.report();
     advectionSettings.report();
 
+    // split ranks into parallel-in-time slices, each with its own copy of the mesh
+    int Nslices=1;
+    advectionSettings.getSetting("PARAREAL TIME SLICES", Nslices);
+
+    comm_t spaceComm, timeComm;
+    TimeStepper::parareal::SplitComm(comm, Nslices, spaceComm, timeComm);
+
     // set up mesh
-    mesh_t mesh(platform, meshSettings, comm);
+    mesh_t mesh(platform, meshSettings, spaceComm);
 
     // set up advection solver
-    advection_t advection(platform, mesh, advectionSettings);
+    advection_t advection(platform, mesh, advectionSettings, timeComm);
 
     // run
     advection.Run();
@@ -57,3 +57,11 @@ SOFTWARE.
 {                                       \
   *(q) = exp(-3*(x*x+y*y));             \
 }
+
+// Ensemble member initial conditions: shifted and scaled copies of the
+// initial conditions, member 0 being the initial conditions themselves
+#define advectionEnsembleInitialConditions2D(ens, t, x, y, q) \
+{                                                \
+  const dfloat xs = x - 0.25*(ens);              \
+  *(q) = (1.0 + 0.5*(ens))*exp(-3*(xs*xs+y*y));  \
+}
@@ -60,3 +60,11 @@ SOFTWARE.
 {                                       \
   *(q) = exp(-2*(x*x+y*y+z*z));         \
 }
+
+// Ensemble member initial conditions: shifted and scaled copies of the
+// initial conditions, member 0 being the initial conditions themselves
+#define advectionEnsembleInitialConditions3D(ens, t, x, y, z, q) \
+{                                                     \
+  const dfloat xs = x - 0.25*(ens);                   \
+  *(q) = (1.0 + 0.5*(ens))*exp(-2*(xs*xs+y*y+z*z));   \
+}
@@ -0,0 +1,72 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// Linear advection whose speed pulses in time, doubling at t=1/2, so the
+// stable time step shrinks and recovers over a unit run
+#define ADVECTION_SPEED_X 1.0
+#define ADVECTION_SPEED_Y 0.5
+#define ADVECTION_SPEED_SCALE(t) (1.5 - 0.5*cos(2.0*M_PI*(t)))
+
+// Flux function
+#define advectionFlux2D(t, x, y, q, cx, cy)          \
+{                                                    \
+  const dfloat speedScale = ADVECTION_SPEED_SCALE(t);\
+  *(cx) = speedScale*ADVECTION_SPEED_X*q;            \
+  *(cy) = speedScale*ADVECTION_SPEED_Y*q;            \
+}
+
+// max wavespeed (should be max eigen of Jacobian of flux function)
+#define advectionMaxWaveSpeed2D(t, x, y, q, u, v)    \
+{                                                    \
+  const dfloat speedScale = ADVECTION_SPEED_SCALE(t);\
+  *(u) = speedScale*ADVECTION_SPEED_X;               \
+  *(v) = speedScale*ADVECTION_SPEED_Y;               \
+}
+
+// Boundary conditions
+/* wall 1, outflow 2 */
+#define advectionDirichletConditions2D(bc, t, x, y, nx, ny, qM, qB) \
+{                                       \
+  if(bc==1){                            \
+    *(qB) = 0.0;                        \
+  } else if(bc==2){                     \
+    *(qB) = qM;                         \
+  }                                     \
+}
+
+// Initial conditions
+#define advectionInitialConditions2D(t, x, y, q) \
+{                                       \
+  *(q) = exp(-3*(x*x+y*y));             \
+}
+
+// Ensemble member initial conditions: shifted and scaled copies of the
+// initial conditions, member 0 being the initial conditions themselves
+#define advectionEnsembleInitialConditions2D(ens, t, x, y, q) \
+{                                                \
+  const dfloat xs = x - 0.25*(ens);              \
+  *(q) = (1.0 + 0.5*(ens))*exp(-3*(xs*xs+y*y));  \
+}
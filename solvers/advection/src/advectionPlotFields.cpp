@@ -77,16 +77,21 @@ void advection_t::PlotFields(memory<dfloat> Q, const std::string fileName){
 
   // write out field
   fprintf(fp, "      <PointData Scalars=\"scalars\">\n");
-  fprintf(fp, "        <DataArray type=\"Float32\" Name=\"Field\" Format=\"ascii\">\n");
-  for(dlong e=0;e<mesh.Nelements;++e){
-    mesh.PlotInterp(Q + e*mesh.Np, Ip, scratch);
+  for(int ens=0;ens<Nensemble;++ens){
+    if (Nensemble==1)
+      fprintf(fp, "        <DataArray type=\"Float32\" Name=\"Field\" Format=\"ascii\">\n");
+    else
+      fprintf(fp, "        <DataArray type=\"Float32\" Name=\"Field%d\" Format=\"ascii\">\n", ens);
+    for(dlong e=0;e<mesh.Nelements;++e){
+      mesh.PlotInterp(Q + (e*Nensemble + ens)*mesh.Np, Ip, scratch);
 
-    for(int n=0;n<mesh.plotNp;++n){
-      fprintf(fp, "       ");
-      fprintf(fp, "%g\n", Ip[n]);
+      for(int n=0;n<mesh.plotNp;++n){
+        fprintf(fp, "       ");
+        fprintf(fp, "%g\n", Ip[n]);
+      }
     }
+    fprintf(fp, "       </DataArray>\n");
   }
-  fprintf(fp, "       </DataArray>\n");
   fprintf(fp, "     </PointData>\n");
 
   fprintf(fp, "    <Cells>\n");
@@ -39,13 +39,8 @@ void advection_t::Run(){
                          mesh.o_z,
                          o_q);
 
-  dfloat cfl=1.0;
-  settings.getSetting("CFL NUMBER", cfl);
-
   // set time step
-  dfloat vmax = MaxWaveSpeed(o_q, startTime);
-
-  dfloat dt = cfl/(vmax*(mesh.N+1.)*(mesh.N+1.));
+  dfloat dt = MaxTimeStep(o_q, startTime);
   timeStepper.SetTimeStep(dt);
 
   timeStepper.Run(*this, o_q, startTime, finalTime);
@@ -55,11 +50,31 @@ void advection_t::Run(){
     //compute q.M*q
     mesh.MassMatrixApply(o_q, o_Mq);
 
-    dlong Nentries = mesh.Nelements*mesh.Np;
+    dlong Nentries = mesh.Nelements*mesh.Np*Nensemble;
     dfloat norm2 = sqrt(platform.linAlg().innerProd(Nentries, o_q, o_Mq, mesh.comm));
 
-    if(mesh.rank==0)
+    if (Nensemble>1) {
+      memory<dfloat> norms;
+      EnsembleNorms(norms);
+      if(mesh.rank==0 && timeComm.rank()==0)
+        for(int ens=0;ens<Nensemble;++ens)
+          printf("Member %d solution norm = %17.15lg\n", ens, norms[ens]);
+    }
+
+    //every time slice holds the final state, so only the first one prints.
+    // The total norm comes last, where the tests read it
+    if(mesh.rank==0 && timeComm.rank()==0)
       printf("Solution norm = %17.15lg\n", norm2);
   }
 
 }
+
+dfloat advection_t::MaxTimeStep(deviceMemory<dfloat>& o_Q, const dfloat T){
+
+  dfloat cfl=1.0;
+  settings.getSetting("CFL NUMBER", cfl);
+
+  dfloat vmax = MaxWaveSpeed(o_Q, T);
+
+  return cfl/(vmax*(mesh.N+1.)*(mesh.N+1.));
+}
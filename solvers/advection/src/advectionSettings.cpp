@@ -37,12 +37,55 @@ advectionSettings_t::advectionSettings_t(comm_t _comm):
   newSetting("TIME INTEGRATOR",
              "DOPRI5",
              "Time integration method",
-             {"AB3", "DOPRI5", "LSERK4"});
+             {"AB3", "DOPRI5", "LSERK4", "LSRK", "MRAB3"});
+
+  newSetting("LSRK TABLEAU",
+             "NDB144",
+             "Low-storage Runge-Kutta scheme (LSERK4, NDB124, NDB144, W3) or tableau file name");
+
+  newSetting("FUSED RK UPDATE",
+             "FALSE",
+             "Fuse the rhs evaluation with the LSERK4/LSRK stage update",
+             {"TRUE", "FALSE"});
+
+  newSetting("ENSEMBLE SIZE",
+             "1",
+             "Number of independent simulations advanced together on the mesh");
+
+  newSetting("ENSEMBLE FIRST MEMBER",
+             "0",
+             "Index of the first ensemble member, passed to the member initial conditions");
+
+  newSetting("PARAREAL TIME SLICES",
+             "1",
+             "Number of parallel-in-time slices the ranks are split into");
+
+  newSetting("PARAREAL COARSE INTEGRATOR",
+             "LSERK4",
+             "Coarse propagator for parareal iterations",
+             {"AB3", "LSERK4"});
+
+  newSetting("PARAREAL COARSE DT FACTOR",
+             "4",
+             "Ratio of coarse to fine propagator time step");
+
+  newSetting("PARAREAL MAX ITERATIONS",
+             "4",
+             "Maximum number of parareal iterations");
+
+  newSetting("PARAREAL TOLERANCE",
+             "1.0e-8",
+             "Relative update tolerance for parareal iterations");
 
   newSetting("CFL NUMBER",
              "1.0",
              "Multiplier for timestep stability bound");
 
+  newSetting("ADAPTIVE TIME STEP",
+             "FALSE",
+             "Recompute the AB3 time step from the stability bound every step",
+             {"TRUE", "FALSE"});
+
   newSetting("START TIME",
              "0",
              "Start time for time integration");
@@ -70,6 +113,23 @@ void advectionSettings_t::report() {
     std::cout << "Advection Settings:\n\n";
     reportSetting("DATA FILE");
     reportSetting("TIME INTEGRATOR");
+    if (compareSetting("TIME INTEGRATOR","LSRK"))
+      reportSetting("LSRK TABLEAU");
+    if (compareSetting("TIME INTEGRATOR","LSERK4")
+        || compareSetting("TIME INTEGRATOR","LSRK"))
+      reportSetting("FUSED RK UPDATE");
+    reportSetting("ENSEMBLE SIZE");
+    if (!compareSetting("ENSEMBLE FIRST MEMBER","0"))
+      reportSetting("ENSEMBLE FIRST MEMBER");
+    reportSetting("PARAREAL TIME SLICES");
+    if (!compareSetting("PARAREAL TIME SLICES","1")) {
+      reportSetting("PARAREAL COARSE INTEGRATOR");
+      reportSetting("PARAREAL COARSE DT FACTOR");
+      reportSetting("PARAREAL MAX ITERATIONS");
+      reportSetting("PARAREAL TOLERANCE");
+    }
+    if (compareSetting("TIME INTEGRATOR","AB3"))
+      reportSetting("ADAPTIVE TIME STEP");
     reportSetting("START TIME");
     reportSetting("FINAL TIME");
     reportSetting("OUTPUT INTERVAL");
@@ -27,15 +27,26 @@ SOFTWARE.
 #include "advection.hpp"
 
 void advection_t::Setup(platform_t& _platform, mesh_t& _mesh,
-                         advectionSettings_t& _settings){
+                         advectionSettings_t& _settings, comm_t _timeComm){
 
   platform = _platform;
   mesh = _mesh;
   comm = mesh.comm;
   settings = _settings;
+  timeComm = _timeComm;
 
-  dlong Nlocal = mesh.Nelements*mesh.Np;
-  dlong Nhalo  = mesh.totalHaloPairs*mesh.Np;
+  //independent simulations stored as fields of one solution vector
+  settings.getSetting("ENSEMBLE SIZE", Nensemble);
+  LIBP_ABORT("ENSEMBLE SIZE must be positive", Nensemble<1);
+  LIBP_ABORT("Ensemble runs are not supported with MRAB3",
+             Nensemble>1 && settings.compareSetting("TIME INTEGRATOR","MRAB3"));
+  LIBP_ABORT("Ensemble runs are not supported with FUSED RK UPDATE",
+             Nensemble>1 && settings.compareSetting("FUSED RK UPDATE","TRUE"));
+  LIBP_ABORT("Parareal time slicing is not supported with MRAB3",
+             timeComm.size()>1 && settings.compareSetting("TIME INTEGRATOR","MRAB3"));
+
+  dlong Nlocal = mesh.Nelements*mesh.Np*Nensemble;
+  dlong Nhalo  = mesh.totalHaloPairs*mesh.Np*Nensemble;
 
   //Trigger JIT kernel builds
   ogs::InitializeKernels(platform, ogs::Dfloat, ogs::Add);
@@ -44,21 +55,65 @@ void advection_t::Setup(platform_t& _platform, mesh_t& _mesh,
   platform.linAlg().InitKernels({"innerProd", "max"});
 
   /*setup trace halo exchange */
-  traceHalo = mesh.HaloTraceSetup(1); //one field
+  traceHalo = mesh.HaloTraceSetup(Nensemble); //one field per member
+
+  //fuse the rhs evaluation with the stage update of low-storage RK steppers
+  const bool fusedUpdate = settings.compareSetting("FUSED RK UPDATE","TRUE")
+                           && (settings.compareSetting("TIME INTEGRATOR","LSERK4")
+                               || settings.compareSetting("TIME INTEGRATOR","LSRK"));
 
   //setup timeStepper
   if (settings.compareSetting("TIME INTEGRATOR","AB3")){
     timeStepper.Setup<TimeStepper::ab3>(mesh.Nelements,
                                         mesh.totalHaloPairs,
-                                        mesh.Np, 1, platform, comm);
+                                        mesh.Np, Nensemble, platform, comm);
   } else if (settings.compareSetting("TIME INTEGRATOR","LSERK4")){
     timeStepper.Setup<TimeStepper::lserk4>(mesh.Nelements,
                                            mesh.totalHaloPairs,
-                                           mesh.Np, 1, platform, comm);
+                                           mesh.Np, Nensemble, platform, comm,
+                                           fusedUpdate);
+  } else if (settings.compareSetting("TIME INTEGRATOR","LSRK")){
+    std::string tableau;
+    settings.getSetting("LSRK TABLEAU", tableau);
+    timeStepper.Setup<TimeStepper::lsrk>(mesh.Nelements,
+                                         mesh.totalHaloPairs,
+                                         mesh.Np, Nensemble, platform, comm,
+                                         tableau, fusedUpdate);
   } else if (settings.compareSetting("TIME INTEGRATOR","DOPRI5")){
     timeStepper.Setup<TimeStepper::dopri5>(mesh.Nelements,
                                            mesh.totalHaloPairs,
-                                           mesh.Np, 1, platform, comm);
+                                           mesh.Np, Nensemble, platform, comm);
+  }
+
+  if (settings.compareSetting("ADAPTIVE TIME STEP","TRUE"))
+    timeStepper.EnableAdaptiveTimeStep();
+
+  //the chosen stepper becomes the fine propagator of a parareal driver
+  if (timeComm.size()>1) {
+    timeStepper_t fineStepper = timeStepper;
+
+    timeStepper_t coarseStepper;
+    if (settings.compareSetting("PARAREAL COARSE INTEGRATOR","AB3")){
+      coarseStepper.Setup<TimeStepper::ab3>(mesh.Nelements,
+                                            mesh.totalHaloPairs,
+                                            mesh.Np, Nensemble, platform, comm);
+    } else {
+      coarseStepper.Setup<TimeStepper::lserk4>(mesh.Nelements,
+                                               mesh.totalHaloPairs,
+                                               mesh.Np, Nensemble, platform, comm);
+    }
+
+    dfloat coarseFactor, tolerance;
+    int maxIterations;
+    settings.getSetting("PARAREAL COARSE DT FACTOR", coarseFactor);
+    settings.getSetting("PARAREAL MAX ITERATIONS", maxIterations);
+    settings.getSetting("PARAREAL TOLERANCE", tolerance);
+
+    timeStepper.Setup<TimeStepper::parareal>(mesh.Nelements,
+                                             mesh.totalHaloPairs,
+                                             mesh.Np, Nensemble, platform, comm,
+                                             timeComm, fineStepper, coarseStepper,
+                                             coarseFactor, maxIterations, tolerance);
   }
 
   // compute samples of q at interpolation nodes
@@ -67,7 +122,7 @@ void advection_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   //storage for M*q during reporting
   o_Mq = platform.malloc<dfloat>(q);
-  mesh.MassMatrixKernelSetup(1); // mass matrix operator
+  mesh.MassMatrixKernelSetup(Nensemble); // mass matrix operator
 
   // OCCA build stuff
   properties_t kernelInfo = mesh.props; //copy base occa properties
@@ -80,6 +135,13 @@ void advection_t::Setup(platform_t& _platform, mesh_t& _mesh,
   int maxNodes = std::max(mesh.Np, (mesh.Nfp*mesh.Nfaces));
   kernelInfo["defines/" "p_maxNodes"]= maxNodes;
 
+  kernelInfo["defines/" "p_Nens"]= Nensemble;
+
+  //members can be split over several runs by offsetting their index
+  int ensembleFirst=0;
+  settings.getSetting("ENSEMBLE FIRST MEMBER", ensembleFirst);
+  kernelInfo["defines/" "p_ensFirst"]= ensembleFirst;
+
   int blockMax = 256;
   if (platform.device.mode() == "CUDA") blockMax = 512;
 
@@ -113,10 +175,24 @@ void advection_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   // kernels from surface file
   fileName   = oklFilePrefix + "advectionSurface" + suffix + oklFileSuffix;
-  kernelName = "advectionSurface" + suffix;
+  if (settings.compareSetting("TIME INTEGRATOR","MRAB3")) {
+    kernelName = "advectionMRSurface" + suffix;
+  } else {
+    kernelName = "advectionSurface" + suffix;
+  }
 
   surfaceKernel = platform.buildKernel(fileName, kernelName, kernelInfo);
 
+  if (fusedUpdate) {
+    kernelName = "advectionVolumeSurfaceUpdate" + suffix;
+    volumeSurfaceUpdateKernel = platform.buildKernel(fileName, kernelName,
+                                                     kernelInfo);
+
+    kernelName = "advectionSurfaceUpdate" + suffix;
+    surfaceUpdateKernel = platform.buildKernel(fileName, kernelName,
+                                               kernelInfo);
+  }
+
   if (mesh.dim==2) {
     fileName   = oklFilePrefix + "advectionInitialCondition2D" + oklFileSuffix;
     kernelName = "advectionInitialCondition2D";
@@ -131,4 +207,43 @@ void advection_t::Setup(platform_t& _platform, mesh_t& _mesh,
   kernelName = "advectionMaxWaveSpeed" + suffix;
 
   maxWaveSpeedKernel = platform.buildKernel(fileName, kernelName, kernelInfo);
+
+  mesh.mrNlevels=0;
+  if (settings.compareSetting("TIME INTEGRATOR","MRAB3")) {
+    dfloat startTime;
+    settings.getSetting("START TIME", startTime);
+
+    //sample the wave speed of the initial condition in each element
+    initialConditionKernel(mesh.Nelements,
+                           startTime,
+                           mesh.o_x,
+                           mesh.o_y,
+                           mesh.o_z,
+                           o_q);
+
+    deviceMemory<dfloat> o_maxSpeed = platform.malloc<dfloat>(mesh.Nelements);
+    ElementMaxWaveSpeed(o_q, startTime, o_maxSpeed);
+
+    memory<dfloat> maxSpeed(mesh.Nelements);
+    o_maxSpeed.copyTo(maxSpeed);
+
+    //make array of time step estimates for each element. Elements with
+    // little or no flow are only limited by the length of the run
+    dfloat finalTime;
+    settings.getSetting("FINAL TIME", finalTime);
+    const dfloat dtMax = finalTime-startTime;
+
+    memory<dfloat> EtoDT(mesh.Nelements);
+    for(dlong e=0;e<mesh.Nelements;++e){
+      const dfloat rate = maxSpeed[e]*(mesh.N+1.)*(mesh.N+1.);
+      EtoDT[e] = (rate*dtMax>1.0) ? 1.0/rate : dtMax;
+    }
+
+    mesh.MultiRateSetup(EtoDT, 1); //one field
+    multirateTraceHalo = mesh.MultiRateHaloTraceSetup(1); //one field
+
+    timeStepper.Setup<TimeStepper::mrab3>(mesh.Nelements,
+                                          mesh.totalHaloPairs,
+                                          mesh.Np, 1, platform, mesh);
+  }
 }
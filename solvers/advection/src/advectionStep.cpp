@@ -31,6 +31,16 @@ dfloat advection_t::MaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T){
   //Note: if this is on the critical path in the future, we should pre-allocate this
   deviceMemory<dfloat> o_maxSpeed = platform.malloc<dfloat>(mesh.Nelements);
 
+  ElementMaxWaveSpeed(o_Q, T, o_maxSpeed);
+
+  const dfloat vmax = platform.linAlg().max(mesh.Nelements, o_maxSpeed, mesh.comm);
+
+  return vmax;
+}
+
+void advection_t::ElementMaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T,
+                                      deviceMemory<dfloat>& o_maxSpeed){
+
   maxWaveSpeedKernel(mesh.Nelements,
                      mesh.o_wJ,
                      mesh.o_sgeo,
@@ -42,10 +52,6 @@ dfloat advection_t::MaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T){
                      mesh.o_z,
                      o_Q,
                      o_maxSpeed);
-
-  const dfloat vmax = platform.linAlg().max(mesh.Nelements, o_maxSpeed, mesh.comm);
-
-  return vmax;
 }
 
 //evaluate ODE rhs = f(q,t)
@@ -54,15 +60,8 @@ void advection_t::rhsf(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, c
   // extract q halo on DEVICE
   traceHalo.ExchangeStart(o_Q, 1);
 
-  volumeKernel(mesh.Nelements,
-               mesh.o_vgeo,
-               mesh.o_D,
-               T,
-               mesh.o_x,
-               mesh.o_y,
-               mesh.o_z,
-               o_Q,
-               o_RHS);
+  rhsVolume(mesh.NinternalElements, mesh.o_internalElementIds, o_Q, o_RHS, T);
+  rhsVolume(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, o_RHS, T);
 
   traceHalo.ExchangeFinish(o_Q, 1);
 
@@ -79,3 +78,105 @@ void advection_t::rhsf(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, c
                 o_Q,
                 o_RHS);
 }
+
+//evaluate ODE rhs = f(q,t) and apply the low-storage RK stage update
+//  res = rka*res + dt*f(q,t), qnext = q + rkb*res
+void advection_t::rhsf_lsrk(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_Qnext,
+                          deviceMemory<dfloat>& o_RHS, deviceMemory<dfloat>& o_RES,
+                          const dfloat T, const dfloat dt,
+                          const dfloat rka, const dfloat rkb){
+
+  // extract q halo on DEVICE
+  traceHalo.ExchangeStart(o_Q, 1);
+
+  // volume terms of halo elements wait in o_RHS for the exchanged traces
+  rhsVolume(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, o_RHS, T);
+
+  // internal elements only read local traces, so they can be fully updated
+  if (mesh.NinternalElements)
+    volumeSurfaceUpdateKernel(mesh.NinternalElements,
+                              mesh.o_internalElementIds,
+                              mesh.o_vgeo,
+                              mesh.o_D,
+                              mesh.o_sgeo,
+                              mesh.o_LIFT,
+                              mesh.o_vmapM,
+                              mesh.o_vmapP,
+                              mesh.o_EToB,
+                              T,
+                              mesh.o_x,
+                              mesh.o_y,
+                              mesh.o_z,
+                              o_Q,
+                              dt, rka, rkb,
+                              o_RES,
+                              o_Qnext);
+
+  traceHalo.ExchangeFinish(o_Q, 1);
+
+  if (mesh.NhaloElements)
+    surfaceUpdateKernel(mesh.NhaloElements,
+                        mesh.o_haloElementIds,
+                        mesh.o_sgeo,
+                        mesh.o_LIFT,
+                        mesh.o_vmapM,
+                        mesh.o_vmapP,
+                        mesh.o_EToB,
+                        T,
+                        mesh.o_x,
+                        mesh.o_y,
+                        mesh.o_z,
+                        o_Q,
+                        dt, rka, rkb,
+                        o_RHS,
+                        o_RES,
+                        o_Qnext);
+}
+
+//evaluate ODE rhs = f(q,t) on multirate level
+void advection_t::rhsf_MR(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS,
+                          deviceMemory<dfloat>& o_fQM, const dfloat T, const int lev){
+
+  // extract q trace halo and start exchange
+  multirateTraceHalo[lev].ExchangeStart(o_fQM, 1);
+
+  // compute volume contribution to advection RHS
+  rhsVolume(mesh.mrNelements[lev], mesh.o_mrElements[lev], o_Q, o_RHS, T);
+
+  // complete trace halo exchange
+  multirateTraceHalo[lev].ExchangeFinish(o_fQM, 1);
+
+  // compute surface contribution to advection RHS
+  if (mesh.mrNelements[lev])
+    surfaceKernel(mesh.mrNelements[lev],
+                  mesh.o_mrElements[lev],
+                  mesh.o_sgeo,
+                  mesh.o_LIFT,
+                  mesh.o_vmapM,
+                  mesh.o_mapP,
+                  mesh.o_EToB,
+                  T,
+                  mesh.o_x,
+                  mesh.o_y,
+                  mesh.o_z,
+                  o_fQM,
+                  o_RHS);
+}
+
+void advection_t::rhsVolume(dlong N, deviceMemory<dlong>& o_ids,
+                            deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS,
+                            const dfloat T){
+
+  // compute volume contribution to advection RHS
+  if (N)
+    volumeKernel(N,
+                 o_ids,
+                 mesh.o_vgeo,
+                 mesh.o_D,
+                 T,
+                 mesh.o_x,
+                 mesh.o_y,
+                 mesh.o_z,
+                 o_Q,
+                 o_RHS);
+}
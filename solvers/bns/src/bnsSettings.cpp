@@ -68,6 +68,11 @@ bnsSettings_t::bnsSettings_t(comm_t& _comm):
              "Time integration method",
              {"AB3", "SAAB3", "DOPRI5", "LSERK4", "SARK4", "SARK5", "MRAB3", "MRSAAB3"});
 
+  newSetting("RELAXATION OPERATOR",
+             "DIAGONAL",
+             "Form of the relaxation operator passed to semi-analytic integrators",
+             {"DIAGONAL", "MATRIX"});
+
   newSetting("CFL NUMBER",
              "1.0",
              "Multiplier for timestep stability bound");
@@ -106,6 +111,11 @@ void bnsSettings_t::report() {
     reportSetting("PML SIGMAZ MAX");
     reportSetting("PML INTEGRATION");
     reportSetting("TIME INTEGRATOR");
+    if (compareSetting("TIME INTEGRATOR","SAAB3")
+      ||compareSetting("TIME INTEGRATOR","SARK4")
+      ||compareSetting("TIME INTEGRATOR","SARK5")
+      ||compareSetting("TIME INTEGRATOR","MRSAAB3"))
+      reportSetting("RELAXATION OPERATOR");
     reportSetting("START TIME");
     reportSetting("FINAL TIME");
     reportSetting("OUTPUT INTERVAL");
@@ -63,10 +63,15 @@ void bns_t::Setup(platform_t& _platform, mesh_t& _mesh,
     ||settings.compareSetting("TIME INTEGRATOR","MRSAAB3"))
     semiAnalytic = 1;
 
-  //semi-analytic exponential coefficients
-  memory<dfloat> lambda(Nfields);
-  for (int i=0;i<mesh.dim+1;i++) lambda[i] = 0.0;
-  for (int i=mesh.dim+1;i<Nfields;i++) lambda[i] = -tauInv;
+  //semi-analytic relaxation operator, only the non-equilibrium moments relax
+  memory<dfloat> lambda;
+  if (settings.compareSetting("RELAXATION OPERATOR","MATRIX")) {
+    lambda.malloc(Nfields*Nfields, 0.0);
+    for (int i=mesh.dim+1;i<Nfields;i++) lambda[i*Nfields+i] = -tauInv;
+  } else {
+    lambda.malloc(Nfields, 0.0);
+    for (int i=mesh.dim+1;i<Nfields;i++) lambda[i] = -tauInv;
+  }
 
   //make array of time step estimates for each element
   memory<dfloat> EtoDT(mesh.Nelements);
@@ -108,7 +113,7 @@ void bns_t::Setup(platform_t& _platform, mesh_t& _mesh,
   mesh.mrNlevels=0;
   if (settings.compareSetting("TIME INTEGRATOR","MRAB3") ||
       settings.compareSetting("TIME INTEGRATOR","MRSAAB3")) {
-    mesh.MultiRateSetup(EtoDT);
+    mesh.MultiRateSetup(EtoDT, Nfields);
     mesh.MultiRatePmlSetup();
     multirateTraceHalo = mesh.MultiRateHaloTraceSetup(Nfields);
   }
@@ -33,6 +33,9 @@ SOFTWARE.
 #include "solver.hpp"
 #include "timeStepper.hpp"
 #include "linAlg.hpp"
+#include "timer.hpp"
+#include "linearSolver.hpp"
+#include "elliptic.hpp"
 
 #define DCNS LIBP_DIR"/solvers/cns/"
 
@@ -45,6 +48,8 @@ public:
   void parseFromFile(platformSettings_t& platformSettings,
                      meshSettings_t& meshSettings,
                      const std::string filename);
+
+  ellipticSettings_t extractViscousSettings();
 };
 
 class cns_t: public solver_t {
@@ -62,8 +67,16 @@ public:
 
   timeStepper_t timeStepper;
 
+  //dynamic load rebalancing
+  int rebalance;
+  int rebalanceInterval;
+  int rebalanceSteps=0;
+  dfloat rebalanceThreshold;
+  double workTime=0.0;
+
   ogs::halo_t fieldTraceHalo;
   ogs::halo_t gradTraceHalo;
+  memory<ogs::halo_t> multirateTraceHalo;
 
   memory<dfloat> q;
   deviceMemory<dfloat> o_q;
@@ -76,6 +89,9 @@ public:
 
   deviceMemory<dfloat> o_Mq;
 
+  //volume-ordered copy of the multirate trace buffer
+  deviceMemory<dfloat> o_qTrace;
+
   kernel_t volumeKernel;
   kernel_t surfaceKernel;
   kernel_t cubatureVolumeKernel;
@@ -88,9 +104,33 @@ public:
 
   kernel_t constrainKernel;
 
+  kernel_t traceScatterKernel;
+
   kernel_t initialConditionKernel;
   kernel_t maxWaveSpeedKernel;
 
+  //implicit-explicit stepping of the viscous terms
+  int imex;
+  dfloat newtonTOL, krylovTOL;
+  int newtonMaxIter, krylovMaxIter;
+  int NiterNewton=0, NiterKrylov=0;
+
+  elliptic_t viscSolver;
+  linearSolver_t newtonLinearSolver;
+
+  deviceMemory<dfloat> o_imexRhs;
+  deviceMemory<dfloat> o_newtonR;
+  deviceMemory<dfloat> o_newtonDq;
+  deviceMemory<dfloat> o_newtonGq;
+  deviceMemory<dfloat> o_jacq;
+  deviceMemory<dfloat> o_jacGq;
+  deviceMemory<dfloat> o_precMr;
+  deviceMemory<dfloat> o_viscR;
+  deviceMemory<dfloat> o_viscZ;
+
+  kernel_t extractFieldKernel;
+  kernel_t insertFieldKernel;
+
   cns_t() = default;
   cns_t(platform_t &_platform, mesh_t &_mesh,
               cnsSettings_t& _settings) {
@@ -109,7 +149,44 @@ public:
 
   void rhsf(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
 
+  void rhsf_MR(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs,
+               deviceMemory<dfloat>& o_fQM, const dfloat time, const int level);
+
+  void rhs_imex_f(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
+
+  void rhs_imex_g(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
+
+  void rhs_imex_invg(deviceMemory<dfloat>& o_rhs, deviceMemory<dfloat>& o_q, const dfloat imexGamma, const dfloat time);
+
+  //rhs with the given viscosity, zero giving the inviscid part
+  void Rhs(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time, const dfloat viscosity);
+
+  void rhsGradVolume(dlong N, deviceMemory<dlong>& o_ids, deviceMemory<dfloat>& o_q);
+
+  void rhsGradSurface(dlong N, deviceMemory<dlong>& o_ids, deviceMemory<dfloat>& o_q,
+                      const dfloat time, const dfloat viscosity);
+
+  void rhsVolume(dlong N, deviceMemory<dlong>& o_ids, deviceMemory<dfloat>& o_q,
+                 const dfloat time, const dfloat viscosity, deviceMemory<dfloat>& o_rhs);
+
+  void rhsSurface(dlong N, deviceMemory<dlong>& o_ids, deviceMemory<dfloat>& o_q,
+                  const dfloat time, const dfloat viscosity, deviceMemory<dfloat>& o_rhs);
+
+  void ImexSetup(cnsSettings_t& _settings);
+
   dfloat MaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T);
+
+  void ElementMaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T,
+                           deviceMemory<dfloat>& o_maxSpeed);
+
+  dfloat MaxTimeStep(deviceMemory<dfloat>& o_Q, const dfloat T);
+
+  //per-element time step estimates for multirate stepping
+  void ElementTimeSteps(deviceMemory<dfloat>& o_Q, const dfloat T, memory<dfloat>& EToDT);
+
+  bool Rebalance(deviceMemory<dfloat>& o_Q, dlong& Nelements, dlong& NhaloElements) override;
+
+  void Migrate(deviceMemory<dfloat>& o_data, const int Nentries) override;
 };
 
 #endif
@@ -0,0 +1,217 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "cns.hpp"
+
+namespace {
+
+//Matrix-free Jacobian of q -> gamma*q - G(q), by a finite difference of G
+class cnsJacobian_t: public operator_t {
+  cns_t& cns;
+  deviceMemory<dfloat>& o_q;
+  deviceMemory<dfloat>& o_Gq;
+  const dfloat gamma, time, qnorm;
+
+public:
+  cnsJacobian_t(cns_t& _cns, deviceMemory<dfloat>& _o_q, deviceMemory<dfloat>& _o_Gq,
+                const dfloat _gamma, const dfloat _time, const dfloat _qnorm):
+    cns(_cns), o_q(_o_q), o_Gq(_o_Gq), gamma(_gamma), time(_time), qnorm(_qnorm) {}
+
+  void Operator(deviceMemory<dfloat>& o_v, deviceMemory<dfloat>& o_Jv) override {
+    linAlg_t& linAlg = cns.platform.linAlg();
+    const dlong N = cns.mesh.Nelements*cns.mesh.Np*cns.Nfields;
+
+    const dfloat vnorm = linAlg.norm2(N, o_v, cns.comm);
+    if (vnorm==0.0) {
+      linAlg.set(N, 0.0, o_Jv);
+      return;
+    }
+
+    //perturbation size balancing truncation and round-off
+    const dfloat eps = std::sqrt(std::numeric_limits<dfloat>::epsilon())*(1.0+qnorm)/vnorm;
+
+    // G(q+eps*v)
+    linAlg.zaxpy(N, 1.0, o_q, eps, o_v, cns.o_jacq);
+    cns.rhs_imex_g(cns.o_jacq, cns.o_jacGq, time);
+
+    // Jv = gamma*v - (G(q+eps*v)-G(q))/eps
+    linAlg.zaxpy(N, -1.0/eps, cns.o_jacGq, 1.0/eps, o_Gq, o_Jv);
+    linAlg.axpy(N, gamma, o_v, 1.0, o_Jv);
+  }
+};
+
+//Frozen-coefficient preconditioner: each momentum and energy field is
+// treated as gamma*u - mu*Laplacian(u) and inverted with the viscous
+// elliptic preconditioner, the density block is gamma*I
+class cnsImexPrecon_t: public operator_t {
+  cns_t& cns;
+  const dfloat gamma;
+
+public:
+  cnsImexPrecon_t(cns_t& _cns, const dfloat _gamma):
+    cns(_cns), gamma(_gamma) {}
+
+  void Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_z) override {
+    linAlg_t& linAlg = cns.platform.linAlg();
+    const dlong N = cns.mesh.Nelements*cns.mesh.Np*cns.Nfields;
+
+    linAlg.axpy(N, 1.0/gamma, o_r, 0.0, o_z);
+
+    if (cns.viscSolver.settings.compareSetting("PRECONDITIONER","NONE")) return;
+
+    //weak form: (gamma/mu*M + S) u = M*r/mu
+    cns.mesh.MassMatrixApply(o_r, cns.o_precMr);
+
+    for (int fld=1;fld<cns.Nfields;++fld) {
+      cns.extractFieldKernel(cns.mesh.Nelements, fld, cns.o_precMr, cns.o_viscR);
+      cns.viscSolver.precon.Operator(cns.o_viscR, cns.o_viscZ);
+      cns.insertFieldKernel(cns.mesh.Nelements, fld, 1.0/cns.mu, cns.o_viscZ, o_z);
+    }
+  }
+};
+
+} //namespace
+
+//inviscid part of the rhs, treated explicitly
+void cns_t::rhs_imex_f(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, const dfloat T){
+  Rhs(o_Q, o_RHS, T, 0.0);
+}
+
+//viscous part of the rhs, treated implicitly
+void cns_t::rhs_imex_g(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, const dfloat T){
+  const dlong N = mesh.Nelements*mesh.Np*Nfields;
+
+  //the flux kernels are affine in the viscosity, so G = rhs(mu) - rhs(0)
+  Rhs(o_Q, o_RHS, T, mu);
+  Rhs(o_Q, o_imexRhs, T, 0.0);
+  platform.linAlg().axpy(N, -1.0, o_imexRhs, 1.0, o_RHS);
+}
+
+//  Solves gamma*q - G(q) = rhs by Jacobian-free Newton-Krylov
+void cns_t::rhs_imex_invg(deviceMemory<dfloat>& o_RHS, deviceMemory<dfloat>& o_Q,
+                          const dfloat imexGamma, const dfloat T){
+
+  linAlg_t& linAlg = platform.linAlg();
+  const dlong N = mesh.Nelements*mesh.Np*Nfields;
+
+  const dfloat rhsNorm = linAlg.norm2(N, o_RHS, comm);
+  const dfloat TOL = newtonTOL*std::max(rhsNorm, static_cast<dfloat>(1.0));
+
+  //the step size, and with it lambda, changes during adaptive stepping
+  viscSolver.lambda = imexGamma/mu;
+  viscSolver.PreconUpdate();
+
+  cnsImexPrecon_t precon(*this, imexGamma);
+
+  NiterNewton = 0;
+  NiterKrylov = 0;
+
+  //o_Q holds the initial guess
+  for (int it=0;it<=newtonMaxIter;++it) {
+    // R = rhs - gamma*q + G(q)
+    rhs_imex_g(o_Q, o_newtonGq, T);
+    linAlg.zaxpy(N, -imexGamma, o_Q, 1.0, o_RHS, o_newtonR);
+    linAlg.axpy(N, 1.0, o_newtonGq, 1.0, o_newtonR);
+
+    const dfloat rnorm = linAlg.norm2(N, o_newtonR, comm);
+    if (rnorm<=TOL) break;
+
+    LIBP_ABORT("Newton iteration did not converge, residual = " << rnorm,
+               it==newtonMaxIter);
+
+    //scale so the preconditioned residual is O(1), as GMRES mixes
+    // absolute and relative tolerances
+    const dfloat scale = imexGamma/rnorm;
+    linAlg.scale(N, scale, o_newtonR);
+
+    const dfloat qnorm = linAlg.norm2(N, o_Q, comm);
+    cnsJacobian_t jacobian(*this, o_Q, o_newtonGq, imexGamma, T, qnorm);
+
+    NiterKrylov += newtonLinearSolver.Solve(jacobian, precon, o_newtonDq, o_newtonR,
+                                            krylovTOL, krylovMaxIter, 0);
+
+    // q += dq
+    linAlg.axpy(N, 1.0/scale, o_newtonDq, 1.0, o_Q);
+    NiterNewton++;
+  }
+}
+
+void cns_t::ImexSetup(cnsSettings_t& _settings){
+
+  imex = 1;
+
+  LIBP_ABORT("Implicit-explicit stepping requires VISCOSITY > 0",
+             mu<=0.0);
+  LIBP_ABORT("Implicit-explicit stepping does not support dynamic rebalancing",
+             rebalance);
+
+  settings.getSetting("NEWTON TOLERANCE", newtonTOL);
+  settings.getSetting("NEWTON MAX ITERATIONS", newtonMaxIter);
+  settings.getSetting("NEWTON KRYLOV TOLERANCE", krylovTOL);
+  settings.getSetting("NEWTON KRYLOV MAX ITERATIONS", krylovMaxIter);
+
+  platform.linAlg().InitKernels({"set", "scale", "axpy", "zaxpy", "norm2"});
+
+  dlong Nlocal = mesh.Nelements*mesh.Np*Nfields;
+  dlong Nhalo  = mesh.totalHaloPairs*mesh.Np*Nfields;
+
+  o_imexRhs   = platform.malloc<dfloat>(Nlocal);
+  o_newtonR   = platform.malloc<dfloat>(Nlocal+Nhalo);
+  o_newtonDq  = platform.malloc<dfloat>(Nlocal+Nhalo);
+  o_newtonGq  = platform.malloc<dfloat>(Nlocal);
+  o_jacq      = platform.malloc<dfloat>(Nlocal+Nhalo);
+  o_jacGq     = platform.malloc<dfloat>(Nlocal);
+  o_precMr    = platform.malloc<dfloat>(Nlocal);
+
+  newtonLinearSolver.Setup<LinearSolver::pgmres>(Nlocal, Nhalo, platform, settings, comm);
+  newtonLinearSolver.SetupInitialGuess<InitialGuess::Zero>(Nlocal, platform, settings, comm);
+
+  //scalar elliptic problem gamma/mu*u - Laplacian(u) for the preconditioner,
+  // with walls and inflows Dirichlet and outflows Neumann
+  const int NBCTypes = 7;
+  memory<int> BCType(NBCTypes);
+  BCType[0] = 0;
+  BCType[1] = 1;
+  BCType[2] = 1;
+  BCType[3] = 2;
+  BCType[4] = 1;
+  BCType[5] = 1;
+  BCType[6] = 1;
+
+  ellipticSettings_t viscSettings = _settings.extractViscousSettings();
+
+  //lambda from the convective step size, since the adaptive step is not known
+  // yet. Each stage solve updates the preconditioner for its actual step
+  dfloat hmin = mesh.MinCharacteristicLength();
+  dfloat dtAdv = hmin/((mesh.N+1.)*(mesh.N+1.));
+  dfloat lambda = 1.0/(timeStepper.GetGamma()*dtAdv*mu);
+  viscSolver.Setup(platform, mesh, viscSettings,
+                   lambda, NBCTypes, BCType);
+
+  o_viscR = platform.malloc<dfloat>(viscSolver.Ndofs+viscSolver.Nhalo);
+  o_viscZ = platform.malloc<dfloat>(viscSolver.Ndofs+viscSolver.Nhalo);
+}
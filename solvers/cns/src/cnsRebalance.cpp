@@ -0,0 +1,82 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "cns.hpp"
+
+//repartition the mesh when rank work has become imbalanced
+bool cns_t::Rebalance(deviceMemory<dfloat>& o_Q, dlong& Nelements, dlong& NhaloElements){
+
+  if (!rebalance) return false;
+  if (++rebalanceSteps < rebalanceInterval) return false;
+
+  const double stepTime = workTime/rebalanceSteps;
+  rebalanceSteps = 0;
+  workTime = 0.0;
+
+  const dfloat imbalance = mesh.LoadImbalance(stepTime);
+  if (imbalance < rebalanceThreshold) return false;
+
+  //elements on a rank are assumed to cost the same, so slow ranks shed elements
+  memory<dfloat> weights(mesh.Nelements, stepTime/std::max(mesh.Nelements, 1));
+
+  mesh.Rebalance(weights);
+
+  //migrate solution
+  mesh.Migrate(o_Q, mesh.Np*Nfields, mesh.totalHaloPairs);
+
+  /*setup trace halo exchange */
+  fieldTraceHalo = mesh.HaloTraceSetup(Nfields);
+  gradTraceHalo  = mesh.HaloTraceSetup(Ngrads);
+
+  //resize work arrays
+  dlong NlocalFields = mesh.Nelements*mesh.Np*Nfields;
+  dlong NhaloFields  = mesh.totalHaloPairs*mesh.Np*Nfields;
+  dlong NlocalGrads = mesh.Nelements*mesh.Np*Ngrads;
+  dlong NhaloGrads  = mesh.totalHaloPairs*mesh.Np*Ngrads;
+
+  q.malloc(NlocalFields+NhaloFields);
+
+  gradq.malloc(NlocalGrads+NhaloGrads);
+  o_gradq = platform.malloc<dfloat>(gradq);
+
+  Vort.malloc(mesh.dim*mesh.Nelements*mesh.Np);
+  o_Vort = platform.malloc<dfloat>(Vort);
+
+  o_Mq = platform.malloc<dfloat>(q);
+
+  if (mesh.rank==0)
+    printf("Rebalanced mesh, load imbalance was %5.2f\n", imbalance);
+
+  Nelements = mesh.Nelements;
+  NhaloElements = mesh.totalHaloPairs;
+  return true;
+}
+
+//migrate time stepper data to follow the last rebalance
+void cns_t::Migrate(deviceMemory<dfloat>& o_data, const int Nentries){
+  mesh.Migrate(o_data, Nentries);
+}
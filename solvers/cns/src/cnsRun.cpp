@@ -41,17 +41,8 @@ void cns_t::Run(){
                          mesh.o_z,
                          o_q);
 
-  dfloat cfl=1.0;
-  settings.getSetting("CFL NUMBER", cfl);
-
   // set time step
-  dfloat hmin = mesh.MinCharacteristicLength();
-  dfloat vmax = MaxWaveSpeed(o_q, startTime);
-
-  dfloat dtAdv  = cfl/(vmax*(mesh.N+1.)*(mesh.N+1.));
-  dfloat dtVisc = cfl*pow(hmin, 2)/(pow(mesh.N+1,4)*mu);
-
-  dfloat dt = std::min(dtAdv, dtVisc);
+  dfloat dt = MaxTimeStep(o_q, startTime);
   timeStepper.SetTimeStep(dt);
 
   timeStepper.Run(*this, o_q, startTime, finalTime);
@@ -69,3 +60,50 @@ void cns_t::Run(){
   }
 
 }
+
+dfloat cns_t::MaxTimeStep(deviceMemory<dfloat>& o_Q, const dfloat T){
+
+  dfloat cfl=1.0;
+  settings.getSetting("CFL NUMBER", cfl);
+
+  //multirate levels were built from the per-element estimates
+  if (mesh.mrNlevels) {
+    memory<dfloat> EToDT;
+    ElementTimeSteps(o_Q, T, EToDT);
+
+    dfloat dtmin = std::numeric_limits<dfloat>::max();
+    for(dlong e=0;e<mesh.Nelements;++e)
+      dtmin = std::min(dtmin, EToDT[e]);
+    mesh.comm.Allreduce(dtmin, Comm::Min);
+
+    return cfl*dtmin;
+  }
+
+  dfloat hmin = mesh.MinCharacteristicLength();
+  dfloat vmax = MaxWaveSpeed(o_Q, T);
+
+  dfloat dtAdv  = cfl/(vmax*(mesh.N+1.)*(mesh.N+1.));
+  dfloat dtVisc = cfl*pow(hmin, 2)/(pow(mesh.N+1,4)*mu);
+
+  //viscous terms are implicit in IMEX stepping
+  if (imex) return dtAdv;
+
+  return std::min(dtAdv, dtVisc);
+}
+
+void cns_t::ElementTimeSteps(deviceMemory<dfloat>& o_Q, const dfloat T, memory<dfloat>& EToDT){
+
+  deviceMemory<dfloat> o_maxSpeed = platform.malloc<dfloat>(mesh.Nelements);
+  ElementMaxWaveSpeed(o_Q, T, o_maxSpeed);
+
+  memory<dfloat> maxSpeed(mesh.Nelements);
+  o_maxSpeed.copyTo(maxSpeed);
+
+  EToDT.malloc(mesh.Nelements);
+  for(dlong e=0;e<mesh.Nelements;++e){
+    const dfloat h = mesh.ElementCharacteristicLength(e);
+    EToDT[e] = h/(maxSpeed[e]*(mesh.N+1.)*(mesh.N+1.));
+    if (mu>0.0)
+      EToDT[e] = std::min(EToDT[e], h*h/(pow(mesh.N+1,4)*mu));
+  }
+}
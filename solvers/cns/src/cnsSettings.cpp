@@ -55,12 +55,37 @@ cnsSettings_t::cnsSettings_t(comm_t _comm):
   newSetting("TIME INTEGRATOR",
              "DOPRI5",
              "Time integration method",
-             {"AB3", "DOPRI5", "LSERK4"});
+             {"AB3", "DOPRI5", "LSERK4", "LSRK", "ARK3", "ARK4", "MRAB3"});
+
+  newSetting("LSRK TABLEAU",
+             "NDB144",
+             "Low-storage Runge-Kutta scheme (LSERK4, NDB124, NDB144, W3) or tableau file name");
 
   newSetting("CFL NUMBER",
              "1.0",
              "Multiplier for timestep stability bound");
 
+  newSetting("ADAPTIVE TIME STEP",
+             "FALSE",
+             "Recompute the AB3 time step from the stability bound every step",
+             {"TRUE", "FALSE"});
+
+  newSetting("NEWTON TOLERANCE",
+             "1.0e-6",
+             "Relative residual tolerance for the implicit ARK stage solves");
+
+  newSetting("NEWTON MAX ITERATIONS",
+             "10",
+             "Maximum Newton iterations per implicit ARK stage");
+
+  newSetting("NEWTON KRYLOV TOLERANCE",
+             "1.0e-2",
+             "Relative tolerance of the GMRES solve in each Newton iteration");
+
+  newSetting("NEWTON KRYLOV MAX ITERATIONS",
+             "200",
+             "Maximum GMRES iterations in each Newton iteration");
+
   newSetting("START TIME",
              "0",
              "Start time for time integration");
@@ -80,6 +105,10 @@ cnsSettings_t::cnsSettings_t(comm_t _comm):
 
   newSetting("OUTPUT FILE NAME",
              "cns");
+
+  //preconditioner of the implicit viscous solves
+  ellipticAddSettings(*this, "VISCOUS ");
+  parAlmond::AddSettings(*this, "VISCOUS ");
 }
 
 void cnsSettings_t::report() {
@@ -93,6 +122,22 @@ void cnsSettings_t::report() {
     reportSetting("ISOTHERMAL");
     reportSetting("ADVECTION TYPE");
     reportSetting("TIME INTEGRATOR");
+    if (compareSetting("TIME INTEGRATOR","LSRK"))
+      reportSetting("LSRK TABLEAU");
+    if (compareSetting("TIME INTEGRATOR","AB3"))
+      reportSetting("ADAPTIVE TIME STEP");
+    if (compareSetting("TIME INTEGRATOR","ARK3")
+        || compareSetting("TIME INTEGRATOR","ARK4")) {
+      reportSetting("NEWTON TOLERANCE");
+      reportSetting("NEWTON MAX ITERATIONS");
+      reportSetting("NEWTON KRYLOV TOLERANCE");
+      reportSetting("NEWTON KRYLOV MAX ITERATIONS");
+      reportSetting("VISCOUS PRECONDITIONER");
+      if (compareSetting("VISCOUS PRECONDITIONER","MULTIGRID")) {
+        reportSetting("VISCOUS MULTIGRID COARSENING");
+        reportSetting("VISCOUS MULTIGRID SMOOTHER");
+      }
+    }
     reportSetting("START TIME");
     reportSetting("FINAL TIME");
     reportSetting("OUTPUT INTERVAL");
@@ -123,3 +168,23 @@ void cnsSettings_t::parseFromFile(platformSettings_t& platformSettings,
     }
   }
 }
+
+ellipticSettings_t cnsSettings_t::extractViscousSettings() {
+
+  ellipticSettings_t viscousSettings(comm);
+
+  for(auto it = viscousSettings.settings.begin(); it != viscousSettings.settings.end(); ++it) {
+    setting_t& set = it->second;
+    const std::string name = set.getName();
+
+    std::string val;
+    getSetting("VISCOUS "+name, val);
+
+    set.updateVal(val);
+  }
+
+  //the preconditioner acts directly on the dG fields
+  viscousSettings.changeSetting("DISCRETIZATION", "IPDG");
+
+  return viscousSettings;
+}
@@ -55,6 +55,11 @@ void cns_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   if (!isothermal) Nfields++; //include energy equation
 
+  //check rank work for load imbalance during time stepping
+  rebalance = (mesh.settings.compareSetting("PARADOGS REBALANCING", "DYNAMIC")) ? 1:0;
+  mesh.settings.getSetting("PARADOGS REBALANCE INTERVAL", rebalanceInterval);
+  mesh.settings.getSetting("PARADOGS REBALANCE THRESHOLD", rebalanceThreshold);
+
   dlong NlocalFields = mesh.Nelements*mesh.Np*Nfields;
   dlong NhaloFields  = mesh.totalHaloPairs*mesh.Np*Nfields;
   dlong NlocalGrads = mesh.Nelements*mesh.Np*Ngrads;
@@ -69,12 +74,33 @@ void cns_t::Setup(platform_t& _platform, mesh_t& _mesh,
     timeStepper.Setup<TimeStepper::lserk4>(mesh.Nelements,
                                            mesh.totalHaloPairs,
                                            mesh.Np, Nfields, platform, comm);
+  } else if (settings.compareSetting("TIME INTEGRATOR","LSRK")){
+    std::string tableau;
+    settings.getSetting("LSRK TABLEAU", tableau);
+    timeStepper.Setup<TimeStepper::lsrk>(mesh.Nelements,
+                                         mesh.totalHaloPairs,
+                                         mesh.Np, Nfields, platform, comm,
+                                         tableau);
   } else if (settings.compareSetting("TIME INTEGRATOR","DOPRI5")){
     timeStepper.Setup<TimeStepper::dopri5>(mesh.Nelements,
                                            mesh.totalHaloPairs,
                                            mesh.Np, Nfields, platform, comm);
+  } else if (settings.compareSetting("TIME INTEGRATOR","ARK3")
+          || settings.compareSetting("TIME INTEGRATOR","ARK4")){
+    std::string scheme;
+    settings.getSetting("TIME INTEGRATOR", scheme);
+    timeStepper.Setup<TimeStepper::ark>(mesh.Nelements,
+                                        mesh.totalHaloPairs,
+                                        mesh.Np, Nfields, platform, comm,
+                                        scheme);
   }
 
+  imex = (settings.compareSetting("TIME INTEGRATOR","ARK3")
+          || settings.compareSetting("TIME INTEGRATOR","ARK4")) ? 1:0;
+
+  if (settings.compareSetting("ADAPTIVE TIME STEP","TRUE"))
+    timeStepper.EnableAdaptiveTimeStep();
+
   //setup linear algebra module
   platform.linAlg().InitKernels({"innerProd", "max"});
 
@@ -252,4 +278,57 @@ void cns_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   maxWaveSpeedKernel = platform.buildKernel(fileName, kernelName,
                                             kernelInfo);
+
+  if (imex) {
+    fileName   = oklFilePrefix + "cnsImexField" + oklFileSuffix;
+
+    kernelName = "cnsExtractField";
+    extractFieldKernel = platform.buildKernel(fileName, kernelName,
+                                              kernelInfo);
+
+    kernelName = "cnsInsertField";
+    insertFieldKernel = platform.buildKernel(fileName, kernelName,
+                                             kernelInfo);
+
+    ImexSetup(_settings);
+  }
+
+  mesh.mrNlevels=0;
+  if (settings.compareSetting("TIME INTEGRATOR","MRAB3")) {
+    LIBP_ABORT("MRAB3 is not supported with cubature",
+               cubature);
+    LIBP_ABORT("MRAB3 is not supported with dynamic rebalancing",
+               rebalance);
+
+    dfloat startTime;
+    settings.getSetting("START TIME", startTime);
+
+    //sample the wave speed of the initial condition in each element
+    initialConditionKernel(mesh.Nelements,
+                           mu,
+                           gamma,
+                           startTime,
+                           mesh.o_x,
+                           mesh.o_y,
+                           mesh.o_z,
+                           o_q);
+
+    memory<dfloat> EToDT;
+    ElementTimeSteps(o_q, startTime, EToDT);
+
+    mesh.MultiRateSetup(EToDT, Nfields);
+    multirateTraceHalo = mesh.MultiRateHaloTraceSetup(Nfields);
+
+    timeStepper.Setup<TimeStepper::mrab3>(mesh.Nelements,
+                                          mesh.totalHaloPairs,
+                                          mesh.Np, Nfields, platform, mesh);
+
+    o_qTrace = platform.malloc<dfloat>(NlocalFields+NhaloFields);
+
+    fileName   = oklFilePrefix + "cnsMultirateTrace" + oklFileSuffix;
+    kernelName = "cnsMultirateTraceScatter";
+
+    traceScatterKernel = platform.buildKernel(fileName, kernelName,
+                                              kernelInfo);
+  }
 }
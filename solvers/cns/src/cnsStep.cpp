@@ -31,6 +31,16 @@ dfloat cns_t::MaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T){
   //Note: if this is on the critical path in the future, we should pre-allocate this
   deviceMemory<dfloat> o_maxSpeed = platform.malloc<dfloat>(mesh.Nelements);
 
+  ElementMaxWaveSpeed(o_Q, T, o_maxSpeed);
+
+  const dfloat vmax = platform.linAlg().max(mesh.Nelements, o_maxSpeed, mesh.comm);
+
+  return vmax;
+}
+
+void cns_t::ElementMaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T,
+                                deviceMemory<dfloat>& o_maxSpeed){
+
   maxWaveSpeedKernel(mesh.Nelements,
                      mesh.o_vgeo,
                      mesh.o_sgeo,
@@ -44,43 +54,40 @@ dfloat cns_t::MaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T){
                      mesh.o_z,
                      o_Q,
                      o_maxSpeed);
-
-  const dfloat vmax = platform.linAlg().max(mesh.Nelements, o_maxSpeed, mesh.comm);
-
-  return vmax;
 }
 
 //evaluate ODE rhs = f(q,t)
 void cns_t::rhsf(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, const dfloat T){
+  Rhs(o_Q, o_RHS, T, mu);
+}
+
+//evaluate the rhs with the given viscosity
+void cns_t::Rhs(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, const dfloat T,
+                const dfloat viscosity){
+
+  // time local work, excluding halo exchange waits, for load rebalancing
+  timePoint_t workStart;
+  if (rebalance) workStart = PlatformTime(platform);
 
   // extract q trace halo and start exchange
   fieldTraceHalo.ExchangeStart(o_Q, 1);
 
   // compute volume contributions to gradients
-  gradVolumeKernel(mesh.Nelements,
-                   mesh.o_vgeo,
-                   mesh.o_D,
-                   o_Q,
-                   o_gradq);
+  rhsGradVolume(mesh.NinternalElements, mesh.o_internalElementIds, o_Q);
+  rhsGradVolume(mesh.NhaloElements, mesh.o_haloElementIds, o_Q);
+
+  // internal elements only read local traces
+  rhsGradSurface(mesh.NinternalElements, mesh.o_internalElementIds, o_Q, T, viscosity);
+
+  if (rebalance) workTime += ElapsedTime(workStart, PlatformTime(platform));
 
   // complete trace halo exchange
   fieldTraceHalo.ExchangeFinish(o_Q, 1);
 
+  if (rebalance) workStart = PlatformTime(platform);
+
   // compute surface contributions to gradients
-  gradSurfaceKernel(mesh.Nelements,
-                    mesh.o_sgeo,
-                    mesh.o_LIFT,
-                    mesh.o_vmapM,
-                    mesh.o_vmapP,
-                    mesh.o_EToB,
-                    mesh.o_x,
-                    mesh.o_y,
-                    mesh.o_z,
-                    T,
-                    mu,
-                    gamma,
-                    o_Q,
-                    o_gradq);
+  rhsGradSurface(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, T, viscosity);
 
   // extract viscousStresses trace halo and start exchange
   gradTraceHalo.ExchangeStart(o_gradq, 1);
@@ -98,62 +105,168 @@ void cns_t::rhsf(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, const d
                          mesh.o_y,
                          mesh.o_z,
                          T,
-                         mu,
+                         viscosity,
                          gamma,
                          o_Q,
                          o_gradq,
                          o_RHS);
   } else {
-    volumeKernel(mesh.Nelements,
+    rhsVolume(mesh.NinternalElements, mesh.o_internalElementIds, o_Q, T, viscosity, o_RHS);
+    rhsVolume(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, T, viscosity, o_RHS);
+
+    // all neighbours of internal elements have their gradients already
+    rhsSurface(mesh.NinternalElements, mesh.o_internalElementIds, o_Q, T, viscosity, o_RHS);
+  }
+
+  if (rebalance) workTime += ElapsedTime(workStart, PlatformTime(platform));
+
+  // complete trace halo exchange
+  gradTraceHalo.ExchangeFinish(o_gradq, 1);
+
+  if (rebalance) workStart = PlatformTime(platform);
+
+  if (cubature) {
+    cubatureSurfaceKernel(mesh.Nelements,
+                          mesh.o_vgeo,
+                          mesh.o_cubsgeo,
+                          mesh.o_vmapM,
+                          mesh.o_vmapP,
+                          mesh.o_EToB,
+                          mesh.o_intInterp,
+                          mesh.o_intLIFT,
+                          mesh.o_intx,
+                          mesh.o_inty,
+                          mesh.o_intz,
+                          T,
+                          viscosity,
+                          gamma,
+                          o_Q,
+                          o_gradq,
+                          o_RHS);
+  } else {
+    rhsSurface(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, T, viscosity, o_RHS);
+  }
+
+  if (rebalance) workTime += ElapsedTime(workStart, PlatformTime(platform));
+}
+
+//evaluate ODE rhs = f(q,t) on multirate level
+void cns_t::rhsf_MR(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS,
+                    deviceMemory<dfloat>& o_fQM, const dfloat T, const int lev){
+
+  const dlong N = mesh.mrNelements[lev];
+
+  // extract q trace halo and start exchange
+  multirateTraceHalo[lev].ExchangeStart(o_fQM, 1);
+
+  // compute volume contributions to gradients
+  rhsGradVolume(N, mesh.o_mrElements[lev], o_Q);
+
+  // complete trace halo exchange
+  multirateTraceHalo[lev].ExchangeFinish(o_fQM, 1);
+
+  // unpack the traces of the active elements and their neighbours
+  if (N)
+    traceScatterKernel(N,
+                       mesh.o_mrElements[lev],
+                       mesh.o_vmapM,
+                       mesh.o_vmapP,
+                       mesh.o_mapP,
+                       o_fQM,
+                       o_qTrace);
+
+  // compute surface contributions to gradients
+  rhsGradSurface(N, mesh.o_mrElements[lev], o_qTrace, T, mu);
+
+  // inactive elements keep the gradients of their last rhs evaluation,
+  // so the viscous flux on a level interface lags by at most one coarse step
+  gradTraceHalo.ExchangeStart(o_gradq, 1);
+
+  // compute volume contribution to cns RHS
+  rhsVolume(N, mesh.o_mrElements[lev], o_Q, T, mu, o_RHS);
+
+  // complete trace halo exchange
+  gradTraceHalo.ExchangeFinish(o_gradq, 1);
+
+  // compute surface contribution to cns RHS
+  rhsSurface(N, mesh.o_mrElements[lev], o_qTrace, T, mu, o_RHS);
+}
+
+void cns_t::rhsGradVolume(dlong N, deviceMemory<dlong>& o_ids,
+                          deviceMemory<dfloat>& o_Q){
+
+  if (N)
+    gradVolumeKernel(N,
+                     o_ids,
+                     mesh.o_vgeo,
+                     mesh.o_D,
+                     o_Q,
+                     o_gradq);
+}
+
+void cns_t::rhsGradSurface(dlong N, deviceMemory<dlong>& o_ids,
+                           deviceMemory<dfloat>& o_Q,
+                           const dfloat T, const dfloat viscosity){
+
+  if (N)
+    gradSurfaceKernel(N,
+                      o_ids,
+                      mesh.o_sgeo,
+                      mesh.o_LIFT,
+                      mesh.o_vmapM,
+                      mesh.o_vmapP,
+                      mesh.o_EToB,
+                      mesh.o_x,
+                      mesh.o_y,
+                      mesh.o_z,
+                      T,
+                      viscosity,
+                      gamma,
+                      o_Q,
+                      o_gradq);
+}
+
+void cns_t::rhsVolume(dlong N, deviceMemory<dlong>& o_ids,
+                      deviceMemory<dfloat>& o_Q,
+                      const dfloat T, const dfloat viscosity,
+                      deviceMemory<dfloat>& o_RHS){
+
+  if (N)
+    volumeKernel(N,
+                 o_ids,
                  mesh.o_vgeo,
                  mesh.o_D,
                  mesh.o_x,
                  mesh.o_y,
                  mesh.o_z,
                  T,
-                 mu,
+                 viscosity,
                  gamma,
                  o_Q,
                  o_gradq,
                  o_RHS);
-  }
+}
 
-  // complete trace halo exchange
-  gradTraceHalo.ExchangeFinish(o_gradq, 1);
+void cns_t::rhsSurface(dlong N, deviceMemory<dlong>& o_ids,
+                       deviceMemory<dfloat>& o_Q,
+                       const dfloat T, const dfloat viscosity,
+                       deviceMemory<dfloat>& o_RHS){
 
-  if (cubature) {
-      cubatureSurfaceKernel(mesh.Nelements,
-                            mesh.o_vgeo,
-                            mesh.o_cubsgeo,
-                            mesh.o_vmapM,
-                            mesh.o_vmapP,
-                            mesh.o_EToB,
-                            mesh.o_intInterp,
-                            mesh.o_intLIFT,
-                            mesh.o_intx,
-                            mesh.o_inty,
-                            mesh.o_intz,
-                            T,
-                            mu,
-                            gamma,
-                            o_Q,
-                            o_gradq,
-                            o_RHS);
-    } else {
-      surfaceKernel(mesh.Nelements,
-                    mesh.o_sgeo,
-                    mesh.o_LIFT,
-                    mesh.o_vmapM,
-                    mesh.o_vmapP,
-                    mesh.o_EToB,
-                    mesh.o_x,
-                    mesh.o_y,
-                    mesh.o_z,
-                    T,
-                    mu,
-                    gamma,
-                    o_Q,
-                    o_gradq,
-                    o_RHS);
-    }
+  if (N)
+    surfaceKernel(N,
+                  o_ids,
+                  mesh.o_sgeo,
+                  mesh.o_LIFT,
+                  mesh.o_vmapM,
+                  mesh.o_vmapP,
+                  mesh.o_EToB,
+                  mesh.o_x,
+                  mesh.o_y,
+                  mesh.o_z,
+                  T,
+                  viscosity,
+                  gamma,
+                  o_Q,
+                  o_gradq,
+                  o_RHS);
 }
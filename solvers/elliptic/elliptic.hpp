@@ -60,13 +60,47 @@ public:
   dlong Ndofs, Nhalo;
   int Nfields;
 
+  //size of the vectors handed to the Krylov solver
+  // (skeleton dofs only when static condensation is on)
+  dlong NsolveDofs, NsolveHalo;
+
   dfloat lambda;
   dfloat tau;
 
   int disc_ipdg, disc_c0;
 
+  //over-integrated continuous Ax (hexes only)
+  int cubatureAx;
+
   deviceMemory<dfloat> o_AqL;
 
+  //static condensation of element interiors (continuous hexes only)
+  int staticCondensation;
+  int Ninterior;         // interior nodes per element
+  dlong Nskeleton;       // gathered skeleton dofs on this rank
+  dlong Naffine;         // box elements, ordered first, solved by fast diagonalization
+  dfloat condensedLambda;
+  ogs::ogs_t ogsSkeleton;
+  ogs::halo_t skeletonHalo;
+  dlong NskeletonHalo;   // skeleton halo, grown to the AMG's if needed
+  memory<hlong> skeletonGlobalNumbering; // -1 on interior and masked nodes
+  parAlmond::parAlmond_t condensedAMG;   // AMG on the assembled Schur complement
+  memory<dlong> condensedElements;  // affine elements first, then curved
+  memory<dfloat> interiorMu;        // 1D interior eigenvalues
+  memory<dfloat> interiorScale;     // x/y/z stiffness and mass scales of each box
+  deviceMemory<dlong> o_SkeletonToLocal;
+  deviceMemory<dlong> o_interiorIds;
+  deviceMemory<dfloat> o_interiorS, o_interiorSinv, o_interiorInvL;
+  deviceMemory<dfloat> o_invAii;
+  deviceMemory<dfloat> o_invDiagS;
+  deviceMemory<dfloat> o_qI, o_AqI;
+  deviceMemory<dfloat> o_qL, o_condRL, o_AqIL;
+  deviceMemory<dfloat> o_rS, o_xS;
+  kernel_t condensedGatherKernel;
+  kernel_t condensedScatterKernel;
+  kernel_t interiorFDMKernel;
+  kernel_t localAxKernel;
+
   ogs::halo_t traceHalo;
 
   precon_t precon;
@@ -105,6 +139,7 @@ public:
   kernel_t partialAxKernel;
   kernel_t partialGradientKernel;
   kernel_t partialIpdgKernel;
+  kernel_t operatorDiagonalKernel;
 
   elliptic_t() = default;
   elliptic_t(platform_t &_platform, mesh_t &_mesh,
@@ -125,19 +160,50 @@ public:
   int Solve(linearSolver_t& linearSolver, deviceMemory<dfloat> &o_x, deviceMemory<dfloat> &o_r,
             const dfloat tol, const int MAXIT, const int verbose);
 
+  int SolveCondensed(linearSolver_t& linearSolver, deviceMemory<dfloat> &o_x, deviceMemory<dfloat> &o_r,
+                     const dfloat tol, const int MAXIT, const int verbose);
+
+  //rebuild the preconditioner in place if lambda has changed
+  void PreconUpdate();
+
+  void StaticCondensationSetup();
+  void StaticCondensationUpdate();
+
+  void CondensedOperator(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Sq);
+  void CondensedPrecon(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr);
+  void InteriorSolve(deviceMemory<dfloat>& o_rI, deviceMemory<dfloat>& o_zI);
+  void SkeletonAx(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Aq);
+
   void PlotFields(memory<dfloat>& Q, std::string fileName);
 
   void Operator(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Aq);
 
+  void PartialAx(const dlong Nelements, deviceMemory<dlong> o_elementList,
+                 deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Aq);
+
+  //PartialAx reading q through the given map from local nodes to q
+  void PartialAx(const dlong Nelements, deviceMemory<dlong> o_elementList,
+                 deviceMemory<dlong> o_nodeMap,
+                 deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Aq);
+
   void BuildOperatorMatrixIpdg(parAlmond::parCOO& A);
   void BuildOperatorMatrixContinuous(parAlmond::parCOO& A);
 
+  void BuildOperatorMatrixIpdg(parAlmond::parGlobalCSR& A);
+  void BuildOperatorMatrixContinuous(parAlmond::parGlobalCSR& A);
+
   void BuildOperatorMatrixContinuousTri2D(parAlmond::parCOO& A);
   void BuildOperatorMatrixContinuousTri3D(parAlmond::parCOO& A);
   void BuildOperatorMatrixContinuousQuad2D(parAlmond::parCOO& A);
   void BuildOperatorMatrixContinuousQuad3D(parAlmond::parCOO& A);
   void BuildOperatorMatrixContinuousTet3D(parAlmond::parCOO& A);
   void BuildOperatorMatrixContinuousHex3D(parAlmond::parCOO& A);
+  void BuildOperatorMatrixContinuousHex3D(parAlmond::parGlobalCSR& A);
+
+  void BuildInteriorMatricesContinuousHex3D(const dlong Nelements,
+                                            const memory<dlong> elementList,
+                                            memory<dfloat>& Aii);
+  void BuildCondensedMatrixContinuousHex3D(parAlmond::parCOO& A);
 
   void BuildOperatorMatrixIpdgTri2D(parAlmond::parCOO& A);
   void BuildOperatorMatrixIpdgTri3D(parAlmond::parCOO& A);
@@ -145,8 +211,10 @@ public:
   void BuildOperatorMatrixIpdgQuad3D(parAlmond::parCOO& A);
   void BuildOperatorMatrixIpdgTet3D(parAlmond::parCOO& A);
   void BuildOperatorMatrixIpdgHex3D(parAlmond::parCOO& A);
+  void BuildOperatorMatrixIpdgHex3D(parAlmond::parGlobalCSR& A);
 
   void BuildOperatorDiagonal(memory<dfloat>& diagA);
+  void BuildOperatorDiagonal(deviceMemory<dfloat>& o_diagA);
 
   void BuildOperatorDiagonalContinuousTri2D(memory<dfloat>& diagA);
   void BuildOperatorDiagonalContinuousTri3D(memory<dfloat>& diagA);
@@ -35,12 +35,18 @@ class JacobiPrecon: public operator_t {
 private:
 	elliptic_t elliptic;
 
+  deviceMemory<dfloat> o_diagA;
   deviceMemory<dfloat> o_invDiagA;
 
+  void BuildInverseDiagonal();
+
 public:
   JacobiPrecon() = default;
   JacobiPrecon(elliptic_t& elliptic);
   void Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr);
+
+  //rebuild the diagonal in place if lambda has changed
+  void Update(const dfloat lambda);
 };
 
 //Inverse Mass Matrix preconditioner
@@ -51,9 +57,8 @@ private:
   settings_t settings;
 
   deviceMemory<dfloat> o_MrL, o_rtmp;
-  deviceMemory<dfloat> o_invMM;
+  deviceMemory<dfloat> o_invMM, o_invJ;
 
-  kernel_t blockJacobiKernel;
   kernel_t partialBlockJacobiKernel;
 
 public:
@@ -87,11 +92,15 @@ private:
   settings_t settings;
 
   parAlmond::parAlmond_t parAlmond;
+  int NpMGlevels=0; //matrix-free levels ahead of the AMG levels
 
 public:
   MultiGridPrecon() = default;
   MultiGridPrecon(elliptic_t& elliptic);
   void Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr);
+
+  //rebuild the p-multigrid smoothers if lambda has changed
+  void Update(const dfloat lambda);
 };
 
 // Cast problem into spectrally-equivalent N=1 FEM space and precondition with AMG
@@ -115,6 +124,9 @@ private:
   kernel_t SEMFEMInterpKernel;
   kernel_t SEMFEMAnterpKernel;
 
+  void BuildFEMMatrix(parAlmond::parCOO& A);
+  void BuildLORMatrix(parAlmond::parCOO& A);
+
 public:
   SEMFEMPrecon() = default;
   SEMFEMPrecon(elliptic_t& elliptic);
@@ -142,6 +154,7 @@ public:
   typedef enum {JACOBI=1,
                 CHEBYSHEV=2} SmootherType;
   SmootherType stype;
+  bool schwarz=false;
 
   dfloat lambda1, lambda0;
   int ChebyshevIterations;
@@ -154,8 +167,23 @@ public:
   static deviceMemory<dfloat> o_transferScratch;
 
   //jacobi data
+  deviceMemory<dfloat> o_diagA;
   deviceMemory<dfloat> o_invDiagA;
 
+  //fast diagonalization Schwarz data. Patches are the elements extended
+  // by one node layer across each face, (Nq+2)^dim nodes
+  int fdmNq;
+  dlong fdmNp;
+  memory<dfloat> fdmMu; //separable eigenvalue sums, without lambda
+  deviceMemory<dfloat> o_fdmS, o_fdmSinv, o_fdmInvL;
+
+  //ogs over [global dofs | patch nodes], pulling the residual from the
+  // owner of each dof into every patch holding it
+  ogs::ogs_t ogsFdm;
+  deviceMemory<dfloat> o_fdmR, o_fdmZ;
+  deviceMemory<dfloat> o_fdmRPatch, o_fdmZPatch;
+  kernel_t fdmKernel;
+
   //build a p-multigrid level and connect it to the next one
   MGLevel() = default;
   MGLevel(elliptic_t& _elliptic,
@@ -176,9 +204,18 @@ public:
   void smoothJacobi    (deviceMemory<dfloat> &o_r, deviceMemory<dfloat> &o_X, bool xIsZero);
   void smoothChebyshev (deviceMemory<dfloat> &o_r, deviceMemory<dfloat> &o_X, bool xIsZero);
 
+  //z = alpha*S*r + beta*z, with S the diagonal or Schwarz smoother
+  void smoothPrecon(const dfloat alpha, deviceMemory<dfloat> &o_r,
+                    const dfloat beta, deviceMemory<dfloat> &o_z);
+
   void Report();
 
   void SetupSmoother();
+  void SetupSchwarz();
+  void BuildSmoother();
+
+  //rebuild the smoother in place if lambda has changed
+  void Update(const dfloat lambda);
   dfloat maxEigSmoothAx();
 
   void AllocateStorage();
@@ -200,20 +237,25 @@ private:
   precon_t preconPatch;
   MGLevel level;
 
-  ogs::ogs_t ogsMaskedRing; //ogs for 1-ring patch
+  //ogs over [global dofs | patch dofs], mapping the global
+  // dofs straight to the dofs of the 1-ring patch (C0)
+  ogs::ogs_t ogsPatch;
+  deviceMemory<dfloat> o_patchR, o_patchZ;
+  deviceMemory<dfloat> o_patchMult;
 
   //Coarse Precon
   ogs::ogs_t ogsMasked;
   parAlmond::parAlmond_t parAlmond;
 
   memory<dfloat> rPatch, zPatch;
-  memory<dfloat> rPatchL, zPatchL;
   deviceMemory<dfloat> o_rPatch, o_zPatch;
-  deviceMemory<dfloat> o_rPatchL, o_zPatchL;
 
   memory<dfloat> rC, zC;
   deviceMemory<dfloat> o_rC, o_zC;
 
+  //stream for the coarse solve, overlapping the patch work
+  stream_t coarseStream;
+
   memory<dfloat> patchWeight;
   deviceMemory<dfloat> o_patchWeight;
 
@@ -79,6 +79,28 @@ void elliptic_t::BuildOperatorDiagonal(memory<dfloat>& diagA){
   if(Comm::World().rank()==0) printf("done.\n");
 }
 
+// Assembled operator diagonal on the device. Tensor-product continuous
+// elements build it matrix-free from o_ggeo/o_D, the rest use the host path
+void elliptic_t::BuildOperatorDiagonal(deviceMemory<dfloat>& o_diagA){
+
+  if (operatorDiagonalKernel.isInitialized()) {
+    deviceMemory<dfloat> o_diagAL = platform.malloc<dfloat>(mesh.Np*mesh.Nelements);
+
+    //add the rank boost for the allNeumann Poisson problem
+    const dfloat boost = allNeumann ? allNeumannPenalty*allNeumannScale*allNeumannScale : 0.0;
+
+    operatorDiagonalKernel(mesh.Nelements, mesh.o_wJ, mesh.o_ggeo, mesh.o_D,
+                           lambda, boost, o_diagAL);
+
+    //gather the diagonal to assemble it
+    ogsMasked.Gather(o_diagA, o_diagAL, 1, ogs::Add, ogs::Trans);
+  } else {
+    memory<dfloat> diagA(Ndofs);
+    BuildOperatorDiagonal(diagA);
+    o_diagA.copyFrom(diagA, Ndofs);
+  }
+}
+
 void elliptic_t::BuildOperatorDiagonalIpdgTri2D(memory<dfloat>& A) {
 
   // surface mass matrices MS = MM*LIFT
@@ -25,6 +25,7 @@ SOFTWARE.
 */
 
 #include "elliptic.hpp"
+#include <vector>
 
 #ifdef GLIBCXX_PARALLEL
 #include <parallel/algorithm>
@@ -54,6 +55,17 @@ void elliptic_t::BuildOperatorMatrixContinuous(parAlmond::parCOO& A) {
   }
 }
 
+void elliptic_t::BuildOperatorMatrixContinuous(parAlmond::parGlobalCSR& A) {
+
+  if (mesh.elementType==Mesh::HEXAHEDRA) {
+    BuildOperatorMatrixContinuousHex3D(A);
+  } else {
+    parAlmond::parCOO cooA(platform, mesh.comm);
+    BuildOperatorMatrixContinuous(cooA);
+    A = parAlmond::parGlobalCSR(cooA);
+  }
+}
+
 void elliptic_t::BuildOperatorMatrixContinuousTri2D(parAlmond::parCOO& A) {
 
   // number of degrees of freedom on this rank (after gathering)
@@ -694,135 +706,289 @@ void elliptic_t::BuildOperatorMatrixContinuousTet3D(parAlmond::parCOO& A) {
   if(Comm::World().rank()==0) printf("done.\n");
 }
 
-void elliptic_t::BuildOperatorMatrixContinuousHex3D(parAlmond::parCOO& A) {
+namespace {
+
+//one gathered row of the assembled matrix and a local node that contributes to it
+struct rowNode_t {
+  hlong row;
+  dlong id;
+};
+
+//open-addressed hash summing the column contributions to one matrix row
+class rowHash_t {
+public:
+  rowHash_t(const int maxCols) {
+    int cap = 1;
+    while (cap < 2*maxCols) cap *= 2;
+    mask = cap-1;
+    keys.assign(cap, -1);
+    vals.assign(cap, 0.0);
+    slots.reserve(maxCols);
+  }
 
-  // number of degrees of freedom on this rank (after gathering)
-  hlong Ngather = ogsMasked.Ngather;
+  void add(const hlong col, const dfloat val) {
+    size_t h = static_cast<size_t>(col*0x9E3779B97F4A7C15ULL) & mask;
+    while (keys[h]!=-1 && keys[h]!=col) h = (h+1) & mask;
+    if (keys[h]==-1) {
+      keys[h] = col;
+      vals[h] = 0.0;
+      slots.push_back(h);
+    }
+    vals[h] += val;
+  }
 
-  // every gathered degree of freedom has its own global id
-  A.globalRowStarts.malloc(mesh.size+1,0);
-  A.globalColStarts.malloc(mesh.size+1,0);
-  mesh.comm.Allgather(Ngather, A.globalRowStarts+1);
-  for(int r=0;r<mesh.size;++r) {
-    A.globalRowStarts[r+1] = A.globalRowStarts[r]+A.globalRowStarts[r+1];
-    A.globalColStarts[r+1] = A.globalRowStarts[r+1];
+  //append the row to cols/vals sorted by column, and reset the hash
+  dlong flush(std::vector<hlong>& cols, std::vector<dfloat>& rowVals) {
+    std::sort(slots.begin(), slots.end(),
+              [&](const size_t a, const size_t b) { return keys[a] < keys[b]; });
+    for (const size_t h : slots) {
+      cols.push_back(keys[h]);
+      rowVals.push_back(vals[h]);
+      keys[h] = -1;
+    }
+    const dlong cnt = static_cast<dlong>(slots.size());
+    slots.clear();
+    return cnt;
   }
 
-  // 2. Build non-zeros of stiffness matrix (unassembled)
-  dlong nnzLocal = mesh.Np*mesh.Np*mesh.Nelements;
-  memory<parAlmond::parCOO::nonZero_t> sendNonZeros(nnzLocal);
-  memory<int> AsendCounts (mesh.size, 0);
-  memory<int> ArecvCounts (mesh.size);
-  memory<int> AsendOffsets(mesh.size+1);
-  memory<int> ArecvOffsets(mesh.size+1);
+private:
+  size_t mask;
+  std::vector<hlong> keys;
+  std::vector<dfloat> vals;
+  std::vector<size_t> slots;
+};
+
+//merge two column-sorted rows, summing repeated columns. Returns the merged length,
+// writing the result when cols/vals are non-null
+dlong mergeRows(const hlong* colsA, const dfloat* valsA, const dlong NA,
+                const hlong* colsB, const dfloat* valsB, const dlong NB,
+                hlong* cols, dfloat* vals) {
+  dlong cnt = 0;
+  hlong last = -1;
+  dlong a = 0, b = 0;
+  while (a<NA || b<NB) {
+    hlong col;
+    dfloat val;
+    if (b==NB || (a<NA && colsA[a]<=colsB[b])) {
+      col = colsA[a]; val = valsA[a]; a++;
+    } else {
+      col = colsB[b]; val = valsB[b]; b++;
+    }
+    if (cnt>0 && col==last) {
+      if (vals) vals[cnt-1] += val;
+    } else {
+      if (cols) {cols[cnt] = col; vals[cnt] = val;}
+      last = col;
+      cnt++;
+    }
+  }
+  return cnt;
+}
 
-  if(Comm::World().rank()==0) {printf("Building full FEM matrix...");fflush(stdout);}
+//entry (n,m) of element e's stiffness+lambda*mass matrix
+dfloat HexEntry(mesh_t& mesh, const dfloat lambda, const dlong e,
+                const int idn, const int idm) {
 
-  dlong cnt =0;
-  for (dlong e=0;e<mesh.Nelements;e++) {
-    for (int nz=0;nz<mesh.Nq;nz++) {
-    for (int ny=0;ny<mesh.Nq;ny++) {
-    for (int nx=0;nx<mesh.Nq;nx++) {
-      int idn = nx+ny*mesh.Nq+nz*mesh.Nq*mesh.Nq;
-      if (maskedGlobalNumbering[e*mesh.Np + idn]<0) continue; //skip masked nodes
+  const int Nq = mesh.Nq;
+  const int nx = idn%Nq, ny = (idn/Nq)%Nq, nz = idn/(Nq*Nq);
+  const int mx = idm%Nq, my = (idm/Nq)%Nq, mz = idm/(Nq*Nq);
 
-        for (int mz=0;mz<mesh.Nq;mz++) {
-        for (int my=0;my<mesh.Nq;my++) {
-        for (int mx=0;mx<mesh.Nq;mx++) {
-          int idm = mx+my*mesh.Nq+mz*mesh.Nq*mesh.Nq;
-          if (maskedGlobalNumbering[e*mesh.Np + idm]<0) continue; //skip masked nodes
+  const dlong base = e*mesh.Np*mesh.Nggeo;
+  memory<dfloat>& ggeo = mesh.ggeo;
+  memory<dfloat>& D = mesh.D;
 
-            int id;
-            dfloat val = 0.;
+  int id;
+  dfloat val = 0.;
 
-            if ((ny==my)&&(nz==mz)) {
-              for (int k=0;k<mesh.Nq;k++) {
-                id = k+ny*mesh.Nq+nz*mesh.Nq*mesh.Nq;
-                dfloat Grr = mesh.ggeo[e*mesh.Np*mesh.Nggeo + id + mesh.G00ID*mesh.Np];
+  if ((ny==my)&&(nz==mz)) {
+    for (int k=0;k<Nq;k++) {
+      id = k+ny*Nq+nz*Nq*Nq;
+      dfloat Grr = ggeo[base + id + mesh.G00ID*mesh.Np];
+      val += Grr*D[nx+k*Nq]*D[mx+k*Nq];
+    }
+  }
 
-                val += Grr*mesh.D[nx+k*mesh.Nq]*mesh.D[mx+k*mesh.Nq];
-              }
-            }
+  if (nz==mz) {
+    id = mx+ny*Nq+nz*Nq*Nq;
+    dfloat Grs = ggeo[base + id + mesh.G01ID*mesh.Np];
+    val += Grs*D[nx+mx*Nq]*D[my+ny*Nq];
 
-            if (nz==mz) {
-              id = mx+ny*mesh.Nq+nz*mesh.Nq*mesh.Nq;
-              dfloat Grs = mesh.ggeo[e*mesh.Np*mesh.Nggeo + id + mesh.G01ID*mesh.Np];
-              val += Grs*mesh.D[nx+mx*mesh.Nq]*mesh.D[my+ny*mesh.Nq];
+    id = nx+my*Nq+nz*Nq*Nq;
+    dfloat Gsr = ggeo[base + id + mesh.G01ID*mesh.Np];
+    val += Gsr*D[mx+nx*Nq]*D[ny+my*Nq];
+  }
 
-              id = nx+my*mesh.Nq+nz*mesh.Nq*mesh.Nq;
-              dfloat Gsr = mesh.ggeo[e*mesh.Np*mesh.Nggeo + id + mesh.G01ID*mesh.Np];
-              val += Gsr*mesh.D[mx+nx*mesh.Nq]*mesh.D[ny+my*mesh.Nq];
-            }
+  if (ny==my) {
+    id = mx+ny*Nq+nz*Nq*Nq;
+    dfloat Grt = ggeo[base + id + mesh.G02ID*mesh.Np];
+    val += Grt*D[nx+mx*Nq]*D[mz+nz*Nq];
 
-            if (ny==my) {
-              id = mx+ny*mesh.Nq+nz*mesh.Nq*mesh.Nq;
-              dfloat Grt = mesh.ggeo[e*mesh.Np*mesh.Nggeo + id + mesh.G02ID*mesh.Np];
-              val += Grt*mesh.D[nx+mx*mesh.Nq]*mesh.D[mz+nz*mesh.Nq];
+    id = nx+ny*Nq+mz*Nq*Nq;
+    dfloat Gst = ggeo[base + id + mesh.G02ID*mesh.Np];
+    val += Gst*D[mx+nx*Nq]*D[nz+mz*Nq];
+  }
 
-              id = nx+ny*mesh.Nq+mz*mesh.Nq*mesh.Nq;
-              dfloat Gst = mesh.ggeo[e*mesh.Np*mesh.Nggeo + id + mesh.G02ID*mesh.Np];
-              val += Gst*mesh.D[mx+nx*mesh.Nq]*mesh.D[nz+mz*mesh.Nq];
-            }
+  if ((nx==mx)&&(nz==mz)) {
+    for (int k=0;k<Nq;k++) {
+      id = nx+k*Nq+nz*Nq*Nq;
+      dfloat Gss = ggeo[base + id + mesh.G11ID*mesh.Np];
+      val += Gss*D[ny+k*Nq]*D[my+k*Nq];
+    }
+  }
 
-            if ((nx==mx)&&(nz==mz)) {
-              for (int k=0;k<mesh.Nq;k++) {
-                id = nx+k*mesh.Nq+nz*mesh.Nq*mesh.Nq;
-                dfloat Gss = mesh.ggeo[e*mesh.Np*mesh.Nggeo + id + mesh.G11ID*mesh.Np];
+  if (nx==mx) {
+    id = nx+my*Nq+nz*Nq*Nq;
+    dfloat Gst = ggeo[base + id + mesh.G12ID*mesh.Np];
+    val += Gst*D[ny+my*Nq]*D[mz+nz*Nq];
 
-                val += Gss*mesh.D[ny+k*mesh.Nq]*mesh.D[my+k*mesh.Nq];
-              }
-            }
+    id = nx+ny*Nq+mz*Nq*Nq;
+    dfloat Gts = ggeo[base + id + mesh.G12ID*mesh.Np];
+    val += Gts*D[my+ny*Nq]*D[nz+mz*Nq];
+  }
 
-            if (nx==mx) {
-              id = nx+my*mesh.Nq+nz*mesh.Nq*mesh.Nq;
-              dfloat Gst = mesh.ggeo[e*mesh.Np*mesh.Nggeo + id + mesh.G12ID*mesh.Np];
-              val += Gst*mesh.D[ny+my*mesh.Nq]*mesh.D[mz+nz*mesh.Nq];
+  if ((nx==mx)&&(ny==my)) {
+    for (int k=0;k<Nq;k++) {
+      id = nx+ny*Nq+k*Nq*Nq;
+      dfloat Gtt = ggeo[base + id + mesh.G22ID*mesh.Np];
+      val += Gtt*D[nz+k*Nq]*D[mz+k*Nq];
+    }
+  }
 
-              id = nx+ny*mesh.Nq+mz*mesh.Nq*mesh.Nq;
-              dfloat Gts = mesh.ggeo[e*mesh.Np*mesh.Nggeo + id + mesh.G12ID*mesh.Np];
-              val += Gts*mesh.D[my+ny*mesh.Nq]*mesh.D[nz+mz*mesh.Nq];
-            }
+  if ((nx==mx)&&(ny==my)&&(nz==mz)) {
+    id = nx + ny*Nq+nz*Nq*Nq;
+    dfloat JW = mesh.wJ[e*mesh.Np + id];
+    val += JW*lambda;
+  }
 
-            if ((nx==mx)&&(ny==my)) {
-              for (int k=0;k<mesh.Nq;k++) {
-                id = nx+ny*mesh.Nq+k*mesh.Nq*mesh.Nq;
-                dfloat Gtt = mesh.ggeo[e*mesh.Np*mesh.Nggeo + id + mesh.G22ID*mesh.Np];
+  return val;
+}
 
-                val += Gtt*mesh.D[nz+k*mesh.Nq]*mesh.D[mz+k*mesh.Nq];
-              }
-            }
+} //namespace
+
+//dense blocks coupling the interior nodes of the listed elements, stored
+// column major with (Nq-2)^3 interior nodes ordered lexicographically
+void elliptic_t::BuildInteriorMatricesContinuousHex3D(const dlong Nelements,
+                                                      const memory<dlong> elementList,
+                                                      memory<dfloat>& Aii) {
+
+  const int Nq = mesh.Nq;
+  const int Nqi = Nq-2;
+  const int Ni = Nqi*Nqi*Nqi;
+
+  Aii.malloc(static_cast<size_t>(Nelements)*Ni*Ni);
+
+  #pragma omp parallel for
+  for (dlong b=0;b<Nelements;b++) {
+    const dlong e = elementList[b];
+    const size_t offset = static_cast<size_t>(b)*Ni*Ni;
+    for (int j=0;j<Ni;j++) {
+      const int idm = 1+j%Nqi + (1+(j/Nqi)%Nqi)*Nq + (1+j/(Nqi*Nqi))*Nq*Nq;
+      for (int i=0;i<Ni;i++) {
+        const int idn = 1+i%Nqi + (1+(i/Nqi)%Nqi)*Nq + (1+i/(Nqi*Nqi))*Nq*Nq;
+        Aii[offset + i + j*Ni] = HexEntry(mesh, lambda, e, idn, idm);
+      }
+    }
+  }
+}
 
-            if ((nx==mx)&&(ny==my)&&(nz==mz)) {
-              id = nx + ny*mesh.Nq+nz*mesh.Nq*mesh.Nq;
-              dfloat JW = mesh.wJ[e*mesh.Np + id];
-              val += JW*lambda;
-            }
+// Assemble the Schur complement on the skeleton dofs from the dense
+// element Schur complements S_e = A_bb - A_bi inv(A_ii) A_ib
+void elliptic_t::BuildCondensedMatrixContinuousHex3D(parAlmond::parCOO& A) {
 
-            // pack non-zero
-            dfloat nonZeroThreshold = 1e-7;
-            if (fabs(val) >= nonZeroThreshold) {
-              sendNonZeros[cnt].val = val;
-              sendNonZeros[cnt].row = maskedGlobalNumbering[e*mesh.Np + idn];
-              sendNonZeros[cnt].col = maskedGlobalNumbering[e*mesh.Np + idm];
-              cnt++;
-            }
-        }
-        }
-        }
+  // every gathered skeleton dof has its own global id
+  hlong Ngather = Nskeleton;
+  A.globalRowStarts.malloc(mesh.size+1, 0);
+  A.globalColStarts.malloc(mesh.size+1, 0);
+  mesh.comm.Allgather(Ngather, A.globalRowStarts+1);
+  for(int r=0;r<mesh.size;++r) {
+    A.globalRowStarts[r+1] = A.globalRowStarts[r]+A.globalRowStarts[r+1];
+    A.globalColStarts[r+1] = A.globalRowStarts[r+1];
+  }
+
+  const int Np = mesh.Np;
+  const int Nq = mesh.Nq;
+  const int Ni = Ninterior;
+  const int Nb = Np - Ni;
+
+  if(Comm::World().rank()==0) {printf("Building condensed FEM matrix...");fflush(stdout);}
+
+  //skeleton and interior nodes of the reference element
+  memory<int> bIds(Nb), iIds(Ni);
+  int nb=0, ni=0;
+  for (int n=0;n<Np;n++) {
+    const int i = n%Nq, j = (n/Nq)%Nq, k = n/(Nq*Nq);
+    const bool interior = (i>0 && i<Nq-1) && (j>0 && j<Nq-1) && (k>0 && k<Nq-1);
+    if (interior) iIds[ni++] = n;
+    else          bIds[nb++] = n;
+  }
+
+  // Build non-zeros of the element Schur complements (unassembled)
+  dlong nnzLocal = Nb*Nb*mesh.Nelements;
+
+  memory<parAlmond::parCOO::nonZero_t> sendNonZeros(nnzLocal);
+  memory<int> AsendCounts (mesh.size, 0);
+  memory<int> ArecvCounts (mesh.size);
+  memory<int> AsendOffsets(mesh.size+1);
+  memory<int> ArecvOffsets(mesh.size+1);
+
+  memory<dfloat> Aii(Ni*Ni), Aib(Ni*Nb), X(Ni*Nb);
+
+  dlong cnt =0;
+  for (dlong e=0;e<mesh.Nelements;e++) {
+    for (int j=0;j<Ni;j++) {
+      for (int i=0;i<Ni;i++) {
+        Aii[i + j*Ni] = HexEntry(mesh, lambda, e, iIds[i], iIds[j]);
       }
+    }
+    linAlg_t::matrixInverse(Ni, Aii);
+
+    for (int b=0;b<Nb;b++) {
+      for (int i=0;i<Ni;i++) {
+        Aib[i + b*Ni] = HexEntry(mesh, lambda, e, iIds[i], bIds[b]);
       }
+    }
+
+    // X = inv(A_ii) A_ib
+    for (int b=0;b<Nb;b++) {
+      for (int i=0;i<Ni;i++) {
+        dfloat x = 0.0;
+        for (int m=0;m<Ni;m++) x += Aii[i + m*Ni]*Aib[m + b*Ni];
+        X[i + b*Ni] = x;
       }
+    }
+
+    for (int n=0;n<Nb;n++) {
+      const hlong row = skeletonGlobalNumbering[e*Np + bIds[n]];
+      if (row<0) continue; //skip masked nodes
+      for (int m=0;m<Nb;m++) {
+        const hlong col = skeletonGlobalNumbering[e*Np + bIds[m]];
+        if (col<0) continue; //skip masked nodes
+
+        // A_bi = A_ib^T
+        dfloat val = HexEntry(mesh, lambda, e, bIds[n], bIds[m]);
+        for (int i=0;i<Ni;i++) val -= Aib[i + n*Ni]*X[i + m*Ni];
+
+        dfloat nonZeroThreshold = 1e-7;
+        if (fabs(val)>nonZeroThreshold) {
+          // pack non-zero
+          sendNonZeros[cnt].val = val;
+          sendNonZeros[cnt].row = row;
+          sendNonZeros[cnt].col = col;
+          cnt++;
+        }
+      }
+    }
   }
 
   // sort by row ordering
   sort(sendNonZeros.ptr(), sendNonZeros.ptr()+cnt,
-      [](const parAlmond::parCOO::nonZero_t& a,
-         const parAlmond::parCOO::nonZero_t& b) {
-        if (a.row < b.row) return true;
-        if (a.row > b.row) return false;
+       [](const parAlmond::parCOO::nonZero_t& a,
+          const parAlmond::parCOO::nonZero_t& b) {
+         if (a.row < b.row) return true;
+         if (a.row > b.row) return false;
 
-        return a.col < b.col;
-      });
+         return a.col < b.col;
+        });
 
   // count how many non-zeros to send to each process
   int rr=0;
@@ -851,15 +1017,15 @@ void elliptic_t::BuildOperatorMatrixContinuousHex3D(parAlmond::parCOO& A) {
   mesh.comm.Alltoallv(sendNonZeros, AsendCounts, AsendOffsets,
                       A.entries,    ArecvCounts, ArecvOffsets);
 
-  // sort received non-zero entries by row block (may need to switch compareRowColumn tests)
+  // sort received non-zero entries by row block
   sort(A.entries.ptr(), A.entries.ptr()+A.nnz,
-      [](const parAlmond::parCOO::nonZero_t& a,
-         const parAlmond::parCOO::nonZero_t& b) {
-        if (a.row < b.row) return true;
-        if (a.row > b.row) return false;
+       [](const parAlmond::parCOO::nonZero_t& a,
+          const parAlmond::parCOO::nonZero_t& b) {
+         if (a.row < b.row) return true;
+         if (a.row > b.row) return false;
 
-        return a.col < b.col;
-      });
+         return a.col < b.col;
+       });
 
   // compress duplicates
   cnt = 0;
@@ -878,3 +1044,219 @@ void elliptic_t::BuildOperatorMatrixContinuousHex3D(parAlmond::parCOO& A) {
 
   if(Comm::World().rank()==0) printf("done.\n");
 }
+
+void elliptic_t::BuildOperatorMatrixContinuousHex3D(parAlmond::parCOO& A) {
+  parAlmond::parGlobalCSR csrA(platform, mesh.comm);
+  BuildOperatorMatrixContinuousHex3D(csrA);
+  A = parAlmond::parCOO(csrA);
+}
+
+void elliptic_t::BuildOperatorMatrixContinuousHex3D(parAlmond::parGlobalCSR& A) {
+
+  // number of degrees of freedom on this rank (after gathering)
+  hlong Ngather = ogsMasked.Ngather;
+
+  // every gathered degree of freedom has its own global id
+  A.globalRowStarts.malloc(mesh.size+1,0);
+  A.globalColStarts.malloc(mesh.size+1,0);
+  mesh.comm.Allgather(Ngather, A.globalRowStarts+1);
+  for(int r=0;r<mesh.size;++r) {
+    A.globalRowStarts[r+1] = A.globalRowStarts[r]+A.globalRowStarts[r+1];
+    A.globalColStarts[r+1] = A.globalRowStarts[r+1];
+  }
+  const hlong globalRowOffset = A.globalRowStarts[mesh.rank];
+
+  const int Np = mesh.Np;
+  const dlong Nlocal = mesh.Nelements*Np;
+
+  if(Comm::World().rank()==0) {printf("Building full FEM matrix...");fflush(stdout);}
+
+  // group the unmasked local nodes by the global row they gather to
+  memory<rowNode_t> rowNodes(Nlocal);
+  dlong Nnodes = 0;
+  for (dlong n=0;n<Nlocal;n++) {
+    if (maskedGlobalNumbering[n]<0) continue; //skip masked nodes
+    rowNodes[Nnodes].row = maskedGlobalNumbering[n];
+    rowNodes[Nnodes].id  = n;
+    Nnodes++;
+  }
+
+  sort(rowNodes.ptr(), rowNodes.ptr()+Nnodes,
+      [](const rowNode_t& a, const rowNode_t& b) {
+        if (a.row < b.row) return true;
+        if (a.row > b.row) return false;
+
+        return a.id < b.id;
+      });
+
+  dlong Nrows = 0;
+  for (dlong n=0;n<Nnodes;n++)
+    if (n==0 || rowNodes[n].row != rowNodes[n-1].row) Nrows++;
+
+  memory<hlong> rowIds(Nrows);
+  memory<dlong> groupStarts(Nrows+1);
+  int maxGroup = 0;
+  Nrows = 0;
+  for (dlong n=0;n<Nnodes;n++) {
+    if (n==0 || rowNodes[n].row != rowNodes[n-1].row) {
+      if (Nrows) maxGroup = std::max(maxGroup, static_cast<int>(n-groupStarts[Nrows-1]));
+      rowIds[Nrows] = rowNodes[n].row;
+      groupStarts[Nrows++] = n;
+    }
+  }
+  groupStarts[Nrows] = Nnodes;
+  if (Nrows) maxGroup = std::max(maxGroup, static_cast<int>(Nnodes-groupStarts[Nrows-1]));
+
+  // assemble every row touched on this rank. Each thread sums the element
+  // contributions to its rows in a hash and keeps the compressed rows until
+  // the row offsets are known
+  memory<dlong> rowStarts(Nrows+1, 0);
+  memory<hlong> cols;
+  memory<dfloat> vals;
+
+  #pragma omp parallel
+  {
+    rowHash_t hash(maxGroup*Np);
+    std::vector<hlong> tCols;
+    std::vector<dfloat> tVals;
+    dlong tFirstRow = -1;
+
+    #pragma omp for schedule(static)
+    for (dlong r=0;r<Nrows;r++) {
+      if (tFirstRow<0) tFirstRow = r;
+
+      for (dlong g=groupStarts[r];g<groupStarts[r+1];g++) {
+        const dlong e = rowNodes[g].id/Np;
+        const int idn = static_cast<int>(rowNodes[g].id%Np);
+
+        for (int idm=0;idm<Np;idm++) {
+          const hlong col = maskedGlobalNumbering[e*Np + idm];
+          if (col<0) continue; //skip masked nodes
+
+          const dfloat val = HexEntry(mesh, lambda, e, idn, idm);
+
+          dfloat nonZeroThreshold = 1e-7;
+          if (fabs(val) >= nonZeroThreshold) hash.add(col, val);
+        }
+      }
+      rowStarts[r+1] = hash.flush(tCols, tVals);
+    }
+
+    #pragma omp single
+    {
+      for (dlong r=0;r<Nrows;r++) rowStarts[r+1] += rowStarts[r];
+      cols.malloc(rowStarts[Nrows]);
+      vals.malloc(rowStarts[Nrows]);
+    }
+
+    if (tFirstRow>=0) {
+      const dlong offset = rowStarts[tFirstRow];
+      for (size_t n=0;n<tCols.size();n++) {
+        cols[offset+n] = tCols[n];
+        vals[offset+n] = tVals[n];
+      }
+    }
+  }
+
+  // rows owned by this rank are a contiguous block of the sorted rows
+  const dlong firstOwned = static_cast<dlong>(std::lower_bound(rowIds.ptr(), rowIds.ptr()+Nrows,
+                                                               globalRowOffset) - rowIds.ptr());
+  const dlong lastOwned  = static_cast<dlong>(std::lower_bound(rowIds.ptr(), rowIds.ptr()+Nrows,
+                                                               globalRowOffset+Ngather) - rowIds.ptr());
+  LIBP_ABORT("Gathered rows owned by rank " << mesh.rank << " are not all present locally",
+             lastOwned-firstOwned != Ngather);
+
+  // send the rows owned by other ranks to their owners
+  const dlong sendNnz = rowStarts[firstOwned] + (rowStarts[Nrows]-rowStarts[lastOwned]);
+  memory<parAlmond::parCOO::nonZero_t> sendNonZeros(sendNnz);
+  memory<int> AsendCounts (mesh.size, 0);
+  memory<int> ArecvCounts (mesh.size);
+  memory<int> AsendOffsets(mesh.size+1);
+  memory<int> ArecvOffsets(mesh.size+1);
+
+  dlong cnt = 0;
+  int rr=0;
+  for (dlong r=0;r<Nrows;r++) {
+    if (r==firstOwned) r = lastOwned;
+    if (r==Nrows) break;
+
+    while(rowIds[r]>=A.globalRowStarts[rr+1]) rr++;
+    for (dlong jj=rowStarts[r];jj<rowStarts[r+1];jj++) {
+      sendNonZeros[cnt].row = rowIds[r];
+      sendNonZeros[cnt].col = cols[jj];
+      sendNonZeros[cnt].val = vals[jj];
+      cnt++;
+    }
+    AsendCounts[rr] += rowStarts[r+1]-rowStarts[r];
+  }
+
+  // find how many nodes to expect (should use sparse version)
+  mesh.comm.Alltoall(AsendCounts, ArecvCounts);
+
+  // find send and recv offsets for gather
+  dlong recvNnz = 0;
+  AsendOffsets[0] = 0;
+  ArecvOffsets[0] = 0;
+  for(int r=0;r<mesh.size;++r){
+    AsendOffsets[r+1] = AsendOffsets[r] + AsendCounts[r];
+    ArecvOffsets[r+1] = ArecvOffsets[r] + ArecvCounts[r];
+    recvNnz += ArecvCounts[r];
+  }
+
+  memory<parAlmond::parCOO::nonZero_t> recvNonZeros(recvNnz);
+  mesh.comm.Alltoallv(sendNonZeros, AsendCounts, AsendOffsets,
+                      recvNonZeros, ArecvCounts, ArecvOffsets);
+  sendNonZeros.free();
+
+  // sort received non-zero entries by row block
+  sort(recvNonZeros.ptr(), recvNonZeros.ptr()+recvNnz,
+      [](const parAlmond::parCOO::nonZero_t& a,
+         const parAlmond::parCOO::nonZero_t& b) {
+        if (a.row < b.row) return true;
+        if (a.row > b.row) return false;
+
+        return a.col < b.col;
+      });
+
+  memory<dlong> recvStarts(Ngather+1, 0);
+  memory<hlong> recvCols(recvNnz);
+  memory<dfloat> recvVals(recvNnz);
+  for (dlong n=0;n<recvNnz;n++) {
+    recvStarts[recvNonZeros[n].row-globalRowOffset+1]++;
+    recvCols[n] = recvNonZeros[n].col;
+    recvVals[n] = recvNonZeros[n].val;
+  }
+  for (dlong i=0;i<Ngather;i++) recvStarts[i+1] += recvStarts[i];
+  recvNonZeros.free();
+
+  // merge the received contributions into the owned rows
+  A.Nrows = static_cast<dlong>(Ngather);
+  A.rowStarts.malloc(A.Nrows+1, 0);
+
+  #pragma omp parallel for
+  for (dlong i=0;i<A.Nrows;i++) {
+    const dlong r = firstOwned+i;
+    A.rowStarts[i+1] = mergeRows(cols.ptr()+rowStarts[r], vals.ptr()+rowStarts[r],
+                                 rowStarts[r+1]-rowStarts[r],
+                                 recvCols.ptr()+recvStarts[i], recvVals.ptr()+recvStarts[i],
+                                 recvStarts[i+1]-recvStarts[i],
+                                 nullptr, nullptr);
+  }
+  for (dlong i=0;i<A.Nrows;i++) A.rowStarts[i+1] += A.rowStarts[i];
+
+  A.nnz = A.rowStarts[A.Nrows];
+  A.cols.malloc(A.nnz);
+  A.vals.malloc(A.nnz);
+
+  #pragma omp parallel for
+  for (dlong i=0;i<A.Nrows;i++) {
+    const dlong r = firstOwned+i;
+    mergeRows(cols.ptr()+rowStarts[r], vals.ptr()+rowStarts[r],
+              rowStarts[r+1]-rowStarts[r],
+              recvCols.ptr()+recvStarts[i], recvVals.ptr()+recvStarts[i],
+              recvStarts[i+1]-recvStarts[i],
+              A.cols.ptr()+A.rowStarts[i], A.vals.ptr()+A.rowStarts[i]);
+  }
+
+  if(Comm::World().rank()==0) printf("done.\n");
+}
@@ -33,6 +33,14 @@ using __gnu_parallel::sort;
 using std::sort;
 #endif
 
+namespace {
+//column and value of one entry in a matrix row
+struct colVal_t {
+  hlong col;
+  dfloat val;
+};
+} //namespace
+
 void elliptic_t::BuildOperatorMatrixIpdg(parAlmond::parCOO& A){
 
   switch(mesh.elementType){
@@ -58,6 +66,17 @@ void elliptic_t::BuildOperatorMatrixIpdg(parAlmond::parCOO& A){
   }
 }
 
+void elliptic_t::BuildOperatorMatrixIpdg(parAlmond::parGlobalCSR& A){
+
+  if (mesh.elementType==Mesh::HEXAHEDRA) {
+    BuildOperatorMatrixIpdgHex3D(A);
+  } else {
+    parAlmond::parCOO cooA(platform, mesh.comm);
+    BuildOperatorMatrixIpdg(cooA);
+    A = parAlmond::parGlobalCSR(cooA);
+  }
+}
+
 void elliptic_t::BuildOperatorMatrixIpdgTri2D(parAlmond::parCOO& A){
 
   int Np = mesh.Np;
@@ -1314,6 +1333,12 @@ void elliptic_t::BuildOperatorMatrixIpdgTet3D(parAlmond::parCOO& A){
 }
 
 void elliptic_t::BuildOperatorMatrixIpdgHex3D(parAlmond::parCOO& A){
+  parAlmond::parGlobalCSR csrA(platform, mesh.comm);
+  BuildOperatorMatrixIpdgHex3D(csrA);
+  A = parAlmond::parCOO(csrA);
+}
+
+void elliptic_t::BuildOperatorMatrixIpdgHex3D(parAlmond::parGlobalCSR& A){
 
   int Np = mesh.Np;
   int Nfaces = mesh.Nfaces;
@@ -1348,7 +1373,8 @@ void elliptic_t::BuildOperatorMatrixIpdgHex3D(parAlmond::parCOO& A){
   /* do a halo exchange of global node numbers */
   mesh.halo.Exchange(globalIds, Np);
 
-  dlong nnzLocalBound = Np*Np*(1+Nfaces)*Nelements;
+  // each row couples to its own element and the Nfaces neighbors
+  const int maxRowNnz = Np*(1+Nfaces);
 
   // drop tolerance for entries in sparse storage
   dfloat tol = 1e-8;
@@ -1389,15 +1415,14 @@ void elliptic_t::BuildOperatorMatrixIpdgHex3D(parAlmond::parCOO& A){
     }
   }
 
-  A.entries.malloc(nnzLocalBound);
+  // every row of the element block gets its own slot, so elements can be built concurrently
+  memory<colVal_t> rowEntries(Nelements*Np*maxRowNnz);
+  memory<dlong> rowCounts(Nelements*Np, 0);
 
   if(Comm::World().rank()==0) {printf("Building full IPDG matrix...");fflush(stdout);}
 
-  // reset non-zero counter
-  dlong nnz = 0;
-
   // loop over all elements
-  //#pragma omp parallel for
+  #pragma omp parallel for
   for(dlong eM=0;eM<mesh.Nelements;++eM){
 
     /* build Dx,Dy,Dz (forget the TP for the moment) */
@@ -1528,43 +1553,58 @@ void elliptic_t::BuildOperatorMatrixIpdgHex3D(parAlmond::parCOO& A){
             }
           }
           if(std::abs(AnmP)>tol){
-            //#pragma omp critical
-            {
-              // remote info
-              dlong eP    = mesh.EToE[eM*mesh.Nfaces+fM];
-              A.entries[nnz].row = globalIds[eM*mesh.Np + n];
-              A.entries[nnz].col = globalIds[eP*mesh.Np + m];
-              A.entries[nnz].val = AnmP;
-              ++nnz;
-            }
+            // remote info
+            dlong eP    = mesh.EToE[eM*mesh.Nfaces+fM];
+            const dlong row = eM*mesh.Np + n;
+            colVal_t& entry = rowEntries[row*maxRowNnz + rowCounts[row]++];
+            entry.col = globalIds[eP*mesh.Np + m];
+            entry.val = AnmP;
           }
         }
         if(std::abs(Anm)>tol){
-          //#pragma omp critical
-          {
-            // local block
-            A.entries[nnz].row = globalIds[eM*mesh.Np+n];
-            A.entries[nnz].col = globalIds[eM*mesh.Np+m];
-            A.entries[nnz].val = Anm;
-            ++nnz;
-          }
+          // local block
+          const dlong row = eM*mesh.Np + n;
+          colVal_t& entry = rowEntries[row*maxRowNnz + rowCounts[row]++];
+          entry.col = globalIds[eM*mesh.Np+m];
+          entry.val = Anm;
         }
       }
+
+      // sort the row by column and sum repeated neighbors
+      const dlong row = eM*mesh.Np + n;
+      colVal_t* rowStart = rowEntries.ptr() + row*maxRowNnz;
+      std::sort(rowStart, rowStart+rowCounts[row],
+                [](const colVal_t& a, const colVal_t& b) { return a.col < b.col; });
+      dlong cnt = 0;
+      for (dlong jj=1;jj<rowCounts[row];++jj) {
+        if (rowStart[jj].col == rowStart[cnt].col) {
+          rowStart[cnt].val += rowStart[jj].val;
+        } else {
+          rowStart[++cnt] = rowStart[jj];
+        }
+      }
+      if (rowCounts[row]) rowCounts[row] = cnt+1;
     }
   }
 
-  // sort received non-zero entries by row block
-  sort(A.entries.ptr(), A.entries.ptr()+nnz,
-      [](const parAlmond::parCOO::nonZero_t& a,
-         const parAlmond::parCOO::nonZero_t& b) {
-        if (a.row < b.row) return true;
-        if (a.row > b.row) return false;
-
-        return a.col < b.col;
-      });
+  // compress the row slots into CSR
+  A.Nrows = Nelements*Np;
+  A.rowStarts.malloc(A.Nrows+1);
+  A.rowStarts[0] = 0;
+  for (dlong i=0;i<A.Nrows;i++) A.rowStarts[i+1] = A.rowStarts[i] + rowCounts[i];
+
+  A.nnz = A.rowStarts[A.Nrows];
+  A.cols.malloc(A.nnz);
+  A.vals.malloc(A.nnz);
+
+  #pragma omp parallel for
+  for (dlong i=0;i<A.Nrows;i++) {
+    for (dlong jj=0;jj<rowCounts[i];jj++) {
+      A.cols[A.rowStarts[i]+jj] = rowEntries[i*maxRowNnz+jj].col;
+      A.vals[A.rowStarts[i]+jj] = rowEntries[i*maxRowNnz+jj].val;
+    }
+  }
 
-  //*A = (parAlmond::parCOO::nonZero_t*) realloc(*A, nnz*sizeof(parAlmond::parCOO::nonZero_t));
-  A.nnz = nnz;
 
   if(Comm::World().rank()==0) printf("done.\n");
 }
@@ -29,78 +29,30 @@
 void elliptic_t::Operator(deviceMemory<dfloat> &o_q, deviceMemory<dfloat> &o_Aq){
 
   if(disc_c0){
-    // int mapType = (mesh.elementType==Mesh::HEXAHEDRA &&
-    //                mesh.settings.compareSetting("ELEMENT MAP", "TRILINEAR")) ? 1:0;
-
-    // int integrationType = (mesh.elementType==Mesh::HEXAHEDRA &&
-    //                        settings.compareSetting("ELLIPTIC INTEGRATION", "CUBATURE")) ? 1:0;
-
     gHalo.ExchangeStart(o_q, 1);
 
     if(mesh.NlocalGatherElements/2){
-      // if(integrationType==0) { // GLL or non-hex
-        // if(mapType==0)
-          partialAxKernel(mesh.NlocalGatherElements/2,
-                          mesh.o_localGatherElementList,
-                          o_GlobalToLocal,
-                          mesh.o_wJ, mesh.o_ggeo,
-                          mesh.o_D, mesh.o_S,
-                          mesh.o_MM, lambda, o_q, o_AqL);
-        /* NC: disabling until we re-add treatment of affine elements
-        else
-          partialAxKernel(mesh.NlocalGatherElements, mesh.o_localGatherElementList,
-                          mesh.o_EXYZ, mesh.o_gllzw, mesh.o_D, mesh.o_S, mesh.o_MM, lambda, o_q, o_Aq);
-        */
-      // } else {
-      //   partialCubatureAxKernel(mesh.NlocalGatherElements,
-      //                           mesh.o_localGatherElementList,
-      //                           mesh.o_cubggeo,
-      //                           mesh.o_cubD,
-      //                           mesh.o_cubInterpT,
-      //                           lambda,
-      //                           o_q,
-      //                           o_Aq);
-      // }
+      PartialAx(mesh.NlocalGatherElements/2,
+                mesh.o_localGatherElementList,
+                o_q, o_AqL);
     }
 
     // finalize halo exchange
     gHalo.ExchangeFinish(o_q, 1);
 
     if(mesh.NglobalGatherElements) {
-
-      // if(integrationType==0) { // GLL or non-hex
-        // if(mapType==0)
-          partialAxKernel(mesh.NglobalGatherElements,
-                          mesh.o_globalGatherElementList,
-                          o_GlobalToLocal,
-                          mesh.o_wJ, mesh.o_ggeo,
-                          mesh.o_D, mesh.o_S,
-                          mesh.o_MM, lambda, o_q, o_AqL);
-        /* NC: disabling until we re-add treatment of affine elements
-        else
-          partialAxKernel(mesh.NglobalGatherElements, mesh.o_globalGatherElementList,
-                          mesh.o_EXYZ, mesh.o_gllzw, mesh.o_D, mesh.o_S, mesh.o_MM, lambda, o_q, o_Aq);
-        */
-      // } else {
-      //   partialCubatureAxKernel(mesh.NglobalGatherElements,
-      //                           mesh.o_globalGatherElementList,
-      //                           mesh.o_cubggeo,
-      //                           mesh.o_cubD,
-      //                           mesh.o_cubInterpT,
-      //                           lambda, o_q, o_Aq);
-      // }
+      PartialAx(mesh.NglobalGatherElements,
+                mesh.o_globalGatherElementList,
+                o_q, o_AqL);
     }
 
     //gather result to Aq
     ogsMasked.GatherStart(o_Aq, o_AqL, 1, ogs::Add, ogs::Trans);
 
     if((mesh.NlocalGatherElements+1)/2){
-      partialAxKernel((mesh.NlocalGatherElements+1)/2,
-                      mesh.o_localGatherElementList+(mesh.NlocalGatherElements/2),
-                      o_GlobalToLocal,
-                      mesh.o_wJ, mesh.o_ggeo,
-                      mesh.o_D, mesh.o_S,
-                      mesh.o_MM, lambda, o_q, o_AqL);
+      PartialAx((mesh.NlocalGatherElements+1)/2,
+                mesh.o_localGatherElementList+(mesh.NlocalGatherElements/2),
+                o_q, o_AqL);
     }
 
     ogsMasked.GatherFinish(o_Aq, o_AqL, 1, ogs::Add, ogs::Trans);
@@ -157,3 +109,30 @@ void elliptic_t::Operator(deviceMemory<dfloat> &o_q, deviceMemory<dfloat> &o_Aq)
   }
 }
 
+// local continuous Ax on a list of elements
+void elliptic_t::PartialAx(const dlong Nelements, deviceMemory<dlong> o_elementList,
+                           deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Aq){
+  PartialAx(Nelements, o_elementList, o_GlobalToLocal, o_q, o_Aq);
+}
+
+void elliptic_t::PartialAx(const dlong Nelements, deviceMemory<dlong> o_elementList,
+                           deviceMemory<dlong> o_nodeMap,
+                           deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Aq){
+
+  if(cubatureAx) {
+    // over-integrated, with geometric factors at the cubature nodes
+    partialAxKernel(Nelements,
+                    o_elementList,
+                    o_nodeMap,
+                    mesh.o_cubwJ, mesh.o_cubggeo,
+                    mesh.o_cubD, mesh.o_cubInterp,
+                    lambda, o_q, o_Aq);
+  } else {
+    partialAxKernel(Nelements,
+                    o_elementList,
+                    o_nodeMap,
+                    mesh.o_wJ, mesh.o_ggeo,
+                    mesh.o_D, mesh.o_S,
+                    mesh.o_MM, lambda, o_q, o_Aq);
+  }
+}
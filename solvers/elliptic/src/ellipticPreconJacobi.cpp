@@ -30,13 +30,28 @@ SOFTWARE.
 JacobiPrecon::JacobiPrecon(elliptic_t& _elliptic):
   elliptic(_elliptic) {
 
-  memory<dfloat> diagA   (elliptic.Ndofs);
-  memory<dfloat> invDiagA(elliptic.Ndofs);
-  elliptic.BuildOperatorDiagonal(diagA);
-  for (dlong n=0;n<elliptic.Ndofs;n++)
-    invDiagA[n] = 1.0/diagA[n];
+  o_diagA    = elliptic.platform.malloc<dfloat>(elliptic.Ndofs);
+  o_invDiagA = elliptic.platform.malloc<dfloat>(elliptic.Ndofs);
 
-  o_invDiagA = elliptic.platform.malloc<dfloat>(invDiagA);
+  BuildInverseDiagonal();
+}
+
+void JacobiPrecon::Update(const dfloat lambda) {
+  if (lambda == elliptic.lambda) return;
+
+  elliptic.lambda = lambda;
+  BuildInverseDiagonal();
+}
+
+void JacobiPrecon::BuildInverseDiagonal() {
+
+  linAlg_t& linAlg = elliptic.platform.linAlg();
+
+  elliptic.BuildOperatorDiagonal(o_diagA);
+
+  // invDiagA = 1./diagA
+  linAlg.set(elliptic.Ndofs, 1.0, o_invDiagA);
+  linAlg.adx(elliptic.Ndofs, 1.0, o_diagA, o_invDiagA);
 }
 
 void JacobiPrecon::Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr) {
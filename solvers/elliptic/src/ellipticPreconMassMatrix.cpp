@@ -49,8 +49,14 @@ MassMatrixPrecon::MassMatrixPrecon(elliptic_t& _elliptic):
   kernelInfo["defines/" "p_NblockV"]= NblockV;
 
   if (settings.compareSetting("DISCRETIZATION", "IPDG")) {
-    blockJacobiKernel = elliptic.platform.buildKernel(DELLIPTIC "/okl/ellipticPreconBlockJacobi.okl",
-                                     "blockJacobi", kernelInfo);
+    //per-element scaling of the reference inverse mass matrix
+    memory<dfloat> invJ(mesh.Nelements);
+    for (dlong e=0;e<mesh.Nelements;e++) {
+      invJ[e] = 1.0/mesh.vgeo[e*mesh.Nvgeo+mesh.JID];
+    }
+    o_invJ = elliptic.platform.malloc<dfloat>(invJ);
+
+    elliptic.platform.linAlg().InitBatchedGEMV(mesh.Np, mesh.Np);
   } else if (settings.compareSetting("DISCRETIZATION", "CONTINUOUS")) {
     dlong Ntotal = elliptic.ogsMasked.Ngather + elliptic.gHalo.Nhalo;
     o_rtmp = elliptic.platform.malloc<dfloat>(Ntotal);
@@ -108,7 +114,9 @@ void MassMatrixPrecon::Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>&
 
   } else {
     //IPDG
-    blockJacobiKernel(mesh.Nelements, invLambda, mesh.o_vgeo, o_invMM, o_r, o_Mr);
+    linAlg.batchedGEMV(mesh.Nelements, mesh.Np, mesh.Np,
+                       invLambda, o_invJ, o_invMM, 0,
+                       o_r, 0.0, o_Mr);
   }
 
   // zero mean of RHS
@@ -37,6 +37,18 @@ void MultiGridPrecon::Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>&
   if(elliptic.allNeumann) elliptic.ZeroMean(o_Mr);
 }
 
+/* The p-multigrid levels rebuild their smoothers for the new lambda. The
+   degree 1 AMG hierarchy is an assembled matrix setup and keeps the lambda
+   it was built with; it only has to stay spectrally equivalent to the
+   coarse operator, which a positive change of lambda preserves */
+void MultiGridPrecon::Update(const dfloat lambda) {
+  if (lambda == elliptic.lambda) return;
+
+  elliptic.lambda = lambda;
+  for (int l=0;l<NpMGlevels;l++)
+    parAlmond.GetLevel<MGLevel>(l).Update(lambda);
+}
+
 MultiGridPrecon::MultiGridPrecon(elliptic_t& _elliptic):
   elliptic(_elliptic), mesh(_elliptic.mesh), settings(_elliptic.settings),
   parAlmond(elliptic.platform, settings, mesh.comm) {
@@ -50,8 +62,10 @@ MultiGridPrecon::MultiGridPrecon(elliptic_t& _elliptic):
     if (Comm::World().rank()==0){
       printf("-----------------------------Multigrid pMG Degree %2d----------------------------------------\n", Nc);
     }
-    //build mesh and elliptic objects for this degree
-    mesh_t meshF = mesh.SetupNewDegree(Nf);
+    //build mesh and elliptic objects for this degree. Continuous levels
+    // only need the geometric factors of Ax, so use lightweight meshes
+    mesh_t meshF = elliptic.disc_c0 ? mesh.SetupLevelDegree(Nf, elliptic.cubatureAx)
+                                    : mesh.SetupNewDegree(Nf);
     elliptic_t ellipticF = elliptic.SetupNewDegree(meshF);
 
     //share masking data with previous MG level
@@ -111,11 +125,14 @@ MultiGridPrecon::MultiGridPrecon(elliptic_t& _elliptic):
     NpFine = NpCoarse;
   }
 
+  NpMGlevels = parAlmond.NumLevels();
+
   //build matrix at degree 1
   if (Comm::World().rank()==0){
     printf("-----------------------------Multigrid pMG Degree  1----------------------------------------\n");
   }
-  mesh_t meshF = mesh.SetupNewDegree(1);
+  mesh_t meshF = elliptic.disc_c0 ? mesh.SetupLevelDegree(1, elliptic.cubatureAx)
+                                  : mesh.SetupNewDegree(1);
   elliptic_t ellipticF = elliptic.SetupNewDegree(meshF);
 
   //share masking data with previous MG level
@@ -129,7 +146,7 @@ MultiGridPrecon::MultiGridPrecon(elliptic_t& _elliptic):
   if (Comm::World().rank()==0){
     printf("-----------------------------Multigrid AMG Setup--------------------------------------------\n");
   }
-  parAlmond::parCOO A(elliptic.platform, mesh.comm);
+  parAlmond::parGlobalCSR A(elliptic.platform, mesh.comm);
   if (settings.compareSetting("DISCRETIZATION", "IPDG"))
     ellipticF.BuildOperatorMatrixIpdg(A);
   else if (settings.compareSetting("DISCRETIZATION", "CONTINUOUS"))
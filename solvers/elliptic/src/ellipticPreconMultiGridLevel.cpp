@@ -139,7 +139,7 @@ void MGLevel::smoothJacobi(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_X,
   deviceMemory<dfloat>& o_RES = o_smootherResidual;
 
   if (xIsZero) {
-    linAlg.amxpy(elliptic.Ndofs, 1.0, o_invDiagA, o_r, 0.0, o_X);
+    smoothPrecon(1.0, o_r, 0.0, o_X);
     return;
   }
 
@@ -148,7 +148,7 @@ void MGLevel::smoothJacobi(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_X,
   linAlg.axpy(elliptic.Ndofs, 1.f, o_r, -1.f, o_RES);
 
   //smooth the fine problem x = x + S(r-Ax)
-  linAlg.amxpy(elliptic.Ndofs, 1.0, o_invDiagA, o_RES, 1.0, o_X);
+  smoothPrecon(1.0, o_RES, 1.0, o_X);
 }
 
 void MGLevel::smoothChebyshev (deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_X, bool xIsZero) {
@@ -168,7 +168,7 @@ void MGLevel::smoothChebyshev (deviceMemory<dfloat>& o_r, deviceMemory<dfloat>&
 
   if(xIsZero){ //skip the Ax if x is zero
     //res = S*r
-    linAlg.amxpy(elliptic.Ndofs, 1.0, o_invDiagA, o_r, 0.f, o_RES);
+    smoothPrecon(1.0, o_r, 0.0, o_RES);
 
     //d = invTheta*res
     linAlg.axpy(elliptic.Ndofs, invTheta, o_RES, 0.f, o_d);
@@ -176,7 +176,7 @@ void MGLevel::smoothChebyshev (deviceMemory<dfloat>& o_r, deviceMemory<dfloat>&
     //res = S*(r-Ax)
     Operator(o_X,o_RES);
     linAlg.axpy(elliptic.Ndofs, 1.f, o_r, -1.f, o_RES);
-    linAlg.amx(elliptic.Ndofs, 1.f, o_invDiagA, o_RES);
+    smoothPrecon(1.0, o_RES, 0.0, o_RES);
 
     //d = invTheta*res
     linAlg.axpy(elliptic.Ndofs, invTheta, o_RES, 0.f, o_d);
@@ -191,7 +191,7 @@ void MGLevel::smoothChebyshev (deviceMemory<dfloat>& o_r, deviceMemory<dfloat>&
 
     //r_k+1 = r_k - SAd_k
     Operator(o_d,o_Ad);
-    linAlg.amxpy(elliptic.Ndofs, -1.f, o_invDiagA, o_Ad, 1.f, o_RES);
+    smoothPrecon(-1.0, o_Ad, 1.0, o_RES);
 
     rho_np1 = 1.0/(2.*sigma-rho_n);
     dfloat rhoDivDelta = 2.0*rho_np1/delta;
@@ -205,6 +205,30 @@ void MGLevel::smoothChebyshev (deviceMemory<dfloat>& o_r, deviceMemory<dfloat>&
   linAlg.axpy(elliptic.Ndofs, 1.f, o_d, 1.0, o_X);
 }
 
+void MGLevel::smoothPrecon(const dfloat alpha, deviceMemory<dfloat>& o_r,
+                           const dfloat beta, deviceMemory<dfloat>& o_z) {
+
+  linAlg_t& linAlg = platform.linAlg();
+
+  if (!schwarz) {
+    linAlg.amxpy(elliptic.Ndofs, alpha, o_invDiagA, o_r, beta, o_z);
+    return;
+  }
+
+  //pull the residual into the overlapping patches. o_fdmRPatch is the
+  // patch segment of o_fdmR
+  o_fdmR.copyFrom(o_r, elliptic.Ndofs);
+  ogsFdm.GatherScatter(o_fdmR, 1, ogs::Add, ogs::NoTrans);
+
+  fdmKernel(mesh.Nelements, o_fdmS, o_fdmSinv, o_fdmInvL, o_fdmRPatch, o_fdmZPatch);
+
+  //sum the patch solutions back onto the global dofs
+  linAlg.set(elliptic.Ndofs, 0.0, o_fdmZ);
+  ogsFdm.GatherScatter(o_fdmZ, 1, ogs::Add, ogs::Trans);
+
+  linAlg.axpy(elliptic.Ndofs, alpha, o_fdmZ, beta, o_z);
+}
+
 
 /******************************************
 *
@@ -328,8 +352,12 @@ void MGLevel::Report() {
   mesh.comm.Allreduce(minNrows, Comm::Min);
 
   char smootherString[BUFSIZ];
-  if (stype==JACOBI)
+  if (stype==JACOBI && schwarz)
+    strcpy(smootherString, "Damped Schwarz  ");
+  else if (stype==JACOBI)
     strcpy(smootherString, "Damped Jacobi   ");
+  else if (stype==CHEBYSHEV && schwarz)
+    strcpy(smootherString, "Chebyshev+FDM   ");
   else if (stype==CHEBYSHEV)
     strcpy(smootherString, "Chebyshev       ");
 
@@ -344,43 +372,354 @@ void MGLevel::Report() {
 
 void MGLevel::SetupSmoother() {
 
-  //set up the fine problem smoothing
-  memory<dfloat> diagA   (Nrows);
-  memory<dfloat> invDiagA(Nrows);
-  elliptic.BuildOperatorDiagonal(diagA);
+  schwarz = elliptic.settings.compareSetting("MULTIGRID SMOOTHER","SCHWARZ");
 
-  for (dlong n=0;n<Nrows;n++) {
-    invDiagA[n] = 1.0/diagA[n];
+  //set up the fine problem smoothing
+  if (schwarz) {
+    SetupSchwarz();
+  } else {
+    o_diagA    = platform.malloc<dfloat>(Nrows);
+    o_invDiagA = platform.malloc<dfloat>(Nrows);
   }
 
-  o_invDiagA = elliptic.platform.malloc<dfloat>(invDiagA);
-
   if (elliptic.settings.compareSetting("MULTIGRID SMOOTHER","CHEBYSHEV")) {
     stype = CHEBYSHEV;
 
     ChebyshevIterations = 2; //default to degree 2
     elliptic.settings.getSetting("MULTIGRID CHEBYSHEV DEGREE", ChebyshevIterations);
+  } else {
+    stype = JACOBI;
+  }
 
-    //estimate the max eigenvalue of S*A
-    dfloat rho = maxEigSmoothAx();
+  BuildSmoother();
+}
 
-    lambda1 = rho;
-    lambda0 = rho/10.;
+/* Smoother data depending on lambda: the inverse diagonal (or the Schwarz
+   inverse eigenvalues), and the spectral bounds of S*A built from it */
+void MGLevel::BuildSmoother() {
+
+  linAlg_t& linAlg = platform.linAlg();
+
+  if (schwarz) {
+    memory<dfloat> invL(mesh.Nelements*fdmNp);
+    for (dlong n=0;n<mesh.Nelements*fdmNp;n++)
+      invL[n] = 1.0/(elliptic.lambda + fdmMu[n]);
+    o_fdmInvL.copyFrom(invL);
   } else {
-    stype = JACOBI;
+    elliptic.BuildOperatorDiagonal(o_diagA);
+
+    // invDiagA = 1./diagA
+    linAlg.set(Nrows, 1.0, o_invDiagA);
+    linAlg.adx(Nrows, 1.0, o_diagA, o_invDiagA);
+  }
 
-    //estimate the max eigenvalue of S*A
-    dfloat rho = maxEigSmoothAx();
+  //estimate the max eigenvalue of S*A
+  dfloat rho = maxEigSmoothAx();
 
+  if (stype==CHEBYSHEV) {
+    lambda1 = rho;
+    lambda0 = rho/10.;
+  } else {
     //set the stabilty weight (jacobi-type interation)
     lambda0 = (4./3.)/rho;
 
-    for (dlong n=0;n<Nrows;n++)
-      invDiagA[n] *= lambda0;
+    if (schwarz) {
+      //fold weight into the inverse eigenvalues
+      linAlg.scale(mesh.Nelements*fdmNp, lambda0, o_fdmInvL);
+    } else {
+      //update diagonal with weight
+      linAlg.scale(Nrows, lambda0, o_invDiagA);
+    }
+  }
+}
+
+/* A new lambda changes both the smoother and the extreme eigenvalues of
+   S*A the Chebyshev and Jacobi weights are built from, so both are redone.
+   The estimate costs a few Ax per level, paid only when lambda changes */
+void MGLevel::Update(const dfloat lambda) {
+  if (lambda == elliptic.lambda) return;
+
+  elliptic.lambda = lambda;
+  BuildSmoother();
+}
+
+/******************************************
+*
+* Fast diagonalization Schwarz smoother
+*
+*  Each patch is an element extended by one node layer across each of
+*  its faces, i.e. (Nq+2)^dim nodes of which the edge and corner
+*  extensions are held at zero. For C0 the extension nodes are the
+*  neighbor's first interior node layer, for IPDG the neighbor's trace
+*  nodes. The residual is pulled into the patches, and the patch
+*  solutions summed back, with an ogs over [global dofs | patch nodes].
+*
+*  The patch operator is approximated by a box with the average edge
+*  lengths of the element, and same-sized neighbors. The 1D stiffness
+*  and mass matrices in each direction are those of the element plus
+*  the last GLL interval of each neighbor, and the separable operator
+*
+*    A = (Bz x By x Ax) + (Bz x Ay x Bx) + (Az x By x Bx) + lambda (Bz x By x Bx)
+*
+*  is inverted with the 1D generalized eigenproblems A_d s = mu B_d s:
+*
+*    A^{-1} = (Sz x Sy x Sx) invL (Sinvz x Sinvy x Sinvx),
+*    Sinv_d = S_d^{-1} B_d^{-1},  invL = 1/(lambda + mux + muy + muz)
+*
+*******************************************/
 
-    //update diagonal with weight
-    o_invDiagA.copyFrom(invDiagA);
+void MGLevel::SetupSchwarz() {
+
+  LIBP_ABORT("Schwarz smoother only available for quadrilateral and hexahedral meshes",
+             !(   (mesh.elementType==Mesh::QUADRILATERALS && mesh.dim==2)
+               ||  mesh.elementType==Mesh::HEXAHEDRA));
+
+  const int Nq = mesh.Nq;
+  const int dim = mesh.dim;
+  const int NqE = Nq+2;
+
+  fdmNq = NqE;
+  fdmNp = (dim==2) ? NqE*NqE : NqE*NqE*NqE;
+
+  //direction and side (min/max) of each reference face
+  memory<int> faceDir(mesh.Nfaces), faceSide(mesh.Nfaces);
+  for (int f=0;f<mesh.Nfaces;f++) {
+    for (int d=0;d<dim;d++) {
+      int Nmin=0, Nmax=0;
+      for (int n=0;n<mesh.Nfp;n++) {
+        const int fid = mesh.faceNodes[f*mesh.Nfp + n];
+        const int c = (d==0) ? fid%Nq : (d==1) ? (fid/Nq)%Nq : fid/(Nq*Nq);
+        if (c==0)    Nmin++;
+        if (c==Nq-1) Nmax++;
+      }
+      if (Nmin==mesh.Nfp) {faceDir[f] = d; faceSide[f] = 0;}
+      if (Nmax==mesh.Nfp) {faceDir[f] = d; faceSide[f] = 1;}
+    }
   }
+
+  //1D reference stiffness matrix
+  memory<double> Ahat(Nq*Nq, 0.0);
+  for (int i=0;i<Nq;i++) {
+    for (int j=0;j<Nq;j++) {
+      for (int m=0;m<Nq;m++) {
+        Ahat[i*Nq+j] += mesh.D[m*Nq+i]*mesh.gllw[m]*mesh.D[m*Nq+j];
+      }
+    }
+  }
+
+  memory<dfloat> S   (mesh.Nelements*dim*NqE*NqE);
+  memory<dfloat> Sinv(mesh.Nelements*dim*NqE*NqE);
+  fdmMu.malloc(mesh.Nelements*fdmNp);
+
+  memory<double> A(NqE*NqE), V(NqE*NqE);
+  memory<double> WR(NqE), WI(NqE);
+  memory<double> B(NqE), invSqrtB(NqE);
+  memory<double> mu(dim*NqE);
+
+  //vertex pairs spanning each direction of the reference element
+  const int quadEdges[2][2][2] = {{{0,1},{3,2}},
+                                  {{0,3},{1,2}}};
+  const int hexEdges[3][4][2] = {{{0,1},{3,2},{4,5},{7,6}},
+                                 {{0,3},{1,2},{4,7},{5,6}},
+                                 {{0,4},{1,5},{2,6},{3,7}}};
+
+  for (dlong e=0;e<mesh.Nelements;e++) {
+    //which sides of the element have a neighbor
+    int hasNbr[3][2] = {{0,0},{0,0},{0,0}};
+    for (int f=0;f<mesh.Nfaces;f++)
+      hasNbr[faceDir[f]][faceSide[f]] = (mesh.EToE[e*mesh.Nfaces+f] >= 0);
+
+    for (int d=0;d<dim;d++) {
+      //average element length in direction d
+      const int Nedges = (dim==2) ? 2 : 4;
+      double h = 0.0;
+      for (int n=0;n<Nedges;n++) {
+        const int v0 = (dim==2) ? quadEdges[d][n][0] : hexEdges[d][n][0];
+        const int v1 = (dim==2) ? quadEdges[d][n][1] : hexEdges[d][n][1];
+        const dlong id0 = e*mesh.Nverts + v0;
+        const dlong id1 = e*mesh.Nverts + v1;
+        const double dx = mesh.EX[id1] - mesh.EX[id0];
+        const double dy = mesh.EY[id1] - mesh.EY[id0];
+        const double dz = (dim==3) ? mesh.EZ[id1] - mesh.EZ[id0] : 0.0;
+        h += sqrt(dx*dx + dy*dy + dz*dz)/Nedges;
+      }
+
+      //1D mass and stiffness on the extended nodes. The element nodes
+      // are 1..Nq, nodes 0 and Nq+1 lie in the neighbors
+      for (int n=0;n<NqE*NqE;n++) A[n] = 0.0;
+      for (int n=0;n<NqE;n++) B[n] = 0.0;
+
+      for (int i=0;i<Nq;i++) {
+        B[i+1] += 0.5*h*mesh.gllw[i];
+        for (int j=0;j<Nq;j++) {
+          A[(i+1)*NqE+(j+1)] += (2.0/h)*Ahat[i*Nq+j];
+        }
+      }
+
+      //last GLL interval of each neighbor. Without a neighbor the
+      // extension node is decoupled and only ever sees a zero residual
+      for (int s=0;s<2;s++) {
+        const int off = (s==0) ? 0  : Nq;   //extended index of the interval
+        const int ref = (s==0) ? Nq-2 : 0;  //neighbor's reference index
+        if (hasNbr[d][s]) {
+          for (int a=0;a<2;a++) {
+            B[off+a] += 0.5*h*mesh.gllw[ref+a];
+            for (int b=0;b<2;b++) {
+              A[(off+a)*NqE+(off+b)] += (2.0/h)*Ahat[(ref+a)*Nq+(ref+b)];
+            }
+          }
+        } else {
+          const int n = (s==0) ? 0 : NqE-1;
+          A[n*NqE+n] = 1.0;
+          B[n] = 1.0;
+        }
+      }
+
+      //symmetrically scale by the mass
+      for (int n=0;n<NqE;n++)
+        invSqrtB[n] = 1.0/sqrt(B[n]);
+      for (int i=0;i<NqE;i++) {
+        for (int j=0;j<NqE;j++) {
+          A[i*NqE+j] *= invSqrtB[i]*invSqrtB[j];
+        }
+      }
+
+      linAlg_t::matrixEigenVectors(NqE, A, V, WR, WI);
+
+      const dlong offset = e*dim*NqE*NqE + d*NqE*NqE;
+      for (int i=0;i<NqE;i++) {
+        mu[d*NqE+i] = WR[i];
+        for (int j=0;j<NqE;j++) {
+          S[offset + i*NqE+j] = invSqrtB[i]*V[i*NqE+j];
+        }
+      }
+
+      linAlg_t::matrixInverse(NqE, V);
+
+      for (int i=0;i<NqE;i++) {
+        for (int j=0;j<NqE;j++) {
+          Sinv[offset + i*NqE+j] = V[i*NqE+j]*invSqrtB[j];
+        }
+      }
+    }
+
+    //separable eigenvalues, lambda is added when the smoother is built
+    for (int n=0;n<fdmNp;n++) {
+      const int i = n%NqE;
+      const int j = (n/NqE)%NqE;
+      const int k = n/(NqE*NqE);
+      double L = mu[i] + mu[NqE+j];
+      if (dim==3) L += mu[2*NqE+k];
+      fdmMu[e*fdmNp + n] = L;
+    }
+  }
+
+  o_fdmS    = elliptic.platform.malloc<dfloat>(S);
+  o_fdmSinv = elliptic.platform.malloc<dfloat>(Sinv);
+  o_fdmInvL = elliptic.platform.malloc<dfloat>(mesh.Nelements*fdmNp);
+
+  /*Build the ogs connecting the global dofs to the patch nodes*/
+  const dlong Ndofs = elliptic.Ndofs;
+  const dlong NpatchNodes = mesh.Nelements*fdmNp;
+
+  hlong NdofsLocal = Ndofs;
+  hlong globalOffset = NdofsLocal;
+  mesh.comm.Scan(NdofsLocal, globalOffset);
+  globalOffset -= NdofsLocal;
+
+  //global number of the dof at each node, shifted by one so masked
+  // nodes (numbered -1) drop out, and shared with the halo elements
+  memory<hlong> nodeNumbering((mesh.Nelements+mesh.totalHaloPairs)*mesh.Np);
+  for (dlong n=0;n<mesh.Nelements*mesh.Np;n++) {
+    nodeNumbering[n] = elliptic.disc_c0 ? elliptic.maskedGlobalNumbering[n] + 1
+                                        : n + globalOffset + 1;
+  }
+  mesh.halo.Exchange(nodeNumbering, mesh.Np);
+
+  //face nodes of an element and its neighbor, sorted by their global
+  // node number to match them up (continuous levels drop vmapP)
+  memory<std::pair<hlong,int>> nodesM(mesh.Nfp), nodesP(mesh.Nfp);
+
+  memory<hlong> patchNumbering(NpatchNodes, 0);
+  for (dlong e=0;e<mesh.Nelements;e++) {
+    //element nodes
+    for (int n=0;n<mesh.Np;n++) {
+      const int i = n%Nq;
+      const int j = (n/Nq)%Nq;
+      const int k = n/(Nq*Nq);
+      const int nE = (i+1) + (j+1)*NqE + ((dim==3) ? (k+1)*NqE*NqE : 0);
+      patchNumbering[e*fdmNp + nE] = nodeNumbering[e*mesh.Np + n];
+    }
+
+    //one node layer across each connected face
+    for (int f=0;f<mesh.Nfaces;f++) {
+      const dlong eP = static_cast<dlong>(mesh.EToE[e*mesh.Nfaces+f]);
+      if (eP < 0) continue;
+
+      const int fP = mesh.EToF[e*mesh.Nfaces+f];
+      for (int n=0;n<mesh.Nfp;n++) {
+        const int fidM = mesh.faceNodes[f *mesh.Nfp + n];
+        const int fidP = mesh.faceNodes[fP*mesh.Nfp + n];
+        nodesM[n] = std::make_pair(mesh.globalIds[e *mesh.Np + fidM], fidM);
+        nodesP[n] = std::make_pair(mesh.globalIds[eP*mesh.Np + fidP], fidP);
+      }
+      std::sort(nodesM.begin(), nodesM.end());
+      std::sort(nodesP.begin(), nodesP.end());
+
+      for (int n=0;n<mesh.Nfp;n++) {
+        const int fid = nodesM[n].second;
+        int c[3] = {fid%Nq, (fid/Nq)%Nq, fid/(Nq*Nq)};
+        for (int d=0;d<dim;d++) c[d] += 1;
+        c[faceDir[f]] = (faceSide[f]==0) ? 0 : NqE-1;
+        const int nE = c[0] + c[1]*NqE + ((dim==3) ? c[2]*NqE*NqE : 0);
+
+        //IPDG overlaps with the neighbor's trace node, C0 steps off
+        // the shared node into the neighbor
+        int cP[3] = {nodesP[n].second%Nq, (nodesP[n].second/Nq)%Nq, nodesP[n].second/(Nq*Nq)};
+        if (elliptic.disc_c0)
+          cP[faceDir[fP]] += (faceSide[fP]==0) ? 1 : -1;
+        const dlong id = eP*mesh.Np + cP[0] + cP[1]*Nq + cP[2]*Nq*Nq;
+
+        patchNumbering[e*fdmNp + nE] = nodeNumbering[id];
+      }
+    }
+  }
+
+  //each rank owns (leaves unflagged) its own global dofs, and flags
+  // the patch copies. A NoTrans gather-scatter then pulls the owned
+  // values into every patch, and a Trans one sums the patches back
+  memory<hlong> patchIds(Ndofs+NpatchNodes);
+  for (dlong n=0;n<Ndofs;n++)
+    patchIds[n] = n + globalOffset + 1;
+  for (dlong n=0;n<NpatchNodes;n++)
+    patchIds[Ndofs+n] = -patchNumbering[n];
+
+  int verbose = 0;
+  bool unique = false; //owners are already the only unflagged ids
+  ogsFdm.Setup(Ndofs+NpatchNodes, patchIds, mesh.comm,
+               ogs::Signed, ogs::Auto,
+               unique, verbose, elliptic.platform);
+
+  //patch nodes with no dof (masked, or edge and corner extensions)
+  // are never written, so start them at zero
+  memory<dfloat> dummy(Ndofs+NpatchNodes, 0.0);
+  o_fdmR = elliptic.platform.malloc<dfloat>(dummy);
+  o_fdmZ = elliptic.platform.malloc<dfloat>(dummy);
+
+  //the patch vectors live in the patch segments
+  o_fdmRPatch = o_fdmR + Ndofs;
+  o_fdmZPatch = o_fdmZ + Ndofs;
+
+  properties_t kernelInfo = mesh.props;
+  kernelInfo["defines/" "p_NqE"] = NqE;
+  kernelInfo["defines/" "p_NpE"] = static_cast<int>(fdmNp);
+  kernelInfo["defines/" "p_fdmDirStride"] = NqE*NqE;
+  kernelInfo["defines/" "p_fdmElementStride"] = dim*NqE*NqE;
+
+  std::string suffix = (dim==2) ? "Quad2D" : "Hex3D";
+  std::string fileName   = DELLIPTIC "/okl/ellipticPreconFDM" + suffix + ".okl";
+  std::string kernelName = "ellipticPreconFDM" + suffix;
+  fdmKernel = elliptic.platform.buildKernel(fileName, kernelName, kernelInfo);
 }
 
 
@@ -428,9 +767,9 @@ dfloat MGLevel::maxEigSmoothAx(){
   linAlg.axpy(N, 1./norm_vo, o_Vx, 0.f, o_V[0]);
 
   for(int j=0; j<k; j++){
-    // v[j+1] = invD*(A*v[j])
+    // v[j+1] = S*(A*v[j])
     Operator(o_V[j],o_AVx);
-    linAlg.amxpy(N, 1.0, o_invDiagA, o_AVx, 0.0, o_V[j+1]);
+    smoothPrecon(1.0, o_AVx, 0.0, o_V[j+1]);
 
     // modified Gram-Schmidth
     for(int i=0; i<=j; i++){
@@ -33,16 +33,16 @@ SOFTWARE.
 void OASPrecon::Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr) {
 
   if (mesh.N>1) {
+    //Coarsen problem to N=1 first, and wait for it so the
+    // coarse stream can pick up o_rC
+    level.coarsen(o_r, o_rC);
+    elliptic.platform.finish();
+
     if (elliptic.disc_c0) {
-      //Scatter to localDof ordering, exchange ring halo,
-      // then compress the ring mesh to globalDofs order.
-      // TODO: Technically, these steps couple be fused
-      // to a single operation, but currently theres no easy way
-      // as the ordering of globalDofs between the original mesh
-      // partition and the ring mesh could be different
-      elliptic.ogsMasked.Scatter(o_rPatchL, o_r, 1, ogs::NoTrans);
-      mesh.ringHalo.Exchange(o_rPatchL, mesh.Np);
-      ellipticPatch.ogsMasked.Gather(o_rPatch, o_rPatchL, 1, ogs::Add, ogs::NoTrans);
+      //Pull the patch rhs directly from the owners of each global dof.
+      // o_rPatch is the patch segment of o_patchR
+      o_patchR.copyFrom(o_r, elliptic.Ndofs);
+      ogsPatch.GatherScatter(o_patchR, 1, ogs::Add, ogs::NoTrans);
     } else {
       o_rPatch.copyFrom(o_r, elliptic.Ndofs);
       mesh.ringHalo.Exchange(o_rPatch, mesh.Np);
@@ -51,26 +51,27 @@ void OASPrecon::Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr)
     //Apply local patch precon
     preconPatch.Operator(o_rPatch, o_zPatch);
 
-    //Coarsen problem to N=1 and pass to parAlmond
-    // TODO: This is blocking due to H<->D transfers.
-    //       Should modify precons so size=1 is non-blocking
-    level.coarsen(o_r, o_rC);
-
+    //Solve the coarse problem on its own stream. The host only blocks
+    // on coarse stream work here, so the patch kernels still queued on
+    // the default stream execute concurrently with the coarse solve
+    stream_t patchStream = elliptic.platform.getStream();
+    elliptic.platform.setStream(coarseStream);
     parAlmond.Operator(o_rC, o_zC);
+    elliptic.platform.setStream(patchStream);
 
     linAlg_t& linAlg = elliptic.platform.linAlg();
 
     //Add contributions from all patches together
     if (elliptic.disc_c0) {
-      dlong Ntotal=mesh.Nelements*mesh.Np;
-
-      ellipticPatch.ogsMasked.Scatter(o_zPatchL, o_zPatch, 1, ogs::NoTrans);
-      ogsMaskedRing.GatherScatter(o_zPatchL, 1, ogs::Add, ogs::Sym);
+      //Sum the patch solutions, weighted by the number of ring
+      // nodes sharing each patch dof, onto the global dofs.
+      // o_zPatch is the patch segment of o_patchZ
+      linAlg.amx(ellipticPatch.Ndofs, 1.0, o_patchMult, o_zPatch);
+      linAlg.set(elliptic.Ndofs, 0.0, o_patchZ);
+      ogsPatch.GatherScatter(o_patchZ, 1, ogs::Add, ogs::Trans);
 
-      // Weight by overlap degree, zPatch = patchWeight*zPatch
-      linAlg.amx(Ntotal, 1.0, o_patchWeight, o_zPatchL);
-
-      elliptic.ogsMasked.Gather(o_Mr, o_zPatchL, 1, ogs::Add, ogs::NoTrans);
+      // Weight by overlap degree, Mr = patchWeight*z
+      linAlg.amxpy(elliptic.Ndofs, 1.0, o_patchWeight, o_patchZ, 0.0, o_Mr);
 
     } else {
       mesh.ringHalo.Combine(o_zPatch, mesh.Np);
@@ -79,6 +80,11 @@ void OASPrecon::Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr)
       linAlg.amxpy(elliptic.Ndofs, 1.0, o_patchWeight, o_zPatch, 0.0, o_Mr);
     }
 
+    //wait for the coarse solution
+    elliptic.platform.setStream(coarseStream);
+    elliptic.platform.finish();
+    elliptic.platform.setStream(patchStream);
+
     // Add prologatated coarse solution
     level.prolongate(o_zC, o_Mr);
   } else {
@@ -96,6 +102,8 @@ OASPrecon::OASPrecon(elliptic_t& _elliptic):
 
   //build the one ring mesh
   if (mesh.N>1) {
+    coarseStream = elliptic.platform.device.createStream();
+
     if (Comm::World().rank()==0){
       printf("-----------------------------Multigrid Degree %2d Patch--------------------------------------\n", mesh.N);
     }
@@ -104,52 +112,87 @@ OASPrecon::OASPrecon(elliptic_t& _elliptic):
     preconPatch.Setup<MultiGridPrecon>(ellipticPatch);
 
     if (settings.compareSetting("DISCRETIZATION", "CONTINUOUS")) {
-      rPatchL.malloc(mesh.Np*(mesh.Nelements+mesh.totalRingElements),0.0);
-      zPatchL.malloc(mesh.Np*(mesh.Nelements+mesh.totalRingElements),0.0);
-
-      o_rPatchL = elliptic.platform.malloc<dfloat>(rPatchL);
-      o_zPatchL = elliptic.platform.malloc<dfloat>(zPatchL);
-    }
+      const dlong Ndofs = elliptic.Ndofs;
+      const dlong NpatchDofs = ellipticPatch.Ndofs;
+      const dlong NringNodes = meshPatch.Nelements*meshPatch.Np;
 
-    rPatch.malloc(ellipticPatch.Ndofs,0.0);
-    zPatch.malloc(ellipticPatch.Ndofs,0.0);
-    o_rPatch = elliptic.platform.malloc<dfloat>(rPatch);
-    o_zPatch = elliptic.platform.malloc<dfloat>(zPatch);
+      //share the global numbering of the gathered dofs with the ring,
+      // shifted by one so masked nodes (numbered -1) drop out
+      memory<hlong> ringNumbering(NringNodes);
+      ringNumbering.copyFrom(elliptic.maskedGlobalNumbering, mesh.Nelements*mesh.Np);
+      mesh.ringHalo.Exchange(ringNumbering, mesh.Np);
 
-    //compute patch overlap weighting
-    patchWeight.malloc(meshPatch.Nelements*meshPatch.Np);
-    for (int i=0;i<meshPatch.Nelements*meshPatch.Np;i++)
-      patchWeight[i] = 1.0;
-
-    if (settings.compareSetting("DISCRETIZATION", "CONTINUOUS")) {
-      //share the masked version of the global id numbering
-      memory<hlong> maskedRingGlobalIds(meshPatch.Nelements*meshPatch.Np);
-      maskedRingGlobalIds.copyFrom(elliptic.maskedGlobalIds, mesh.Nelements*mesh.Np);
-      mesh.ringHalo.Exchange(maskedRingGlobalIds, mesh.Np);
+      for (dlong n=0;n<NringNodes;n++)
+        ringNumbering[n] += 1;
 
       //mask ring
       for (dlong n=0;n<ellipticPatch.Nmasked;n++)
-        maskedRingGlobalIds[ellipticPatch.maskIds[n]] = 0;
+        ringNumbering[ellipticPatch.maskIds[n]] = 0;
+
+      //global number of each patch dof, and how many ring nodes share it
+      memory<hlong> patchNumbering(NpatchDofs);
+      ellipticPatch.ogsMasked.Gather(patchNumbering, ringNumbering,
+                                     1, ogs::Add, ogs::NoTrans);
+
+      memory<dfloat> ones(NringNodes, 1.0);
+      memory<dfloat> patchMult(NpatchDofs);
+      ellipticPatch.ogsMasked.Gather(patchMult, ones,
+                                     1, ogs::Add, ogs::Trans);
+
+      //each rank owns (leaves unflagged) its own global dofs, and flags
+      // the patch copies. A NoTrans gather-scatter then pulls the owned
+      // values into every patch, and a Trans one sums the patches back
+      hlong NdofsLocal = Ndofs;
+      hlong globalOffset = NdofsLocal;
+      mesh.comm.Scan(NdofsLocal, globalOffset);
+      globalOffset -= NdofsLocal;
+
+      memory<hlong> patchIds(Ndofs+NpatchDofs);
+      for (dlong n=0;n<Ndofs;n++)
+        patchIds[n] = n + globalOffset + 1;
+      for (dlong n=0;n<NpatchDofs;n++)
+        patchIds[Ndofs+n] = -patchNumbering[n];
 
-      //use the masked ids to make another gs handle
       int verbose = 0;
-      bool unique = true; //flag a unique node in every gather node
-      ogsMaskedRing.Setup(meshPatch.Nelements*meshPatch.Np,
-                          maskedRingGlobalIds, mesh.comm,
-                          ogs::Signed, ogs::Auto,
-                          unique, verbose, elliptic.platform);
+      bool unique = false; //owners are already the only unflagged ids
+      ogsPatch.Setup(Ndofs+NpatchDofs, patchIds, mesh.comm,
+                     ogs::Signed, ogs::Auto,
+                     unique, verbose, elliptic.platform);
+
+      //determine overlap of each global dof
+      memory<dfloat> mult(Ndofs+NpatchDofs, 0.0);
+      mult.copyFrom(patchMult, NpatchDofs, Ndofs);
+      ogsPatch.GatherScatter(mult, 1, ogs::Add, ogs::Trans);
+
+      //invert
+      patchWeight.malloc(Ndofs);
+      for (dlong n=0;n<Ndofs;n++)
+        patchWeight[n] = (mult[n] > 0.0) ? 1.0/mult[n] : 0.0;
+
+      memory<dfloat> dummy(Ndofs+NpatchDofs, 0.0);
+      o_patchR = elliptic.platform.malloc<dfloat>(dummy);
+      o_patchZ = elliptic.platform.malloc<dfloat>(dummy);
 
-      //determine overlap of each node with masked ogs
-      ogsMaskedRing.GatherScatter(patchWeight, 1, ogs::Add, ogs::Sym);
+      //the patch vectors live in the patch segments
+      o_rPatch = o_patchR + Ndofs;
+      o_zPatch = o_patchZ + Ndofs;
+
+      o_patchMult = elliptic.platform.malloc<dfloat>(patchMult);
 
     } else {
+      rPatch.malloc(ellipticPatch.Ndofs,0.0);
+      zPatch.malloc(ellipticPatch.Ndofs,0.0);
+      o_rPatch = elliptic.platform.malloc<dfloat>(rPatch);
+      o_zPatch = elliptic.platform.malloc<dfloat>(zPatch);
+
       //determine overlap by combining halos
+      patchWeight.malloc(meshPatch.Nelements*meshPatch.Np, 1.0);
       mesh.ringHalo.Combine(patchWeight, mesh.Np);
-    }
 
-    //invert
-    for (int i=0;i<meshPatch.Nelements*meshPatch.Np;i++)
-      patchWeight[i] = (patchWeight[i] > 0.0) ? 1.0/patchWeight[i] : 0.0;
+      //invert
+      for (dlong n=0;n<meshPatch.Nelements*meshPatch.Np;n++)
+        patchWeight[n] = (patchWeight[n] > 0.0) ? 1.0/patchWeight[n] : 0.0;
+    }
 
     o_patchWeight = elliptic.platform.malloc<dfloat>(patchWeight);
   }
@@ -169,14 +212,14 @@ OASPrecon::OASPrecon(elliptic_t& _elliptic):
   }
 
   //build mesh and elliptic objects for this degree
-  mesh_t meshC = mesh.SetupNewDegree(Nc);
+  mesh_t meshC = mesh.SetupNewDegree(Nc, elliptic.cubatureAx);
   elliptic_t ellipticC = elliptic.SetupNewDegree(meshC);
 
   //build full A matrix and pass to parAlmond
   if (Comm::World().rank()==0){
     printf("-----------------------------Multigrid AMG Setup--------------------------------------------\n");
   }
-  parAlmond::parCOO A(elliptic.platform, meshC.comm);
+  parAlmond::parGlobalCSR A(elliptic.platform, meshC.comm);
   if (settings.compareSetting("DISCRETIZATION", "IPDG"))
     ellipticC.BuildOperatorMatrixIpdg(A);
   else if (settings.compareSetting("DISCRETIZATION", "CONTINUOUS"))
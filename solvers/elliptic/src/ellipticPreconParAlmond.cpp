@@ -44,7 +44,7 @@ ParAlmondPrecon::ParAlmondPrecon(elliptic_t& _elliptic):
   if (Comm::World().rank()==0){
     printf("-----------------------------Multigrid AMG Setup--------------------------------------------\n");
   }
-  parAlmond::parCOO A(elliptic.platform, elliptic.mesh.comm);
+  parAlmond::parGlobalCSR A(elliptic.platform, elliptic.mesh.comm);
   if (settings.compareSetting("DISCRETIZATION", "IPDG")) {
     elliptic.BuildOperatorMatrixIpdg(A);
   } else if (settings.compareSetting("DISCRETIZATION", "CONTINUOUS")) {
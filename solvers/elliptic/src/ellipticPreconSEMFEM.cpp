@@ -50,7 +50,7 @@ void SEMFEMPrecon::Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_M
     linAlg.amx(elliptic.Ndofs, 1.0, elliptic.o_weightG, o_Mr);
 
   } else {
-    //pass to parAlmond
+    //fem nodes coincide with the gathered sem dofs, pass to parAlmond
     parAlmond.Operator(o_r, o_Mr);
   }
 
@@ -66,6 +66,77 @@ SEMFEMPrecon::SEMFEMPrecon(elliptic_t& _elliptic):
   LIBP_ABORT("SEMFEM is supported for CONTINUOUS only",
              !settings.compareSetting("DISCRETIZATION", "CONTINUOUS"));
 
+  if (mesh.rank==0){
+    printf("-----------------------------Multigrid AMG Setup--------------------------------------------\n");
+  }
+  parAlmond::parCOO A(elliptic.platform, mesh.comm);
+
+  if ((mesh.elementType==Mesh::QUADRILATERALS && mesh.dim==2)
+    || mesh.elementType==Mesh::HEXAHEDRA) {
+    //the low-order refined nodes are the GLL nodes, so assemble the Q1 matrix directly
+    BuildLORMatrix(A);
+  } else {
+    BuildFEMMatrix(A);
+  }
+
+  //populate null space unit vector
+  int rank = mesh.rank;
+  int size = mesh.size;
+  hlong TotalRows = A.globalRowStarts[size];
+  dlong numLocalRows = static_cast<dlong>(A.globalRowStarts[rank+1]-A.globalRowStarts[rank]);
+
+  memory<dfloat> null(numLocalRows);
+  for (dlong i=0;i<numLocalRows;i++) {
+    null[i] = 1.0/sqrt(TotalRows);
+  }
+
+  parAlmond.AMGSetup(A, elliptic.allNeumann, null, elliptic.allNeumannPenalty);
+
+  parAlmond.Report();
+
+  if (mesh.elementType==Mesh::TRIANGLES) {
+    // build interp and anterp
+    memory<dfloat> SEMFEMAnterp(mesh.NpFEM*mesh.Np);
+    for(int n=0;n<mesh.NpFEM;++n){
+      for(int m=0;m<mesh.Np;++m){
+        SEMFEMAnterp[n+m*mesh.NpFEM] = mesh.SEMFEMInterp[n*mesh.Np+m];
+      }
+    }
+
+    mesh.o_SEMFEMInterp = elliptic.platform.malloc<dfloat>(mesh.SEMFEMInterp);
+    mesh.o_SEMFEMAnterp = elliptic.platform.malloc<dfloat>(SEMFEMAnterp);
+
+    memory<dfloat> dummy(mesh.Nelements*mesh.NpFEM,0.0); //need this to avoid uninitialized memory warnings
+    o_rFEM = elliptic.platform.malloc<dfloat>(dummy);
+    o_zFEM = elliptic.platform.malloc<dfloat>(dummy);
+
+    dlong Ncols = parAlmond.getNumCols(0);
+    dummy.malloc(Ncols,0.0);
+    o_GrFEM = elliptic.platform.malloc<dfloat>(dummy);
+    o_GzFEM = elliptic.platform.malloc<dfloat>(dummy);
+
+    o_MrL = elliptic.platform.malloc<dfloat>(mesh.Np*mesh.Nelements);
+
+    //build kernels
+    properties_t kernelInfo = mesh.props;
+
+    kernelInfo["defines/" "p_Np"]= mesh.Np;
+    kernelInfo["defines/" "p_NpFEM"]= mesh.NpFEM;
+
+    int NblockV = std::max(256/mesh.NpFEM, 1);
+    kernelInfo["defines/" "p_NblockV"]= NblockV;
+
+    SEMFEMInterpKernel = elliptic.platform.buildKernel(DELLIPTIC "/okl/ellipticSEMFEMInterp.okl",
+                                     "ellipticSEMFEMInterp", kernelInfo);
+
+    SEMFEMAnterpKernel = elliptic.platform.buildKernel(DELLIPTIC "/okl/ellipticSEMFEMAnterp.okl",
+                                     "ellipticSEMFEMAnterp", kernelInfo);
+  }
+}
+
+//build a low-order fem mesh on the (enriched) sem nodes and assemble its operator
+void SEMFEMPrecon::BuildFEMMatrix(parAlmond::parCOO& A) {
+
   //make a low-order fem mesh from the sem mesh (also return globalIds of the enriched sem nodes, and faceNode mapping)
   memory<hlong> globalIds;
   memory<int> mapB;
@@ -184,64 +255,5 @@ SEMFEMPrecon::SEMFEMPrecon(elliptic_t& _elliptic):
     }
   }
 
-  //finally, build the fem matrix and pass to parAlmond
-  if (mesh.rank==0){
-    printf("-----------------------------Multigrid AMG Setup--------------------------------------------\n");
-  }
-  parAlmond::parCOO A(elliptic.platform, femMesh.comm);
   femElliptic.BuildOperatorMatrixContinuous(A);
-
-  //populate null space unit vector
-  int rank = femMesh.rank;
-  int size = femMesh.size;
-  hlong TotalRows = A.globalRowStarts[size];
-  dlong numLocalRows = static_cast<dlong>(A.globalRowStarts[rank+1]-A.globalRowStarts[rank]);
-
-  memory<dfloat> null(numLocalRows);
-  for (dlong i=0;i<numLocalRows;i++) {
-    null[i] = 1.0/sqrt(TotalRows);
-  }
-
-  parAlmond.AMGSetup(A, elliptic.allNeumann, null, elliptic.allNeumannPenalty);
-
-  parAlmond.Report();
-
-  if (mesh.elementType==Mesh::TRIANGLES) {
-    // build interp and anterp
-    memory<dfloat> SEMFEMAnterp(mesh.NpFEM*mesh.Np);
-    for(int n=0;n<mesh.NpFEM;++n){
-      for(int m=0;m<mesh.Np;++m){
-        SEMFEMAnterp[n+m*mesh.NpFEM] = mesh.SEMFEMInterp[n*mesh.Np+m];
-      }
-    }
-
-    mesh.o_SEMFEMInterp = elliptic.platform.malloc<dfloat>(mesh.SEMFEMInterp);
-    mesh.o_SEMFEMAnterp = elliptic.platform.malloc<dfloat>(SEMFEMAnterp);
-
-    memory<dfloat> dummy(mesh.Nelements*mesh.NpFEM,0.0); //need this to avoid uninitialized memory warnings
-    o_rFEM = elliptic.platform.malloc<dfloat>(dummy);
-    o_zFEM = elliptic.platform.malloc<dfloat>(dummy);
-
-    dlong Ncols = parAlmond.getNumCols(0);
-    dummy.malloc(Ncols,0.0);
-    o_GrFEM = elliptic.platform.malloc<dfloat>(dummy);
-    o_GzFEM = elliptic.platform.malloc<dfloat>(dummy);
-
-    o_MrL = elliptic.platform.malloc<dfloat>(mesh.Np*mesh.Nelements);
-
-    //build kernels
-    properties_t kernelInfo = mesh.props;
-
-    kernelInfo["defines/" "p_Np"]= mesh.Np;
-    kernelInfo["defines/" "p_NpFEM"]= mesh.NpFEM;
-
-    int NblockV = std::max(256/mesh.NpFEM, 1);
-    kernelInfo["defines/" "p_NblockV"]= NblockV;
-
-    SEMFEMInterpKernel = elliptic.platform.buildKernel(DELLIPTIC "/okl/ellipticSEMFEMInterp.okl",
-                                     "ellipticSEMFEMInterp", kernelInfo);
-
-    SEMFEMAnterpKernel = elliptic.platform.buildKernel(DELLIPTIC "/okl/ellipticSEMFEMAnterp.okl",
-                                     "ellipticSEMFEMAnterp", kernelInfo);
-  }
 }
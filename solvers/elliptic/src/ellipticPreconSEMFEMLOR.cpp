@@ -0,0 +1,250 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "ellipticPrecon.hpp"
+
+#ifdef GLIBCXX_PARALLEL
+#include <parallel/algorithm>
+using __gnu_parallel::sort;
+#else
+using std::sort;
+#endif
+
+// Assemble the low-order refined (LOR) operator: each degree N quad/hex is split into
+//  N^d bilinear/trilinear sub-elements whose vertices are the GLL nodes of the element
+void SEMFEMPrecon::BuildLORMatrix(parAlmond::parCOO& A) {
+
+  const int dim = mesh.dim;
+  const int Nq = mesh.Nq;
+  const int N = mesh.N;
+  const int NK  = (dim==3) ? N  : 1;
+
+  const int Nverts = (dim==3) ? 8 : 4;  //vertices per sub-element
+  const int Ncub   = Nverts;            //2^d Gauss points per sub-element
+  const int NelLOR = N*N*NK;            //sub-elements per element
+
+  // number of degrees of freedom on this rank (after gathering)
+  hlong Ngather = elliptic.ogsMasked.Ngather;
+
+  // every gathered degree of freedom has its own global id
+  A.globalRowStarts.malloc(mesh.size+1,0);
+  A.globalColStarts.malloc(mesh.size+1,0);
+  mesh.comm.Allgather(Ngather, A.globalRowStarts+1);
+  for(int r=0;r<mesh.size;++r) {
+    A.globalRowStarts[r+1] = A.globalRowStarts[r]+A.globalRowStarts[r+1];
+    A.globalColStarts[r+1] = A.globalRowStarts[r+1];
+  }
+
+  // Q1 basis and its reference derivatives at the Gauss points
+  memory<dfloat> phi(Ncub*Nverts);
+  memory<dfloat> dphi(Ncub*Nverts*3, 0.0);
+  const dfloat rq[2] = {-1.0/sqrt(3.0), 1.0/sqrt(3.0)};
+  for (int q=0;q<Ncub;q++) {
+    for (int a=0;a<Nverts;a++) {
+      dfloat l[3], dl[3];
+      for (int d=0;d<dim;d++) {
+        const int ai = (a>>d)&1;
+        const dfloat r = rq[(q>>d)&1];
+        l[d]  = ai ? 0.5*(1.0+r) : 0.5*(1.0-r);
+        dl[d] = ai ? 0.5 : -0.5;
+      }
+      dfloat p = 1.0;
+      for (int d=0;d<dim;d++) p *= l[d];
+      phi[q*Nverts+a] = p;
+
+      for (int d=0;d<dim;d++) {
+        dfloat dp = dl[d];
+        for (int k=0;k<dim;k++) if (k!=d) dp *= l[k];
+        dphi[(q*Nverts+a)*3+d] = dp;
+      }
+    }
+  }
+
+  // Build non-zeros of the sub-element matrices (unassembled)
+  dlong nnzLocal = mesh.Nelements*NelLOR*Nverts*Nverts;
+  memory<parAlmond::parCOO::nonZero_t> sendNonZeros(nnzLocal);
+  memory<int> AsendCounts (mesh.size, 0);
+  memory<int> ArecvCounts (mesh.size);
+  memory<int> AsendOffsets(mesh.size+1);
+  memory<int> ArecvOffsets(mesh.size+1);
+
+  if(Comm::World().rank()==0) {printf("Building LOR FEM matrix...");fflush(stdout);}
+
+  dlong cnt =0;
+  for (dlong e=0;e<mesh.Nelements;e++) {
+    for (int k=0;k<NK;k++) {
+      for (int j=0;j<N;j++) {
+        for (int i=0;i<N;i++) {
+
+          //sub-element vertices, tensor ordered
+          dlong ids[8];
+          dfloat X[8][3];
+          for (int a=0;a<Nverts;a++) {
+            const int n = (i+(a&1)) + (j+((a>>1)&1))*Nq + (k+((a>>2)&1))*Nq*Nq;
+            ids[a] = e*mesh.Np + n;
+            X[a][0] = mesh.x[ids[a]];
+            X[a][1] = mesh.y[ids[a]];
+            X[a][2] = (dim==3) ? mesh.z[ids[a]] : 0.0;
+          }
+
+          dfloat Ae[8][8] = {{0.0}};
+          for (int q=0;q<Ncub;q++) {
+            //Jacobian of the multilinear map, J[m][d] = dx_m/dr_d
+            dfloat J[3][3] = {{0.0}};
+            for (int a=0;a<Nverts;a++)
+              for (int m=0;m<dim;m++)
+                for (int d=0;d<dim;d++)
+                  J[m][d] += X[a][m]*dphi[(q*Nverts+a)*3+d];
+
+            //invJ[d][m] = dr_d/dx_m
+            dfloat invJ[3][3] = {{0.0}};
+            dfloat detJ;
+            if (dim==2) {
+              detJ = J[0][0]*J[1][1] - J[0][1]*J[1][0];
+              invJ[0][0] =  J[1][1]/detJ; invJ[0][1] = -J[0][1]/detJ;
+              invJ[1][0] = -J[1][0]/detJ; invJ[1][1] =  J[0][0]/detJ;
+            } else {
+              detJ = J[0][0]*(J[1][1]*J[2][2]-J[1][2]*J[2][1])
+                    -J[0][1]*(J[1][0]*J[2][2]-J[1][2]*J[2][0])
+                    +J[0][2]*(J[1][0]*J[2][1]-J[1][1]*J[2][0]);
+              for (int d=0;d<3;d++) {
+                for (int m=0;m<3;m++) {
+                  const int d1=(d+1)%3, d2=(d+2)%3;
+                  const int m1=(m+1)%3, m2=(m+2)%3;
+                  invJ[d][m] = (J[m1][d1]*J[m2][d2] - J[m1][d2]*J[m2][d1])/detJ;
+                }
+              }
+            }
+
+            LIBP_ABORT("Non-positive Jacobian in LOR sub-element of element " << e,
+                       detJ<=0.0);
+
+            dfloat grad[8][3];
+            for (int a=0;a<Nverts;a++) {
+              for (int m=0;m<dim;m++) {
+                grad[a][m] = 0.0;
+                for (int d=0;d<dim;d++)
+                  grad[a][m] += dphi[(q*Nverts+a)*3+d]*invJ[d][m];
+              }
+            }
+
+            for (int a=0;a<Nverts;a++) {
+              for (int b=0;b<Nverts;b++) {
+                dfloat gg = 0.0;
+                for (int m=0;m<dim;m++) gg += grad[a][m]*grad[b][m];
+                Ae[a][b] += detJ*gg;
+              }
+              //lumped mass, consistent with the diagonal GLL mass
+              Ae[a][a] += detJ*elliptic.lambda*phi[q*Nverts+a];
+            }
+          }
+
+          for (int a=0;a<Nverts;a++) {
+            const hlong row = elliptic.maskedGlobalNumbering[ids[a]];
+            if (row<0) continue; //skip masked nodes
+            for (int b=0;b<Nverts;b++) {
+              const hlong col = elliptic.maskedGlobalNumbering[ids[b]];
+              if (col<0) continue; //skip masked nodes
+
+              dfloat nonZeroThreshold = 1e-7;
+              if (fabs(Ae[a][b])>nonZeroThreshold) {
+                sendNonZeros[cnt].val = Ae[a][b];
+                sendNonZeros[cnt].row = row;
+                sendNonZeros[cnt].col = col;
+                cnt++;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // sort by row ordering
+  sort(sendNonZeros.ptr(), sendNonZeros.ptr()+cnt,
+      [](const parAlmond::parCOO::nonZero_t& a,
+         const parAlmond::parCOO::nonZero_t& b) {
+        if (a.row < b.row) return true;
+        if (a.row > b.row) return false;
+
+        return a.col < b.col;
+      });
+
+  // count how many non-zeros to send to each process
+  int rr=0;
+  for(dlong n=0;n<cnt;++n) {
+    const hlong id = sendNonZeros[n].row;
+    while(id>=A.globalRowStarts[rr+1]) rr++;
+    AsendCounts[rr]++;
+  }
+
+  // find how many nodes to expect (should use sparse version)
+  mesh.comm.Alltoall(AsendCounts, ArecvCounts);
+
+  // find send and recv offsets for gather
+  A.nnz = 0;
+  AsendOffsets[0] = 0;
+  ArecvOffsets[0] = 0;
+  for(int r=0;r<mesh.size;++r){
+    AsendOffsets[r+1] = AsendOffsets[r] + AsendCounts[r];
+    ArecvOffsets[r+1] = ArecvOffsets[r] + ArecvCounts[r];
+    A.nnz += ArecvCounts[r];
+  }
+
+  A.entries.malloc(A.nnz);
+
+  // determine number to receive
+  mesh.comm.Alltoallv(sendNonZeros, AsendCounts, AsendOffsets,
+                      A.entries,    ArecvCounts, ArecvOffsets);
+
+  // sort received non-zero entries by row block
+  sort(A.entries.ptr(), A.entries.ptr()+A.nnz,
+      [](const parAlmond::parCOO::nonZero_t& a,
+         const parAlmond::parCOO::nonZero_t& b) {
+        if (a.row < b.row) return true;
+        if (a.row > b.row) return false;
+
+        return a.col < b.col;
+      });
+
+  // compress duplicates
+  cnt = 0;
+  for(dlong n=1;n<A.nnz;++n){
+    if(A.entries[n].row == A.entries[cnt].row &&
+       A.entries[n].col == A.entries[cnt].col){
+       A.entries[cnt].val += A.entries[n].val;
+    }
+    else{
+      ++cnt;
+      A.entries[cnt] = A.entries[n];
+    }
+  }
+  if (A.nnz) cnt++;
+  A.nnz = cnt;
+
+  if(Comm::World().rank()==0) printf("done.\n");
+}
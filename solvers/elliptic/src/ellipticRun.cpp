@@ -39,15 +39,15 @@ void elliptic_t::Run(){
 
   linearSolver_t linearSolver;
   if (settings.compareSetting("LINEAR SOLVER","NBPCG")){
-    linearSolver.Setup<LinearSolver::nbpcg>(Ndofs, Nhalo, platform, settings, comm);
+    linearSolver.Setup<LinearSolver::nbpcg>(NsolveDofs, NsolveHalo, platform, settings, comm);
   } else if (settings.compareSetting("LINEAR SOLVER","NBFPCG")){
-    linearSolver.Setup<LinearSolver::nbfpcg>(Ndofs, Nhalo, platform, settings, comm);
+    linearSolver.Setup<LinearSolver::nbfpcg>(NsolveDofs, NsolveHalo, platform, settings, comm);
   } else if (settings.compareSetting("LINEAR SOLVER","PCG")){
-    linearSolver.Setup<LinearSolver::pcg>(Ndofs, Nhalo, platform, settings, comm);
+    linearSolver.Setup<LinearSolver::pcg>(NsolveDofs, NsolveHalo, platform, settings, comm);
   } else if (settings.compareSetting("LINEAR SOLVER","PGMRES")){
-    linearSolver.Setup<LinearSolver::pgmres>(Ndofs, Nhalo, platform, settings, comm);
+    linearSolver.Setup<LinearSolver::pgmres>(NsolveDofs, NsolveHalo, platform, settings, comm);
   } else if (settings.compareSetting("LINEAR SOLVER","PMINRES")){
-    linearSolver.Setup<LinearSolver::pminres>(Ndofs, Nhalo, platform, settings, comm);
+    linearSolver.Setup<LinearSolver::pminres>(NsolveDofs, NsolveHalo, platform, settings, comm);
   }
 
   properties_t kernelInfo = mesh.props; //copy base occa properties
@@ -104,7 +104,10 @@ void elliptic_t::Run(){
     fileName   = oklFilePrefix + "ellipticRhsBC" + suffix + oklFileSuffix;
     kernelName = "ellipticRhsBC" + suffix;
 
-    rhsBCKernel = platform.buildKernel(fileName, kernelName, kernelInfo);
+    properties_t rhsBCKernelInfo = kernelInfo;
+    rhsBCKernelInfo["defines/" "p_collocationLift"] = cubatureAx ? 0 : 1;
+
+    rhsBCKernel = platform.buildKernel(fileName, kernelName, rhsBCKernelInfo);
 
     fileName   = oklFilePrefix + "ellipticAddBC" + suffix + oklFileSuffix;
     kernelName = "ellipticAddBC" + suffix;
@@ -176,6 +179,31 @@ void elliptic_t::Run(){
                 mesh.o_z,
                 o_mapB,
                 o_rL);
+
+    if (cubatureAx) {
+      //lift the Dirichlet data with the same over-integrated Ax the
+      // solve uses, rhs -= A*uBC, reading the local nodes directly
+      deviceMemory<dfloat> o_bcL  = platform.malloc<dfloat>(xL);
+      deviceMemory<dfloat> o_AbcL = platform.malloc<dfloat>(xL);
+      addBCKernel(mesh.Nelements,
+                  mesh.o_x,
+                  mesh.o_y,
+                  mesh.o_z,
+                  o_mapB,
+                  o_bcL);
+
+      memory<dlong> elementList(mesh.Nelements);
+      for (dlong e=0;e<mesh.Nelements;e++) elementList[e] = e;
+
+      memory<dlong> localIds(mesh.Nelements*mesh.Np);
+      for (dlong n=0;n<mesh.Nelements*mesh.Np;n++) localIds[n] = n;
+
+      deviceMemory<dlong> o_elementList = platform.malloc<dlong>(elementList);
+      deviceMemory<dlong> o_localIds    = platform.malloc<dlong>(localIds);
+
+      PartialAx(mesh.Nelements, o_elementList, o_localIds, o_bcL, o_AbcL);
+      platform.linAlg().axpy(mesh.Nelements*mesh.Np, -1.0, o_AbcL, 1.0, o_rL);
+    }
   }
 
   // gather rhs to globalDofs if c0
@@ -61,6 +61,16 @@ void ellipticAddSettings(settings_t& settings,
                       "Type of Finite Element Discretization",
                       {"CONTINUOUS", "IPDG"});
 
+  settings.newSetting(prefix+"INTEGRATION",
+                      "COLLOCATION",
+                      "Type of integration rule for the continuous Ax (CUBATURE on hexes only)",
+                      {"COLLOCATION", "CUBATURE"});
+
+  settings.newSetting(prefix+"STATIC CONDENSATION",
+                      "FALSE",
+                      "Eliminate element interiors before the linear solve (CONTINUOUS on hexes, JACOBI, PARALMOND, or NONE preconditioner)",
+                      {"TRUE", "FALSE"});
+
   settings.newSetting(prefix+"LINEAR SOLVER",
                       "PCG",
                       "Iterative Linear Solver to use for solve",
@@ -85,7 +95,7 @@ void ellipticAddSettings(settings_t& settings,
   settings.newSetting(prefix+"MULTIGRID SMOOTHER",
                       "CHEBYSHEV",
                       "p-Multigrid smoother",
-                      {"DAMPEDJACOBI", "CHEBYSHEV"});
+                      {"DAMPEDJACOBI", "CHEBYSHEV", "SCHWARZ", "CHEBYSHEV+SCHWARZ"});
 
   settings.newSetting(prefix+"MULTIGRID CHEBYSHEV DEGREE",
                       "2",
@@ -105,6 +115,10 @@ void ellipticSettings_t::report() {
 
     reportSetting("LAMBDA");
     reportSetting("DISCRETIZATION");
+    if (compareSetting("DISCRETIZATION","CONTINUOUS")) {
+      reportSetting("INTEGRATION");
+      reportSetting("STATIC CONDENSATION");
+    }
     reportSetting("LINEAR SOLVER");
     reportSetting("PRECONDITIONER");
 
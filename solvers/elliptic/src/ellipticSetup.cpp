@@ -45,8 +45,27 @@ void elliptic_t::Setup(platform_t& _platform, mesh_t& _mesh,
   disc_ipdg = settings.compareSetting("DISCRETIZATION","IPDG");
   disc_c0   = settings.compareSetting("DISCRETIZATION","CONTINUOUS");
 
+  cubatureAx = settings.compareSetting("INTEGRATION","CUBATURE");
+  LIBP_ABORT("Cubature integration only supported for continuous hexahedral discretizations",
+             cubatureAx && !(disc_c0 && mesh.elementType==Mesh::HEXAHEDRA));
+
+  staticCondensation = settings.compareSetting("STATIC CONDENSATION","TRUE");
+  LIBP_ABORT("Static condensation only supported for continuous hexahedral discretizations",
+             staticCondensation && !(disc_c0 && mesh.elementType==Mesh::HEXAHEDRA));
+  LIBP_ABORT("Static condensation not supported with cubature integration",
+             staticCondensation && cubatureAx);
+  LIBP_ABORT("Static condensation not supported with a trilinear element map",
+             staticCondensation && mesh.settings.compareSetting("ELEMENT MAP", "TRILINEAR"));
+  LIBP_ABORT("Static condensation only supported with the JACOBI, PARALMOND, or NONE preconditioner",
+             staticCondensation && !(settings.compareSetting("PRECONDITIONER", "JACOBI")
+                                   ||settings.compareSetting("PRECONDITIONER", "PARALMOND")
+                                   ||settings.compareSetting("PRECONDITIONER", "NONE")));
+
+  //over-integrated Ax needs the geometric factors at the cubature nodes
+  if (cubatureAx) mesh.CubatureGeometricFactors();
+
   //setup linear algebra module
-  platform.linAlg().InitKernels({"add", "sum", "scale",
+  platform.linAlg().InitKernels({"set", "add", "sum", "scale",
                                 "axpy", "zaxpy",
                                 "amx", "amxpy", "zamxpy",
                                 "adx", "adxpy", "zadxpy",
@@ -128,7 +147,10 @@ void elliptic_t::Setup(platform_t& _platform, mesh_t& _mesh,
   if (settings.compareSetting("DISCRETIZATION","CONTINUOUS")) {
     fileName   = oklFilePrefix + "ellipticAx" + suffix + oklFileSuffix;
     if(mesh.elementType==Mesh::HEXAHEDRA){
-      if(mesh.settings.compareSetting("ELEMENT MAP", "TRILINEAR"))
+      if(cubatureAx) {
+        fileName   = oklFilePrefix + "ellipticCubatureAx" + suffix + oklFileSuffix;
+        kernelName = "ellipticCubaturePartialAx" + suffix;
+      } else if(mesh.settings.compareSetting("ELEMENT MAP", "TRILINEAR"))
         kernelName = "ellipticPartialAxTrilinear" + suffix;
       else
         kernelName = "ellipticPartialAx" + suffix;
@@ -139,6 +161,15 @@ void elliptic_t::Setup(platform_t& _platform, mesh_t& _mesh,
     partialAxKernel = platform.buildKernel(fileName, kernelName,
                                            kernelInfo);
 
+    // device operator diagonal for tensor-product elements
+    if ((mesh.elementType==Mesh::QUADRILATERALS && mesh.dim==2)
+      || mesh.elementType==Mesh::HEXAHEDRA) {
+      fileName   = oklFilePrefix + "ellipticOperatorDiagonal" + suffix + oklFileSuffix;
+      kernelName = "ellipticOperatorDiagonal" + suffix;
+      operatorDiagonalKernel = platform.buildKernel(fileName, kernelName,
+                                                    kernelInfo);
+    }
+
   } else if (settings.compareSetting("DISCRETIZATION","IPDG")) {
     int Nmax = std::max(mesh.Np, mesh.Nfaces*mesh.Nfp);
     kernelInfo["defines/" "p_Nmax"]= Nmax;
@@ -163,7 +194,10 @@ void elliptic_t::Setup(platform_t& _platform, mesh_t& _mesh,
     Nhalo = mesh.totalHaloPairs*mesh.Np*Nfields;
   }
 
-  if       (settings.compareSetting("PRECONDITIONER", "JACOBI"))
+  //static condensation brings its own skeleton preconditioner
+  if       (staticCondensation)
+    StaticCondensationSetup();
+  else if  (settings.compareSetting("PRECONDITIONER", "JACOBI"))
     precon.Setup<JacobiPrecon>(*this);
   else if(settings.compareSetting("PRECONDITIONER", "MASSMATRIX"))
     precon.Setup<MassMatrixPrecon>(*this);
@@ -177,4 +211,14 @@ void elliptic_t::Setup(platform_t& _platform, mesh_t& _mesh,
     precon.Setup<OASPrecon>(*this);
   else if(settings.compareSetting("PRECONDITIONER", "NONE"))
     precon.Setup<IdentityPrecon>(Ndofs);
+
+  //the Krylov solver works on the skeleton dofs alone under static
+  // condensation. Otherwise the preconditioner may have grown Nhalo
+  if (staticCondensation) {
+    NsolveDofs = Nskeleton;
+    NsolveHalo = NskeletonHalo;
+  } else {
+    NsolveDofs = Ndofs;
+    NsolveHalo = Nhalo;
+  }
 }
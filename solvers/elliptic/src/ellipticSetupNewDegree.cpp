@@ -37,8 +37,9 @@ elliptic_t elliptic_t::SetupNewDegree(mesh_t& meshC){
 
   elliptic.mesh = meshC;
 
-  /*setup trace halo exchange */
-  elliptic.traceHalo = meshC.HaloTraceSetup(Nfields);
+  /*setup trace halo exchange (only the IPDG operator uses it) */
+  if (settings.compareSetting("DISCRETIZATION","IPDG"))
+    elliptic.traceHalo = meshC.HaloTraceSetup(Nfields);
 
   //setup boundary flags and make mask and masked ogs
   elliptic.BoundarySetup();
@@ -102,7 +103,10 @@ elliptic_t elliptic_t::SetupNewDegree(mesh_t& meshC){
   if (settings.compareSetting("DISCRETIZATION","CONTINUOUS")) {
     fileName   = oklFilePrefix + "ellipticAx" + suffix + oklFileSuffix;
     if(meshC.elementType==Mesh::HEXAHEDRA){
-      if(mesh.settings.compareSetting("ELEMENT MAP", "TRILINEAR"))
+      if(cubatureAx) {
+        fileName   = oklFilePrefix + "ellipticCubatureAx" + suffix + oklFileSuffix;
+        kernelName = "ellipticCubaturePartialAx" + suffix;
+      } else if(mesh.settings.compareSetting("ELEMENT MAP", "TRILINEAR"))
         kernelName = "ellipticPartialAxTrilinear" + suffix;
       else
         kernelName = "ellipticPartialAx" + suffix;
@@ -113,6 +117,15 @@ elliptic_t elliptic_t::SetupNewDegree(mesh_t& meshC){
     elliptic.partialAxKernel = platform.buildKernel(fileName, kernelName,
                                             kernelInfo);
 
+    // device operator diagonal for tensor-product elements
+    if ((meshC.elementType==Mesh::QUADRILATERALS && meshC.dim==2)
+      || meshC.elementType==Mesh::HEXAHEDRA) {
+      fileName   = oklFilePrefix + "ellipticOperatorDiagonal" + suffix + oklFileSuffix;
+      kernelName = "ellipticOperatorDiagonal" + suffix;
+      elliptic.operatorDiagonalKernel = platform.buildKernel(fileName, kernelName,
+                                                             kernelInfo);
+    }
+
   } else if (settings.compareSetting("DISCRETIZATION","IPDG")) {
     int Nmax = std::max(meshC.Np, meshC.Nfaces*meshC.Nfp);
     kernelInfo["defines/" "p_Nmax"]= Nmax;
@@ -136,6 +149,11 @@ elliptic_t elliptic_t::SetupNewDegree(mesh_t& meshC){
     elliptic.Nhalo = meshC.totalHaloPairs*meshC.Np*Nfields;
   }
 
+  //coarse levels act on the full system
+  elliptic.staticCondensation = 0;
+  elliptic.NsolveDofs = elliptic.Ndofs;
+  elliptic.NsolveHalo = elliptic.Nhalo;
+
   elliptic.precon = precon_t();
 
   return elliptic;
@@ -38,6 +38,9 @@ elliptic_t elliptic_t::SetupRingPatch(mesh_t& meshPatch){
   elliptic.mesh = meshPatch;
   elliptic.comm = meshPatch.comm;
 
+  //over-integrated Ax needs the geometric factors at the cubature nodes
+  if (cubatureAx) elliptic.mesh.CubatureGeometricFactors();
+
   //buffer for gradient
   if (settings.compareSetting("DISCRETIZATION","IPDG")) {
     dlong Ntotal = meshPatch.Np*meshPatch.Nelements;
@@ -61,6 +64,11 @@ elliptic_t elliptic_t::SetupRingPatch(mesh_t& meshPatch){
     elliptic.Ndofs = meshPatch.Nelements*meshPatch.Np*Nfields;
   }
 
+  //patch problems act on the full system
+  elliptic.staticCondensation = 0;
+  elliptic.NsolveDofs = elliptic.Ndofs;
+  elliptic.NsolveHalo = elliptic.Nhalo;
+
   elliptic.precon = precon_t();
 
   return elliptic;
@@ -25,6 +25,7 @@ SOFTWARE.
 */
 
 #include "elliptic.hpp"
+#include "ellipticPrecon.hpp"
 
 int elliptic_t::Solve(linearSolver_t& linearSolver,
                       deviceMemory<dfloat> &o_x, deviceMemory<dfloat> &o_r,
@@ -33,7 +34,21 @@ int elliptic_t::Solve(linearSolver_t& linearSolver,
   // if there is a nullspace, remove the constant vector from r
   if(allNeumann) ZeroMean(o_r);
 
+  // solve for the skeleton dofs only
+  if (staticCondensation)
+    return SolveCondensed(linearSolver, o_x, o_r, tol, MAXIT, verbose);
+
+  // lambda may have changed since the preconditioner was built
+  PreconUpdate();
+
   int Niter = linearSolver.Solve(*this, precon, o_x, o_r, tol, MAXIT, verbose);
 
   return Niter;
 }
+
+void elliptic_t::PreconUpdate(){
+  if (settings.compareSetting("PRECONDITIONER", "JACOBI"))
+    precon.Get<JacobiPrecon>().Update(lambda);
+  else if (settings.compareSetting("PRECONDITIONER", "MULTIGRID"))
+    precon.Get<MultiGridPrecon>().Update(lambda);
+}
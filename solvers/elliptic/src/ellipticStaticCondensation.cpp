@@ -0,0 +1,492 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "elliptic.hpp"
+#include <limits>
+
+namespace {
+
+//Schur complement on the skeleton dofs
+class condensedOperator_t: public operator_t {
+public:
+  elliptic_t& elliptic;
+
+  condensedOperator_t(elliptic_t& _elliptic): elliptic(_elliptic) {}
+
+  void Operator(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Sq) {
+    elliptic.CondensedOperator(o_q, o_Sq);
+  }
+};
+
+//preconditioner acting on the skeleton dofs
+class condensedPrecon_t: public operator_t {
+public:
+  elliptic_t& elliptic;
+
+  condensedPrecon_t(elliptic_t& _elliptic): elliptic(_elliptic) {}
+
+  void Operator(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr) {
+    elliptic.CondensedPrecon(o_r, o_Mr);
+  }
+};
+
+//a box element has a constant, diagonal metric. Its interior block is then
+// gx A(x)B(x)B + gy B(x)A(x)B + gz B(x)B(x)A + lambda J B(x)B(x)B, with the
+// 1D stiffness A and mass B, and scale holds {gx, gy, gz, J}
+bool BoxElement(mesh_t& mesh, const dlong e, dfloat scale[4]) {
+
+  const int Nq = mesh.Nq;
+  const dfloat tol = 1.0e3*std::numeric_limits<dfloat>::epsilon();
+  const dlong base = e*mesh.Np*mesh.Nggeo;
+
+  for (int n=0;n<mesh.Np;n++) {
+    const int i = n%Nq, j = (n/Nq)%Nq, k = n/(Nq*Nq);
+    const dfloat wq = mesh.gllw[i]*mesh.gllw[j]*mesh.gllw[k];
+
+    const dfloat Grr = mesh.ggeo[base + n + mesh.G00ID*mesh.Np]/wq;
+    const dfloat Grs = mesh.ggeo[base + n + mesh.G01ID*mesh.Np]/wq;
+    const dfloat Grt = mesh.ggeo[base + n + mesh.G02ID*mesh.Np]/wq;
+    const dfloat Gss = mesh.ggeo[base + n + mesh.G11ID*mesh.Np]/wq;
+    const dfloat Gst = mesh.ggeo[base + n + mesh.G12ID*mesh.Np]/wq;
+    const dfloat Gtt = mesh.ggeo[base + n + mesh.G22ID*mesh.Np]/wq;
+    const dfloat J   = mesh.wJ[e*mesh.Np + n]/wq;
+
+    if (n==0) {
+      scale[0] = Grr; scale[1] = Gss; scale[2] = Gtt; scale[3] = J;
+    }
+
+    const dfloat gmax = std::max(scale[0], std::max(scale[1], scale[2]));
+    if (std::abs(Grs)>tol*gmax
+     || std::abs(Grt)>tol*gmax
+     || std::abs(Gst)>tol*gmax) return false;
+
+    if (std::abs(Grr-scale[0])>tol*scale[0]
+     || std::abs(Gss-scale[1])>tol*scale[1]
+     || std::abs(Gtt-scale[2])>tol*scale[2]
+     || std::abs(J  -scale[3])>tol*scale[3]) return false;
+  }
+  return true;
+}
+
+} //namespace
+
+void elliptic_t::StaticCondensationSetup() {
+
+  LIBP_ABORT("Static condensation needs interior nodes (N>1)",
+             mesh.N<2);
+
+  const int Nq = mesh.Nq;
+  const int Nqi = Nq-2;
+  const dlong Nlocal = mesh.Nelements*mesh.Np;
+  Ninterior = Nqi*Nqi*Nqi;
+
+  // order the elements with the boxes first
+  condensedElements.malloc(mesh.Nelements);
+  memory<dfloat> scales(4*mesh.Nelements);
+  memory<int> isBox(mesh.Nelements);
+  Naffine = 0;
+  for (dlong e=0;e<mesh.Nelements;e++) {
+    isBox[e] = BoxElement(mesh, e, scales.ptr()+4*e);
+    if (isBox[e]) condensedElements[Naffine++] = e;
+  }
+  dlong cnt = Naffine;
+  for (dlong e=0;e<mesh.Nelements;e++) {
+    if (!isBox[e]) condensedElements[cnt++] = e;
+  }
+
+  interiorScale.malloc(4*Naffine);
+  for (dlong b=0;b<Naffine;b++) {
+    for (int d=0;d<4;d++) {
+      interiorScale[4*b+d] = scales[4*condensedElements[b]+d];
+    }
+  }
+
+  // Interior nodes are never shared or masked, so the interior block of
+  // each element is local. Zeroing their ids leaves the skeleton numbering
+  const dlong NinteriorTotal = mesh.Nelements*Ninterior;
+  memory<dlong> interiorIds(NinteriorTotal);
+  memory<hlong> skeletonGlobalIds(Nlocal);
+  skeletonGlobalIds.copyFrom(maskedGlobalIds);
+
+  for (dlong b=0;b<mesh.Nelements;b++) {
+    const dlong e = condensedElements[b];
+    for (int i=0;i<Ninterior;i++) {
+      const int n = 1+i%Nqi + (1+(i/Nqi)%Nqi)*Nq + (1+i/(Nqi*Nqi))*Nq*Nq;
+      const dlong id = GlobalToLocal[e*mesh.Np + n];
+      LIBP_ABORT("Interior node " << n << " of element " << e << " is not a local dof",
+                 id<0 || id>=Ndofs);
+      interiorIds[b*Ninterior + i] = e*mesh.Np + n;
+      skeletonGlobalIds[e*mesh.Np + n] = 0;
+    }
+  }
+  o_interiorIds = platform.malloc<dlong>(interiorIds);
+
+  //gather and halo exchange on the skeleton dofs alone
+  bool verbose = settings.compareSetting("VERBOSE", "TRUE") ? true : false;
+  bool unique = true;
+  ogsSkeleton.Setup(Nlocal, skeletonGlobalIds,
+                    mesh.comm, ogs::Signed, ogs::Auto,
+                    unique, verbose, platform);
+  skeletonHalo.SetupFromGather(ogsSkeleton);
+
+  memory<dlong> SkeletonToLocal(Nlocal);
+  ogsSkeleton.SetupGlobalToLocalMapping(SkeletonToLocal);
+  o_SkeletonToLocal = platform.malloc<dlong>(SkeletonToLocal);
+
+  Nskeleton = ogsSkeleton.Ngather;
+  NskeletonHalo = skeletonHalo.Nhalo;
+
+  //AMG on the assembled Schur complement. Like the full-system AMG, it
+  // is built for the lambda at setup and not rebuilt when lambda changes
+  if (settings.compareSetting("PRECONDITIONER", "PARALMOND")) {
+    //consecutive global numbering of the gathered skeleton dofs
+    hlong NskeletonLocal = Nskeleton;
+    hlong skeletonOffset = NskeletonLocal;
+    mesh.comm.Scan(NskeletonLocal, skeletonOffset);
+    skeletonOffset -= NskeletonLocal;
+
+    memory<hlong> skeletonIds(Nskeleton);
+    for (dlong n=0;n<Nskeleton;n++) {
+      skeletonIds[n] = n + skeletonOffset;
+    }
+
+    skeletonGlobalNumbering.malloc(Nlocal, -1);
+    ogsSkeleton.Scatter(skeletonGlobalNumbering, skeletonIds, 1, ogs::NoTrans);
+
+    if (Comm::World().rank()==0){
+      printf("-----------------------------Condensed AMG Setup--------------------------------------------\n");
+    }
+    parAlmond::parCOO A(platform, mesh.comm);
+    BuildCondensedMatrixContinuousHex3D(A);
+
+    //populate null space unit vector
+    hlong TotalRows = A.globalRowStarts[mesh.size];
+    memory<dfloat> null(Nskeleton);
+    for (dlong i=0;i<Nskeleton;i++) {
+      null[i] = 1.0/sqrt(TotalRows);
+    }
+
+    condensedAMG.Setup(platform, settings, mesh.comm);
+    condensedAMG.AMGSetup(A, allNeumann, null, allNeumannPenalty);
+    condensedAMG.Report();
+
+    //the top AMG level may have a larger halo than the skeleton
+    const dlong amgNhalo = condensedAMG.getNumCols(0) - condensedAMG.getNumRows(0);
+    NskeletonHalo = std::max(NskeletonHalo, amgNhalo);
+  }
+
+  o_qI = platform.malloc<dfloat>(NinteriorTotal);
+  o_AqI = platform.malloc<dfloat>(NinteriorTotal);
+
+  //only the interior nodes of o_qL are ever written, the rest stay zero
+  memory<dfloat> zeros(Nlocal, 0.0);
+  o_qL = platform.malloc<dfloat>(zeros);
+  o_condRL = platform.malloc<dfloat>(Nlocal);
+  o_AqIL = platform.malloc<dfloat>(Nlocal);
+
+  o_rS = platform.malloc<dfloat>(Nskeleton+NskeletonHalo);
+  o_xS = platform.malloc<dfloat>(Nskeleton+NskeletonHalo);
+
+  if (settings.compareSetting("PRECONDITIONER", "JACOBI"))
+    o_invDiagS = platform.malloc<dfloat>(Nskeleton);
+
+  //1D stiffness and mass on the interior nodes, symmetrically scaled,
+  // and their generalized eigenvectors
+  memory<double> A(Nqi*Nqi), V(Nqi*Nqi);
+  memory<double> WR(Nqi), WI(Nqi);
+  memory<double> invSqrtB(Nqi);
+
+  for (int i=0;i<Nqi;i++) {
+    invSqrtB[i] = 1.0/sqrt(mesh.gllw[i+1]);
+  }
+  for (int i=0;i<Nqi;i++) {
+    for (int j=0;j<Nqi;j++) {
+      double a = 0.0;
+      for (int m=0;m<Nq;m++) {
+        a += mesh.D[m*Nq+i+1]*mesh.gllw[m]*mesh.D[m*Nq+j+1];
+      }
+      A[i*Nqi+j] = invSqrtB[i]*a*invSqrtB[j];
+    }
+  }
+
+  linAlg_t::matrixEigenVectors(Nqi, A, V, WR, WI);
+
+  //every box uses the same reference operators in all three directions,
+  // so the FDM kernel reads a single copy
+  memory<dfloat> S   (Nqi*Nqi);
+  memory<dfloat> Sinv(Nqi*Nqi);
+  interiorMu.malloc(Nqi);
+
+  for (int i=0;i<Nqi;i++) {
+    interiorMu[i] = WR[i];
+    for (int j=0;j<Nqi;j++) {
+      S[i*Nqi+j] = invSqrtB[i]*V[i*Nqi+j];
+    }
+  }
+
+  linAlg_t::matrixInverse(Nqi, V);
+
+  for (int i=0;i<Nqi;i++) {
+    for (int j=0;j<Nqi;j++) {
+      Sinv[i*Nqi+j] = V[i*Nqi+j]*invSqrtB[j];
+    }
+  }
+
+  o_interiorS    = platform.malloc<dfloat>(S);
+  o_interiorSinv = platform.malloc<dfloat>(Sinv);
+  o_interiorInvL = platform.malloc<dfloat>(Naffine*Ninterior);
+
+  //curved interiors keep dense inverse blocks
+  const dlong Ncurved = mesh.Nelements - Naffine;
+  o_invAii = platform.malloc<dfloat>(static_cast<size_t>(Ncurved)*Ninterior*Ninterior);
+  platform.linAlg().InitBatchedGEMV(Ninterior, Ninterior);
+
+  properties_t kernelInfo = mesh.props; //copy base occa properties
+
+  std::string fileName = DELLIPTIC "/okl/ellipticStaticCondensation.okl";
+  condensedGatherKernel  = platform.buildKernel(fileName, "ellipticCondensedGather",
+                                                kernelInfo);
+  condensedScatterKernel = platform.buildKernel(fileName, "ellipticCondensedScatter",
+                                                kernelInfo);
+
+  //element-local Ax, without a gather
+  fileName = DELLIPTIC "/okl/ellipticAxHex3D.okl";
+  localAxKernel = platform.buildKernel(fileName, "ellipticAxHex3D",
+                                       kernelInfo);
+
+  //fast diagonalization on the (Nq-2)^3 interior nodes
+  properties_t fdmInfo = mesh.props;
+  fdmInfo["defines/" "p_NqE"] = Nqi;
+  fdmInfo["defines/" "p_NpE"] = Ninterior;
+  fdmInfo["defines/" "p_fdmDirStride"] = 0;
+  fdmInfo["defines/" "p_fdmElementStride"] = 0;
+  fileName = DELLIPTIC "/okl/ellipticPreconFDMHex3D.okl";
+  interiorFDMKernel = platform.buildKernel(fileName, "ellipticPreconFDMHex3D",
+                                           fdmInfo);
+
+  StaticCondensationUpdate();
+}
+
+//rebuild the interior solves and the skeleton diagonal for the current lambda
+void elliptic_t::StaticCondensationUpdate() {
+
+  const int Nqi = mesh.Nq-2;
+
+  //boxes: the separable eigenvalues pick up lambda through the mass scale
+  if (Naffine) {
+    memory<dfloat> invL(Naffine*Ninterior);
+    for (dlong b=0;b<Naffine;b++) {
+      const dfloat gx = interiorScale[4*b+0];
+      const dfloat gy = interiorScale[4*b+1];
+      const dfloat gz = interiorScale[4*b+2];
+      const dfloat J  = interiorScale[4*b+3];
+      for (int n=0;n<Ninterior;n++) {
+        const int i = n%Nqi;
+        const int j = (n/Nqi)%Nqi;
+        const int k = n/(Nqi*Nqi);
+        invL[b*Ninterior + n] = 1.0/(gx*interiorMu[i] + gy*interiorMu[j]
+                                    + gz*interiorMu[k] + lambda*J);
+      }
+    }
+    o_interiorInvL.copyFrom(invL);
+  }
+
+  //curved elements: dense inverses of the interior blocks
+  const dlong Ncurved = mesh.Nelements - Naffine;
+  if (Ncurved) {
+    memory<dfloat> Aii;
+    BuildInteriorMatricesContinuousHex3D(Ncurved, condensedElements+Naffine, Aii);
+    linAlg_t::matrixInverseBatched(Ncurved, Ninterior, Aii);
+    o_invAii.copyFrom(Aii);
+  }
+
+  //skeleton Jacobi uses the diagonal of the assembled skeleton block
+  if (settings.compareSetting("PRECONDITIONER", "JACOBI")) {
+    linAlg_t& linAlg = platform.linAlg();
+
+    deviceMemory<dfloat> o_diagAL = platform.malloc<dfloat>(mesh.Np*mesh.Nelements);
+    deviceMemory<dfloat> o_diagS  = platform.malloc<dfloat>(Nskeleton);
+
+    const dfloat boost = 0.0;
+    operatorDiagonalKernel(mesh.Nelements, mesh.o_wJ, mesh.o_ggeo, mesh.o_D,
+                           lambda, boost, o_diagAL);
+    ogsSkeleton.Gather(o_diagS, o_diagAL, 1, ogs::Add, ogs::Trans);
+
+    // invDiagS = 1./diagS
+    linAlg.set(Nskeleton, 1.0, o_invDiagS);
+    linAlg.adx(Nskeleton, 1.0, o_diagS, o_invDiagS);
+  }
+
+  condensedLambda = lambda;
+}
+
+// zI = inv(A_ii) rI, fast diagonalization on the boxes and dense
+// inverses on the curved elements
+void elliptic_t::InteriorSolve(deviceMemory<dfloat>& o_rI, deviceMemory<dfloat>& o_zI) {
+
+  if (Naffine)
+    interiorFDMKernel(Naffine, o_interiorS, o_interiorSinv, o_interiorInvL,
+                      o_rI, o_zI);
+
+  const dlong Ncurved = mesh.Nelements - Naffine;
+  if (Ncurved) {
+    const dlong offset = Naffine*Ninterior;
+    platform.linAlg().batchedGEMV(Ncurved, Ninterior, Ninterior,
+                                  1.0, o_invAii, Ninterior*Ninterior,
+                                  o_rI+offset, 0.0, o_zI+offset);
+  }
+}
+
+// local A [qS; 0], the skeleton values extended by zero into the interiors
+void elliptic_t::SkeletonAx(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Aq) {
+
+  skeletonHalo.ExchangeStart(o_q, 1);
+
+  if(mesh.NlocalGatherElements) {
+    partialAxKernel(mesh.NlocalGatherElements,
+                    mesh.o_localGatherElementList,
+                    o_SkeletonToLocal,
+                    mesh.o_wJ, mesh.o_ggeo,
+                    mesh.o_D, mesh.o_S,
+                    mesh.o_MM, lambda, o_q, o_Aq);
+  }
+
+  skeletonHalo.ExchangeFinish(o_q, 1);
+
+  if(mesh.NglobalGatherElements) {
+    partialAxKernel(mesh.NglobalGatherElements,
+                    mesh.o_globalGatherElementList,
+                    o_SkeletonToLocal,
+                    mesh.o_wJ, mesh.o_ggeo,
+                    mesh.o_D, mesh.o_S,
+                    mesh.o_MM, lambda, o_q, o_Aq);
+  }
+}
+
+// S qS = A_bb qS - A_bi inv(A_ii) A_ib qS, applied element by element
+// with one skeleton halo exchange and one skeleton gather
+void elliptic_t::CondensedOperator(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_Sq) {
+
+  linAlg_t& linAlg = platform.linAlg();
+  const dlong Nlocal = mesh.Nelements*mesh.Np;
+  const dlong NinteriorTotal = mesh.Nelements*Ninterior;
+
+  SkeletonAx(o_q, o_AqL);
+
+  // harmonic extension qI = inv(A_ii) A_ib qS, then remove A_bi qI
+  if (NinteriorTotal) {
+    condensedGatherKernel(NinteriorTotal, o_interiorIds, o_AqL, o_AqI);
+    InteriorSolve(o_AqI, o_qI);
+    condensedScatterKernel(NinteriorTotal, o_interiorIds, o_qI, o_qL);
+
+    localAxKernel(mesh.Nelements, mesh.o_wJ, mesh.o_ggeo,
+                  mesh.o_D, mesh.o_S, mesh.o_MM, lambda, o_qL, o_AqIL);
+    linAlg.axpy(Nlocal, -1.0, o_AqIL, 1.0, o_AqL);
+  }
+
+  ogsSkeleton.Gather(o_Sq, o_AqL, 1, ogs::Add, ogs::Trans);
+}
+
+void elliptic_t::CondensedPrecon(deviceMemory<dfloat>& o_r, deviceMemory<dfloat>& o_Mr) {
+
+  linAlg_t& linAlg = platform.linAlg();
+
+  if (settings.compareSetting("PRECONDITIONER", "JACOBI")) {
+    // Mr = invDiagS.*r
+    linAlg.amxpy(Nskeleton, 1.0, o_invDiagS, o_r, 0.0, o_Mr);
+  } else if (settings.compareSetting("PRECONDITIONER", "PARALMOND")) {
+    condensedAMG.Operator(o_r, o_Mr);
+  } else {
+    o_Mr.copyFrom(o_r, Nskeleton); //identity
+  }
+
+  // the constant skeleton vector spans the nullspace of S
+  if (allNeumann) {
+    dfloat mean = linAlg.sum(Nskeleton, o_Mr, mesh.comm);
+    mean /= static_cast<dfloat>(ogsSkeleton.NgatherGlobal);
+    linAlg.add(Nskeleton, -mean, o_Mr);
+  }
+}
+
+// eliminate the element interiors, solve for the skeleton dofs, and
+// recover the interiors element by element
+int elliptic_t::SolveCondensed(linearSolver_t& linearSolver,
+                               deviceMemory<dfloat> &o_x, deviceMemory<dfloat> &o_r,
+                               const dfloat tol, const int MAXIT, const int verbose){
+
+  linAlg_t& linAlg = platform.linAlg();
+  const dlong Nlocal = mesh.Nelements*mesh.Np;
+  const dlong NinteriorTotal = mesh.Nelements*Ninterior;
+
+  if (lambda != condensedLambda) StaticCondensationUpdate();
+
+  // condensed rhs rS = r_b - A_bi inv(A_ii) r_i. The weighted local
+  // copies of r sum back to r_b in the skeleton gather
+  ogsMasked.Scatter(o_condRL, o_r, 1, ogs::NoTrans);
+
+  if (NinteriorTotal) {
+    condensedGatherKernel(NinteriorTotal, o_interiorIds, o_condRL, o_AqI);
+    InteriorSolve(o_AqI, o_qI);
+    condensedScatterKernel(NinteriorTotal, o_interiorIds, o_qI, o_qL);
+
+    localAxKernel(mesh.Nelements, mesh.o_wJ, mesh.o_ggeo,
+                  mesh.o_D, mesh.o_S, mesh.o_MM, lambda, o_qL, o_AqIL);
+  }
+  linAlg.amxpy(Nlocal, 1.0, o_weight, o_condRL, -1.0, o_AqIL);
+  ogsSkeleton.Gather(o_rS, o_AqIL, 1, ogs::Add, ogs::Trans);
+
+  // current skeleton values are the initial guess
+  ogsMasked.Scatter(o_AqIL, o_x, 1, ogs::NoTrans);
+  linAlg.amx(Nlocal, 1.0, o_weight, o_AqIL);
+  ogsSkeleton.Gather(o_xS, o_AqIL, 1, ogs::Add, ogs::Trans);
+
+  condensedOperator_t condensedOperator(*this);
+  condensedPrecon_t condensedPrecon(*this);
+
+  int Niter = linearSolver.Solve(condensedOperator, condensedPrecon,
+                                 o_xS, o_rS, tol, MAXIT, verbose);
+
+  // recover the interiors x_i = inv(A_ii) (r_i - A_ib x_b)
+  SkeletonAx(o_xS, o_AqL);
+
+  if (NinteriorTotal) {
+    condensedGatherKernel(NinteriorTotal, o_interiorIds, o_condRL, o_qI);
+    condensedGatherKernel(NinteriorTotal, o_interiorIds, o_AqL, o_AqI);
+    linAlg.axpy(NinteriorTotal, -1.0, o_AqI, 1.0, o_qI);
+    InteriorSolve(o_qI, o_AqI);
+  }
+
+  // assemble x = [x_b; x_i] from the weighted local copies
+  ogsSkeleton.Scatter(o_AqIL, o_xS, 1, ogs::NoTrans);
+  if (NinteriorTotal)
+    condensedScatterKernel(NinteriorTotal, o_interiorIds, o_AqI, o_AqIL);
+  linAlg.amx(Nlocal, 1.0, o_weight, o_AqIL);
+  ogsMasked.Gather(o_x, o_AqIL, 1, ogs::Add, ogs::Trans);
+
+  if (allNeumann) ZeroMean(o_x);
+
+  return Niter;
+}
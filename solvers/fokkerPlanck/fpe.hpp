@@ -126,6 +126,8 @@ public:
 
   dfloat MaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T);
 
+  dfloat MaxTimeStep(deviceMemory<dfloat>& o_Q, const dfloat T);
+
   void rhsf(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
 
   void rhs_imex_f(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
@@ -134,7 +136,7 @@ public:
   void rhs_imex_invg(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat gamma, const dfloat time);
 
   void rhs_subcycle_f(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_QHAT,
-                      const dfloat T, const dfloat dt, const memory<dfloat> B,
+                      const dfloat T, const memory<dfloat> dt, const memory<dfloat> B,
                       const int order, const int shiftIndex, const int maxOrder);
 
   void Advection(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, const dfloat T);
@@ -52,6 +52,11 @@ fpeSettings_t::fpeSettings_t(comm_t& _comm):
              "1.0",
              "Multiplier for timestep stability bound");
 
+  newSetting("ADAPTIVE TIME STEP",
+             "FALSE",
+             "Recompute the multistep time step from the stability bound every step",
+             {"TRUE", "FALSE"});
+
   newSetting("NUMBER OF SUBCYCLES",
              "1",
              "Ratio of full timestep size to subcycling step size");
@@ -99,6 +104,7 @@ void fpeSettings_t::report() {
       reportSetting("SUBCYCLING TIME INTEGRATOR");
     }
 
+    reportSetting("ADAPTIVE TIME STEP");
     reportSetting("START TIME");
     reportSetting("FINAL TIME");
     reportSetting("OUTPUT INTERVAL");
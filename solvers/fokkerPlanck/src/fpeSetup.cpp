@@ -76,6 +76,9 @@ void fpe_t::Setup(platform_t& _platform, mesh_t& _mesh,
     gamma = timeStepper.GetGamma();
   }
 
+  if (settings.compareSetting("ADAPTIVE TIME STEP","TRUE"))
+    timeStepper.EnableAdaptiveTimeStep();
+
   Nsubcycles=1;
   if (settings.compareSetting("TIME INTEGRATOR","SSBDF3"))
     settings.getSetting("NUMBER OF SUBCYCLES", Nsubcycles);
@@ -108,19 +111,19 @@ void fpe_t::Setup(platform_t& _platform, mesh_t& _mesh,
     tau = elliptic.tau;
 
     if (ellipticSettings.compareSetting("LINEAR SOLVER","NBPCG")){
-      linearSolver.Setup<LinearSolver::nbpcg>(elliptic.Ndofs, elliptic.Nhalo,
+      linearSolver.Setup<LinearSolver::nbpcg>(elliptic.NsolveDofs, elliptic.NsolveHalo,
                                               platform, ellipticSettings, comm);
     } else if (ellipticSettings.compareSetting("LINEAR SOLVER","NBFPCG")){
-      linearSolver.Setup<LinearSolver::nbfpcg>(elliptic.Ndofs, elliptic.Nhalo,
+      linearSolver.Setup<LinearSolver::nbfpcg>(elliptic.NsolveDofs, elliptic.NsolveHalo,
                                               platform, ellipticSettings, comm);
     } else if (ellipticSettings.compareSetting("LINEAR SOLVER","PCG")){
-      linearSolver.Setup<LinearSolver::pcg>(elliptic.Ndofs, elliptic.Nhalo,
+      linearSolver.Setup<LinearSolver::pcg>(elliptic.NsolveDofs, elliptic.NsolveHalo,
                                               platform, ellipticSettings, comm);
     } else if (ellipticSettings.compareSetting("LINEAR SOLVER","PGMRES")){
-      linearSolver.Setup<LinearSolver::pgmres>(elliptic.Ndofs, elliptic.Nhalo,
+      linearSolver.Setup<LinearSolver::pgmres>(elliptic.NsolveDofs, elliptic.NsolveHalo,
                                               platform, ellipticSettings, comm);
     } else if (ellipticSettings.compareSetting("LINEAR SOLVER","PMINRES")){
-      linearSolver.Setup<LinearSolver::pminres>(elliptic.Ndofs, elliptic.Nhalo,
+      linearSolver.Setup<LinearSolver::pminres>(elliptic.NsolveDofs, elliptic.NsolveHalo,
                                               platform, ellipticSettings, comm);
     }
   } else {
@@ -101,22 +101,28 @@ void fpe_t::rhs_imex_invg(deviceMemory<dfloat>& o_RHS, deviceMemory<dfloat>& o_Q
 
 // Evolve rhs f function via a sub-timestepper
 void fpe_t::rhs_subcycle_f(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_QHAT,
-                           const dfloat T, const dfloat dt, const memory<dfloat> B,
+                           const dfloat T, const memory<dfloat> dt, const memory<dfloat> B,
                            const int order, const int shiftIndex, const int maxOrder) {
 
   //subcycle each Lagrangian state qhat by stepping dqhat/dt = F(qhat,t)
 
+  //time levels of the history states, tn[n+1] for state n
+  memory<dfloat> tn(maxOrder+1, 0.0);
+  tn[0] = T + dt[0];
+  tn[1] = T;
+  for (int n=1;n<=order;n++) tn[n+1] = tn[n] - dt[n];
+
   //At each iteration of n, we step the partial sum
-  // sum_i=n^order B[i]*Q(t-i*dt) from t-n*dt to t-(n-1)*dt
+  // sum_i=n^order B[i]*Q(t_i) from t_n to t_n-1
   //To keep BCs consistent, we step the scaled partial sum:
-  // QHAT = sum_i=n^order B[i]*Q(t-i*dt)/(sum_i=n^order B[i])
+  // QHAT = sum_i=n^order B[i]*Q(t_i)/(sum_i=n^order B[i])
   dfloat bSum = 0.0;
 
   dlong N = mesh.Nelements*mesh.Np;
 
   for (int n=order;n>=0;n--) { //for each history state, starting with oldest
 
-    //q at t-n*dt
+    //q at t_n
     deviceMemory<dfloat> o_Qn = o_Q + ((shiftIndex+n)%maxOrder)*N;
 
     //next scaled partial sum
@@ -124,7 +130,9 @@ void fpe_t::rhs_subcycle_f(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_QH
                               bSum/(B[n+1]+bSum), o_QHAT);
     bSum += B[n+1];
 
-    subStepper.Run(subcycler, o_QHAT, T-n*dt, T-(n-1)*dt);
+    //subcycles run at the advective limit of this interval
+    subStepper.SetTimeStep(dt[n]/Nsubcycles);
+    subStepper.Run(subcycler, o_QHAT, tn[n+1], tn[n]);
   }
 }
 
@@ -67,7 +67,7 @@ public:
 
   int NVfields;
   int order, maxOrder, shiftIndex;
-  dfloat nu, T0, dt;
+  dfloat nu, T0, T1, T2; //time levels of the velocity history
 
   deviceMemory<dfloat> o_Ue, o_Uh;
 
@@ -174,6 +174,8 @@ public:
 
   dfloat MaxWaveSpeed(deviceMemory<dfloat>& o_U, const dfloat T);
 
+  dfloat MaxTimeStep(deviceMemory<dfloat>& o_U, const dfloat T);
+
   // void rhsf(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
 
   void rhs_imex_f(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat time);
@@ -182,7 +184,7 @@ public:
   void rhs_imex_invg(deviceMemory<dfloat>& o_q, deviceMemory<dfloat>& o_rhs, const dfloat gamma, const dfloat time);
 
   void rhs_subcycle_f(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_QHAT,
-                      const dfloat T, const dfloat dt, const memory<dfloat> B,
+                      const dfloat T, const memory<dfloat> dt, const memory<dfloat> B,
                       const int order, const int shiftIndex, const int maxOrder);
 
   void Advection(const dfloat alpha, deviceMemory<dfloat>& o_U,
@@ -58,6 +58,9 @@ void ins_t::PressureIncrementSolve(deviceMemory<dfloat>& o_P, deviceMemory<dfloa
   int maxIter = 5000;
   int verbose = 0;
 
+  //time level of this solve, for extrapolated initial guesses
+  pLinearSolver.SetInitialGuessTime(T);
+
   //  Solve - Laplacian*PI = RHS
   if(pDisc_c0) {
     // gather, solve, scatter
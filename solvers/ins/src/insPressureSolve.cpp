@@ -57,6 +57,9 @@ void ins_t::PressureSolve(deviceMemory<dfloat>& o_P, deviceMemory<dfloat>& o_RHS
   int maxIter = 5000;
   int verbose = 0;
 
+  //time level of this solve, for extrapolated initial guesses
+  pLinearSolver.SetInitialGuessTime(T);
+
   if(pDisc_c0) {
     // gather, solve, scatter
     pSolver.ogsMasked.Gather(o_GrhsP, o_RHS, 1, ogs::Add, ogs::Trans);
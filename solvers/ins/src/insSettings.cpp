@@ -57,6 +57,11 @@ insSettings_t::insSettings_t(comm_t& _comm):
              "1.0",
              "Multiplier for timestep stability bound");
 
+  newSetting("ADAPTIVE TIME STEP",
+             "FALSE",
+             "Recompute the multistep time step from the stability bound every step",
+             {"TRUE", "FALSE"});
+
   newSetting("NUMBER OF SUBCYCLES",
              "1",
              "Ratio of full timestep size to subcycling step size");
@@ -110,6 +115,7 @@ void insSettings_t::report() {
       reportSetting("SUBCYCLING TIME INTEGRATOR");
     }
 
+    reportSetting("ADAPTIVE TIME STEP");
     reportSetting("START TIME");
     reportSetting("FINAL TIME");
     reportSetting("OUTPUT INTERVAL");
@@ -119,6 +125,8 @@ void insSettings_t::report() {
     std::cout << "\nVelocity Solver Settings:\n\n";
 
     reportSetting("VELOCITY DISCRETIZATION");
+    if (compareSetting("VELOCITY DISCRETIZATION","CONTINUOUS"))
+      reportSetting("VELOCITY STATIC CONDENSATION");
     reportSetting("VELOCITY LINEAR SOLVER");
     reportSetting("VELOCITY INITIAL GUESS STRATEGY");
     reportSetting("VELOCITY INITIAL GUESS HISTORY SPACE DIMENSION");
@@ -141,6 +149,8 @@ void insSettings_t::report() {
     std::cout << "\nPressure Solver Settings:\n\n";
 
     reportSetting("PRESSURE DISCRETIZATION");
+    if (compareSetting("PRESSURE DISCRETIZATION","CONTINUOUS"))
+      reportSetting("PRESSURE STATIC CONDENSATION");
     reportSetting("PRESSURE LINEAR SOLVER");
     reportSetting("PRESSURE INITIAL GUESS STRATEGY");
     reportSetting("PRESSURE INITIAL GUESS HISTORY SPACE DIMENSION");
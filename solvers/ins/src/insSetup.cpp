@@ -68,6 +68,9 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
     gamma = timeStepper.GetGamma();
   }
 
+  if (settings.compareSetting("ADAPTIVE TIME STEP","TRUE"))
+    timeStepper.EnableAdaptiveTimeStep();
+
   Nsubcycles=1;
   if (settings.compareSetting("TIME INTEGRATOR","SSBDF3"))
     settings.getSetting("NUMBER OF SUBCYCLES", Nsubcycles);
@@ -118,8 +121,8 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
     vSettings = _settings.extractVelocitySettings();
 
-    //make a guess at dt for the lambda value
-    //TODO: we should allow preconditioners to be re-setup if lambda is updated
+    //make a guess at dt for the lambda value. Jacobi and multigrid
+    // preconditioners are rebuilt in Solve when the actual lambda differs
     dfloat hmin = mesh.MinCharacteristicLength();
     dfloat dtAdvc = Nsubcycles*hmin/((mesh.N+1.)*(mesh.N+1.));
     dfloat lambda = gamma/(dtAdvc*nu);
@@ -135,13 +138,13 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
     vDisc_c0 = settings.compareSetting("VELOCITY DISCRETIZATION", "CONTINUOUS") ? 1 : 0;
 
-    uNlocal = uSolver.Ndofs;
-    vNlocal = vSolver.Ndofs;
-    if (mesh.dim == 3) wNlocal = wSolver.Ndofs;
+    uNlocal = uSolver.NsolveDofs;
+    vNlocal = vSolver.NsolveDofs;
+    if (mesh.dim == 3) wNlocal = wSolver.NsolveDofs;
 
-    uNhalo = uSolver.Nhalo;
-    vNhalo = vSolver.Nhalo;
-    if (mesh.dim == 3) wNhalo = wSolver.Nhalo;
+    uNhalo = uSolver.NsolveHalo;
+    vNhalo = vSolver.NsolveHalo;
+    if (mesh.dim == 3) wNhalo = wSolver.NsolveHalo;
 
     if (vSettings.compareSetting("LINEAR SOLVER","NBPCG")){
 
@@ -250,13 +253,8 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
     pDisc_c0 = settings.compareSetting("PRESSURE DISCRETIZATION", "CONTINUOUS") ? 1 : 0;
 
-    if (pDisc_c0) {
-      pNlocal = pSolver.ogsMasked.Ngather;
-      pNhalo  = pSolver.gHalo.Nhalo;
-    } else {
-      pNlocal = mesh.Nelements*mesh.Np;
-      pNhalo  = mesh.totalHaloPairs*mesh.Np;
-    }
+    pNlocal = pSolver.NsolveDofs;
+    pNhalo  = pSolver.NsolveHalo;
 
     if (vSettings.compareSetting("LINEAR SOLVER","NBPCG")){
       pLinearSolver.Setup<LinearSolver::nbpcg>(pNlocal, pNhalo, platform, pSettings, comm);
@@ -324,16 +322,18 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
     if (mesh.dim==3)
       o_rhsW = platform.malloc<dfloat>(Nlocal+Nhalo, u);
 
+    //gathered fields live in the full continuous space, even when
+    // the linear solvers only see the condensed skeleton dofs
     if (vDisc_c0) {
-      o_GUH = platform.malloc<dfloat>(uNlocal+uNhalo, u);
-      o_GVH = platform.malloc<dfloat>(vNlocal+vNhalo, u);
+      o_GUH = platform.malloc<dfloat>(uSolver.Ndofs+uSolver.Nhalo, u);
+      o_GVH = platform.malloc<dfloat>(vSolver.Ndofs+vSolver.Nhalo, u);
       if (mesh.dim==3)
-        o_GWH = platform.malloc<dfloat>(wNlocal+wNhalo, u);
+        o_GWH = platform.malloc<dfloat>(wSolver.Ndofs+wSolver.Nhalo, u);
 
-      o_GrhsU = platform.malloc<dfloat>(uNlocal+uNhalo, u);
-      o_GrhsV = platform.malloc<dfloat>(vNlocal+vNhalo, u);
+      o_GrhsU = platform.malloc<dfloat>(uSolver.Ndofs+uSolver.Nhalo, u);
+      o_GrhsV = platform.malloc<dfloat>(vSolver.Ndofs+vSolver.Nhalo, u);
       if (mesh.dim==3)
-        o_GrhsW = platform.malloc<dfloat>(wNlocal+wNhalo, u);
+        o_GrhsW = platform.malloc<dfloat>(wSolver.Ndofs+wSolver.Nhalo, u);
     }
   }
 
@@ -114,32 +114,39 @@ void ins_t::rhs_imex_f(deviceMemory<dfloat>& o_U, deviceMemory<dfloat>& o_RHS, c
 
 // Evolve rhs f function via a sub-timestepper
 void ins_t::rhs_subcycle_f(deviceMemory<dfloat>& o_U, deviceMemory<dfloat>& o_UHAT,
-                           const dfloat T, const dfloat dt, const memory<dfloat> B,
+                           const dfloat T, const memory<dfloat> dt, const memory<dfloat> B,
                            const int order, const int shiftIndex, const int maxOrder) {
 
   //subcycle each Lagrangian state qhat by stepping dqhat/dt = F(qhat,t)
   LIBP_ABORT("Subcycling supports only order 3 interpolation for now.",
              order>=3);
 
+  //time levels of the history states, tn[n+1] for state n
+  memory<dfloat> tn(maxOrder+1, 0.0);
+  tn[0] = T + dt[0];
+  tn[1] = T;
+  for (int n=1;n<=order;n++) tn[n+1] = tn[n] - dt[n];
+
   subcycler.order = order;
   subcycler.maxOrder = maxOrder;
   subcycler.shiftIndex = shiftIndex;
-  subcycler.T0 = T;
-  subcycler.dt = dt;
+  subcycler.T0 = tn[1];
+  subcycler.T1 = tn[2];
+  subcycler.T2 = tn[3];
 
   subcycler.o_Uh = o_U; //history
 
   //At each iteration of n, we step the partial sum
-  // sum_i=n^order B[i]*U(t-i*dt) from t-n*dt to t-(n-1)*dt
+  // sum_i=n^order B[i]*U(t_i) from t_n to t_n-1
   //To keep BCs consistent, we step the scaled partial sum:
-  // UHAT = sum_i=n^order B[i]*U(t-i*dt)/(sum_i=n^order B[i])
+  // UHAT = sum_i=n^order B[i]*U(t_i)/(sum_i=n^order B[i])
   dfloat bSum = 0.0;
 
   dlong N = mesh.Nelements*mesh.Np*NVfields;
 
   for (int n=order;n>=0;n--) { //for each history state, starting with oldest
 
-    //q at t-n*dt
+    //q at t_n
     deviceMemory<dfloat> o_Un = o_U + ((shiftIndex+n)%maxOrder)*N;
 
     //next scaled partial sum
@@ -147,6 +154,8 @@ void ins_t::rhs_subcycle_f(deviceMemory<dfloat>& o_U, deviceMemory<dfloat>& o_UH
                               bSum/(B[n+1]+bSum), o_UHAT);
     bSum += B[n+1];
 
-    subStepper.Run(subcycler, o_UHAT, T-n*dt, T-(n-1)*dt);
+    //subcycles run at the advective limit of this interval
+    subStepper.SetTimeStep(dt[n]/Nsubcycles);
+    subStepper.Run(subcycler, o_UHAT, tn[n+1], tn[n]);
   }
 }
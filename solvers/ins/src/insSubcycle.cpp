@@ -39,7 +39,8 @@ void subcycler_t::rhsf(deviceMemory<dfloat>& o_U, deviceMemory<dfloat>& o_RHS, c
                            mesh.Nelements*mesh.Np*NVfields,
                            T,
                            T0,
-                           dt,
+                           T1,
+                           T2,
                            o_Uh,
                            o_Ue);
 
@@ -55,7 +56,8 @@ void subcycler_t::rhsf(deviceMemory<dfloat>& o_U, deviceMemory<dfloat>& o_RHS, c
                            mesh.Nelements*mesh.Np*NVfields,
                            T,
                            T0,
-                           dt,
+                           T1,
+                           T2,
                            o_Uh,
                            o_Ue);
 
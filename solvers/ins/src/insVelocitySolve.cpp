@@ -68,6 +68,12 @@ void ins_t::VelocitySolve(deviceMemory<dfloat>& o_U, deviceMemory<dfloat>& o_RHS
   vSolver.lambda = gamma/nu;
   wSolver.lambda = gamma/nu;
 
+  //time level of this solve, for extrapolated initial guesses
+  uLinearSolver.SetInitialGuessTime(T);
+  vLinearSolver.SetInitialGuessTime(T);
+  if (mesh.dim==3)
+    wLinearSolver.SetInitialGuessTime(T);
+
   //  Solve lambda*U - Laplacian*U = rhs
   if (vDisc_c0){
     // gather, solve, scatter
@@ -60,6 +60,11 @@ void lbs_t::Setup(platform_t& _platform, mesh_t& _mesh,
     EtoDT[e] = dtAdv;
   }
 
+  //lbs only steps with LSERK4. rhsf applies the collision as an in-place
+  // update of q with a relaxation rate tied to the global step
+  // (gamma = alpha/dt), so q is not advanced by a pure rhs, and MRAB3
+  // levels, each with their own step, cannot replay it from the fQM
+  // history. The PML members are unused while PmlSetup is disabled
   if (settings.compareSetting("TIME INTEGRATOR","LSERK4")){
     timeStepper.Setup<TimeStepper::lserk4>(mesh.Nelements,
                                            mesh.totalHaloPairs,
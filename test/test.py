@@ -98,7 +98,25 @@ def writeSetup(filename, settings):
   file.write(str_settings)
   file.close()
 
-def test(name, cmd, settings, referenceNorm, ranks=1):
+#run a solver and return the last solution norm it reports, or None on failure.
+# Used to build reference values at test time from an equivalent run
+def solutionNorm(cmd, settings, ranks=1):
+
+  writeSetup("setup",settings)
+
+  run = subprocess.run(["mpirun", "--oversubscribe", "-np", str(ranks), cmd, inputRC],
+                        stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+
+  os.remove(inputRC)
+
+  norm = None
+  for line in run.stdout.decode().splitlines():
+    if line.startswith("Solution norm = "):
+      norm = float(line.split()[3])
+
+  return norm
+
+def test(name, cmd, settings, referenceNorm, ranks=1, tol=TOL, expectedOutput=[]):
 
   #create input file
   writeSetup("setup",settings)
@@ -126,9 +144,21 @@ def test(name, cmd, settings, referenceNorm, ranks=1):
 
     #check last line's syntax
     failed=0;
+    #lines the run must print, as regular expressions
+    missing = [pattern for pattern in expectedOutput
+               if re.search(pattern, run.stdout.decode()) is None]
+
     if "Solution norm = " in output:
       norm = float(output.split()[3])
-      if abs(norm - referenceNorm) < TOL:
+      if missing:
+        #failed output check
+        print(bcolors.FAIL + "FAIL" + bcolors.ENDC)
+        for pattern in missing:
+          print(bcolors.WARNING + "Missing Output: " + pattern + bcolors.ENDC)
+        #save the setup for reproducibility
+        writeSetup(name,settings)
+        failed = 1
+      elif referenceNorm is not None and abs(norm - referenceNorm) < tol:
         print(bcolors.PASS + "PASS" + bcolors.ENDC)
       else:
         #failed residual check
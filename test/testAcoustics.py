@@ -26,6 +26,7 @@
 #
 #####################################################################################
 
+import math
 from test import *
 
 data2D = acousticsDir + "/data/acousticsGaussian2D.h"
@@ -35,7 +36,7 @@ def acousticsSettings(rcformat="2.0", data_file=data2D,
                      mesh="BOX", dim=2, element=4, nx=10, ny=10, nz=10, boundary_flag=-1,
                      degree=4, thread_model=device, platform_number=0, device_number=0,
                       time_integrator="DOPRI5", cfl=1.0, start_time=0.0, final_time=1.0,
-                      output_to_file="FALSE"):
+                      output_to_file="FALSE", ensemble_size=1, ensemble_first_member=0):
   return [setting_t("FORMAT", rcformat),
           setting_t("DATA FILE", data_file),
           setting_t("MESH FILE", mesh),
@@ -53,7 +54,9 @@ def acousticsSettings(rcformat="2.0", data_file=data2D,
           setting_t("CFL NUMBER", cfl),
           setting_t("START TIME", start_time),
           setting_t("FINAL TIME", final_time),
-          setting_t("OUTPUT TO FILE", output_to_file)]
+          setting_t("OUTPUT TO FILE", output_to_file),
+          setting_t("ENSEMBLE SIZE", ensemble_size),
+          setting_t("ENSEMBLE FIRST MEMBER", ensemble_first_member)]
 
 def main():
   failCount=0;
@@ -85,6 +88,29 @@ def main():
                     settings=acousticsSettings(element=3,data_file=data2D,dim=2,output_to_file="TRUE"),
                     referenceNorm=10.1300558638317)
 
+  #members have distinct sources and wave speeds and must match separate runs
+  # of each member, combined as sqrt(sum of squared member norms). The
+  # ensemble steps at the fastest member's rate, so each member's run scales
+  # its cfl to take the same time step
+  Nensemble = 3
+  waveSpeed = [1.0 + 0.25*ens for ens in range(Nensemble)]
+  memberNorms = [solutionNorm(cmd=acousticsBin,
+                              settings=acousticsSettings(element=3,data_file=data2D,dim=2,
+                                                         time_integrator="LSERK4",
+                                                         cfl=waveSpeed[ens]/max(waveSpeed),
+                                                         ensemble_first_member=ens))
+                 for ens in range(Nensemble)]
+  ensembleNorm = None
+  if None not in memberNorms:
+    ensembleNorm = math.sqrt(sum(norm*norm for norm in memberNorms))
+
+  failCount += test(name="testAcousticsTri_ensemble",
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=3,data_file=data2D,dim=2,
+                                               time_integrator="LSERK4",
+                                               ensemble_size=Nensemble),
+                    referenceNorm=ensembleNorm)
+
   #clean up
   for file_name in os.listdir(testDir):
     if file_name.endswith('.vtu'):
@@ -26,16 +26,25 @@
 #
 #####################################################################################
 
+import math
 from test import *
 
 advectionData2D = advectionDir + "/data/advectionLinear2D.h"
 advectionData3D = advectionDir + "/data/advectionLinear3D.h"
+advectionDataPulsed2D = advectionDir + "/data/advectionPulsed2D.h"
 
 def advectionSettings(rcformat="2.0", data_file=advectionData2D,
                      mesh="BOX", dim=2, element=4, nx=10, ny=10, nz=10, boundary_flag=-1,
                      degree=4, thread_model=device, platform_number=0, device_number=0,
                       time_integrator="DOPRI5", cfl=1.0, start_time=0.0, final_time=1.0,
-                      output_to_file="FALSE"):
+                      output_to_file="FALSE", multirate_level_selection="BINNING",
+                      multirate_element_cost=0.0, multirate_launch_cost=0.0,
+                      multirate_exchange_cost=0.0,
+                      lsrk_tableau="NDB144", fused_rk_update="FALSE", ensemble_size=1,
+                      ensemble_first_member=0,
+                      parareal_time_slices=1, parareal_coarse_integrator="LSERK4",
+                      parareal_coarse_dt_factor=4, parareal_max_iterations=4,
+                      adaptive_time_step="FALSE"):
   return [setting_t("FORMAT", rcformat),
           setting_t("DATA FILE", data_file),
           setting_t("MESH FILE", mesh),
@@ -53,7 +62,20 @@ def advectionSettings(rcformat="2.0", data_file=advectionData2D,
           setting_t("CFL NUMBER", cfl),
           setting_t("START TIME", start_time),
           setting_t("FINAL TIME", final_time),
-          setting_t("OUTPUT TO FILE", output_to_file)]
+          setting_t("OUTPUT TO FILE", output_to_file),
+          setting_t("MULTIRATE LEVEL SELECTION", multirate_level_selection),
+          setting_t("MULTIRATE ELEMENT COST", multirate_element_cost),
+          setting_t("MULTIRATE LAUNCH COST", multirate_launch_cost),
+          setting_t("MULTIRATE EXCHANGE COST", multirate_exchange_cost),
+          setting_t("LSRK TABLEAU", lsrk_tableau),
+          setting_t("FUSED RK UPDATE", fused_rk_update),
+          setting_t("ENSEMBLE SIZE", ensemble_size),
+          setting_t("ENSEMBLE FIRST MEMBER", ensemble_first_member),
+          setting_t("PARAREAL TIME SLICES", parareal_time_slices),
+          setting_t("PARAREAL COARSE INTEGRATOR", parareal_coarse_integrator),
+          setting_t("PARAREAL COARSE DT FACTOR", parareal_coarse_dt_factor),
+          setting_t("PARAREAL MAX ITERATIONS", parareal_max_iterations),
+          setting_t("ADAPTIVE TIME STEP", adaptive_time_step)]
 
 def main():
   failCount=0;
@@ -83,6 +105,25 @@ def main():
                     settings=advectionSettings(element=3,data_file=advectionData2D,dim=2,output_to_file="TRUE"),
                     referenceNorm=0.723627520020827)
 
+  #members have distinct initial conditions and must match separate runs
+  # of each member, combined as sqrt(sum of squared member norms)
+  Nensemble = 3
+  memberNorms = [solutionNorm(cmd=advectionBin,
+                              settings=advectionSettings(element=3,data_file=advectionData2D,dim=2,
+                                                         time_integrator="LSERK4",
+                                                         ensemble_first_member=ens))
+                 for ens in range(Nensemble)]
+  ensembleNorm = None
+  if None not in memberNorms:
+    ensembleNorm = math.sqrt(sum(norm*norm for norm in memberNorms))
+
+  failCount += test(name="testAdvectionTri_ensemble",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,dim=2,
+                                               time_integrator="LSERK4",
+                                               ensemble_size=Nensemble),
+                    referenceNorm=ensembleNorm)
+
   #clean up
   for file_name in os.listdir(testDir):
     if file_name.endswith('.vtu'):
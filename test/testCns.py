@@ -37,7 +37,9 @@ def cnsSettings(rcformat="2.0", data_file=cnsData2D,
                gamma=1.4, viscosity=0.01, isothermal="FALSE",
                advection_type="COLLOCATION",
                 time_integrator="DOPRI5", cfl=1.0, start_time=0.0, final_time=1.0,
-                output_to_file="FALSE"):
+                output_to_file="FALSE", paradogs_rebalancing="NONE",
+                paradogs_rebalance_threshold=1.1, paradogs_rebalance_interval=100,
+                newton_tolerance=1.0e-6, viscous_preconditioner="NONE"):
   return [setting_t("FORMAT", rcformat),
           setting_t("DATA FILE", data_file),
           setting_t("MESH FILE", mesh),
@@ -59,7 +61,12 @@ def cnsSettings(rcformat="2.0", data_file=cnsData2D,
           setting_t("CFL NUMBER", cfl),
           setting_t("START TIME", start_time),
           setting_t("FINAL TIME", final_time),
-          setting_t("OUTPUT TO FILE", output_to_file)]
+          setting_t("OUTPUT TO FILE", output_to_file),
+          setting_t("PARADOGS REBALANCING", paradogs_rebalancing),
+          setting_t("PARADOGS REBALANCE THRESHOLD", paradogs_rebalance_threshold),
+          setting_t("PARADOGS REBALANCE INTERVAL", paradogs_rebalance_interval),
+          setting_t("NEWTON TOLERANCE", newton_tolerance),
+          setting_t("VISCOUS PRECONDITIONER", viscous_preconditioner)]
 
 def main():
   failCount=0;
@@ -69,6 +76,40 @@ def main():
                     settings=cnsSettings(element=3,data_file=cnsData2D,dim=2),
                     referenceNorm=27.4583308011963)
 
+  #preconditioned IMEX stage solves, whose lambda follows the adaptive step,
+  # must reproduce an unpreconditioned ARK4 run once both Newton solves are tight
+  failCount += test(name="testCnsTri_ark4",
+                    cmd=cnsBin,
+                    settings=cnsSettings(element=3,data_file=cnsData2D,dim=2,
+                                         time_integrator="ARK4",
+                                         newton_tolerance=1.0e-10,
+                                         viscous_preconditioner="JACOBI"),
+                    referenceNorm=solutionNorm(cmd=cnsBin,
+                                               settings=cnsSettings(element=3,data_file=cnsData2D,dim=2,
+                                                                    time_integrator="ARK4",
+                                                                    newton_tolerance=1.0e-10)))
+
+  #IMEX stepping is also checked against an explicit run of the same flow. Both
+  # steppers are error controlled, so they agree to the controller tolerance
+  failCount += test(name="testCnsTri_ark4_explicit",
+                    cmd=cnsBin,
+                    settings=cnsSettings(element=3,data_file=cnsData2D,dim=2,
+                                         time_integrator="ARK4"),
+                    referenceNorm=solutionNorm(cmd=cnsBin,
+                                               settings=cnsSettings(element=3,data_file=cnsData2D,dim=2,
+                                                                    time_integrator="DOPRI5")),
+                    tol=1.0e-3)
+
+  #multirate stepping is checked against a single-rate run of the same flow
+  failCount += test(name="testCnsTri_mrab3",
+                    cmd=cnsBin,
+                    settings=cnsSettings(element=3,data_file=cnsData2D,dim=2,
+                                         time_integrator="MRAB3", cfl=0.5),
+                    referenceNorm=solutionNorm(cmd=cnsBin,
+                                               settings=cnsSettings(element=3,data_file=cnsData2D,dim=2,
+                                                                    time_integrator="LSERK4")),
+                    tol=1.0e-3)
+
   failCount += test(name="testCnsQuad",
                     cmd=cnsBin,
                     settings=cnsSettings(element=4,data_file=cnsData2D,dim=2),
@@ -169,6 +210,14 @@ def main():
                     settings=cnsSettings(element=3,data_file=cnsData2D,dim=2, output_to_file="TRUE"),
                     referenceNorm=27.4600335839337)
 
+  failCount += test(name="testCnsTri_Rebalance_MPI", ranks=4,
+                    cmd=cnsBin,
+                    settings=cnsSettings(element=3,data_file=cnsData2D,dim=2,
+                                         paradogs_rebalancing="DYNAMIC",
+                                         paradogs_rebalance_threshold=1.0,
+                                         paradogs_rebalance_interval=10),
+                    referenceNorm=27.4600335839337)
+
   #clean up
   for file_name in os.listdir(testDir):
     if file_name.endswith('.vtu'):
@@ -36,6 +36,8 @@ def ellipticSettings(rcformat="2.0", data_file=ellipticData2D,
                      degree=4, thread_model=device, platform_number=0, device_number=0,
                      Lambda=1.0,
                      discretization="CONTINUOUS",
+                     integration="COLLOCATION",
+                     static_condensation="FALSE",
                      linear_solver="PCG",
                      precon="MULTIGRID",
                      multigrid_smoother="CHEBYSHEV",
@@ -61,6 +63,8 @@ def ellipticSettings(rcformat="2.0", data_file=ellipticData2D,
           setting_t("PLATFORM NUMBER", platform_number),
           setting_t("DEVICE NUMBER", device_number),
           setting_t("DISCRETIZATION", discretization),
+          setting_t("INTEGRATION", integration),
+          setting_t("STATIC CONDENSATION", static_condensation),
           setting_t("LINEAR SOLVER", linear_solver),
           setting_t("PRECONDITIONER", precon),
           setting_t("MULTIGRID SMOOTHER", multigrid_smoother),
@@ -152,6 +156,11 @@ def main():
                     settings=ellipticSettings(element=4,data_file=ellipticData2D,dim=2,
                                               precon="MULTIGRID"),
                     referenceNorm=0.500000001211135)
+  failCount += test(name="testEllipticQuad_C0_Multigrid_Schwarz",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=4,data_file=ellipticData2D,dim=2,
+                                              precon="MULTIGRID", multigrid_smoother="CHEBYSHEV+SCHWARZ"),
+                    referenceNorm=0.500000001211135)
   failCount += test(name="testEllipticQuad_C0_Semfem",
                     cmd=ellipticBin,
                     settings=ellipticSettings(element=4,data_file=ellipticData2D,dim=2,
@@ -211,6 +220,11 @@ def main():
                     settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
                                               precon="MULTIGRID"),
                     referenceNorm=0.353553400508458)
+  failCount += test(name="testEllipticHex_C0_Multigrid_Schwarz",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
+                                              precon="MULTIGRID", multigrid_smoother="CHEBYSHEV+SCHWARZ"),
+                    referenceNorm=0.353553400508458)
   failCount += test(name="testEllipticHex_C0_Semfem",
                     cmd=ellipticBin,
                     settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
@@ -221,6 +235,21 @@ def main():
                     settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
                                               precon="OAS"),
                     referenceNorm=0.353553400508458)
+  failCount += test(name="testEllipticHex_C0_Cubature_Multigrid",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
+                                              integration="CUBATURE", precon="MULTIGRID"),
+                    referenceNorm=0.353553400508458)
+  failCount += test(name="testEllipticHex_C0_StaticCondensation_Jacobi",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
+                                              static_condensation="TRUE", precon="JACOBI"),
+                    referenceNorm=0.353553400508458)
+  failCount += test(name="testEllipticHex_C0_StaticCondensation_ParAlmond",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3, degree=2,
+                                              static_condensation="TRUE", precon="PARALMOND"),
+                    referenceNorm=0.353553400508458)
 
   # all Neumann
   failCount += test(name="testEllipticTri_C0_AllNeumann",
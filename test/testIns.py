@@ -39,12 +39,14 @@ def insSettings(rcformat="2.0", data_file=insData2D,
                time_integrator="EXTBDF3", cfl=1.0, start_time=0.0, final_time=0.1,
                num_subcycles=4, subcycle_integrator="DOPRI5",
                velocity_discretization="CONTINUOUS",
+               velocity_static_condensation="FALSE",
                velocity_linear_solver="PCG",
                velocity_precon="JACOBI",
                velocity_multigrid_smoother="CHEBYSHEV",
                velocity_paralmond_cycle="VCYCLE",
                velocity_paralmond_smoother="CHEBYSHEV",
                pressure_discretization="CONTINUOUS",
+               pressure_static_condensation="FALSE",
                pressure_linear_solver="FPCG",
                pressure_precon="MULTIGRID",
                pressure_multigrid_smoother="CHEBYSHEV",
@@ -76,6 +78,7 @@ def insSettings(rcformat="2.0", data_file=insData2D,
           setting_t("START TIME", start_time),
           setting_t("FINAL TIME", final_time),
           setting_t("VELOCITY DISCRETIZATION", velocity_discretization),
+          setting_t("VELOCITY STATIC CONDENSATION", velocity_static_condensation),
           setting_t("VELOCITY LINEAR SOLVER", velocity_linear_solver),
           setting_t("VELOCITY PRECONDITIONER", velocity_precon),
           setting_t("VELOCITY MULTIGRID SMOOTHER", velocity_multigrid_smoother),
@@ -83,6 +86,7 @@ def insSettings(rcformat="2.0", data_file=insData2D,
           setting_t("VELOCITY PARALMOND SMOOTHER", velocity_paralmond_smoother),
           setting_t("VELOCITY VERBOSE", "TRUE"),
           setting_t("PRESSURE DISCRETIZATION", pressure_discretization),
+          setting_t("PRESSURE STATIC CONDENSATION", pressure_static_condensation),
           setting_t("PRESSURE LINEAR SOLVER", pressure_linear_solver),
           setting_t("PRESSURE PRECONDITIONER", pressure_precon),
           setting_t("PRESSURE MULTIGRID SMOOTHER", pressure_multigrid_smoother),
@@ -117,6 +121,20 @@ def main():
                                          nx=6, ny=6, nz=6, degree=2),
                     referenceNorm=1.19564704164048)
 
+  #condensation is algebraically equivalent, so it is checked against the
+  # same flow solved without it
+  failCount += test(name="testInsHex_condensed",
+                    cmd=insBin,
+                    settings=insSettings(element=12,data_file=insData3D,dim=3,
+                                         nx=6, ny=6, nz=6, degree=2,
+                                         velocity_static_condensation="TRUE",
+                                         pressure_static_condensation="TRUE",
+                                         pressure_precon="JACOBI"),
+                    referenceNorm=solutionNorm(cmd=insBin,
+                                               settings=insSettings(element=12,data_file=insData3D,dim=3,
+                                                                    nx=6, ny=6, nz=6, degree=2,
+                                                                    pressure_precon="JACOBI")))
+
   #test cubature
   failCount += test(name="testInsTri_cub",
                     cmd=insBin,
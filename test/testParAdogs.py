@@ -88,6 +88,69 @@ def main():
                                               paradogs_partitioning="SPECTRAL"),
                     referenceNorm=0.942816869518335)
 
+  failCount += test(name="testParAdogsTet_SpectralNodes_MPI", ranks=4,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=6,data_file=gradientData3D,dim=3,
+                                              mesh=testDir+"/cubeTet.msh",
+                                              paradogs_partitioning="SPECTRAL",
+                                              paradogs_node_hierarchy="TRUE"),
+                    referenceNorm=0.942816947760423)
+
+  failCount += test(name="testParAdogsTri_SFC_MPI", ranks=2,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=3,data_file=gradientData2D,dim=2,
+                                              mesh=testDir+"/squareTri.msh",
+                                              paradogs_partitioning="SFC"),
+                    referenceNorm=0.580787485719841)
+
+  failCount += test(name="testParAdogsHex_SFC_MPI", ranks=2,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=12,data_file=gradientData3D,dim=3,
+                                              mesh=testDir+"/cubeHex.msh",
+                                              paradogs_partitioning="SFC",
+                                              paradogs_ordering="HILBERT"),
+                    referenceNorm=0.942816869518335)
+
+  failCount += test(name="testParAdogsTet_RCM_MPI", ranks=2,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=6,data_file=gradientData3D,dim=3,
+                                              mesh=testDir+"/cubeTet.msh",
+                                              paradogs_partitioning="INERTIAL",
+                                              paradogs_ordering="REVERSE-CUTHILL-MCKEE"),
+                    referenceNorm=0.942816947760423)
+
+  failCount += test(name="testParAdogsQuad_FaceBlocking_MPI", ranks=2,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=4,data_file=gradientData2D,dim=2,
+                                              mesh=testDir+"/squareQuad.msh",
+                                              paradogs_partitioning="SPECTRAL",
+                                              paradogs_ordering="FACE-BLOCKING"),
+                    referenceNorm=0.580787485654967)
+
+  failCount += test(name="testParAdogsQuad_SFCRefine_MPI", ranks=4,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=4,data_file=gradientData2D,dim=2,
+                                              mesh=testDir+"/squareQuad.msh",
+                                              paradogs_partitioning="SFC",
+                                              paradogs_refinement="GREEDY"),
+                    referenceNorm=0.580787485654967)
+
+  failCount += test(name="testParAdogsTri_InertialRefine_MPI", ranks=4,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=3,data_file=gradientData2D,dim=2,
+                                              mesh=testDir+"/squareTri.msh",
+                                              paradogs_partitioning="INERTIAL",
+                                              paradogs_refinement="GREEDY"),
+                    referenceNorm=0.580787485719841)
+
+  failCount += test(name="testParAdogsHex_SpectralRefine_MPI", ranks=4,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=12,data_file=gradientData3D,dim=3,
+                                              mesh=testDir+"/cubeHex.msh",
+                                              paradogs_partitioning="SPECTRAL",
+                                              paradogs_refinement="GREEDY"),
+                    referenceNorm=0.942816869518335)
+
   return failCount
 
 if __name__ == "__main__":
@@ -40,6 +40,20 @@ def main():
                                                dim=2, time_integrator="AB3", cfl=0.25),
                     referenceNorm=0.723972801309193)
 
+  # the advection speed pulses in time, so the step must shrink and regrow.
+  # Compared against a small fixed step LSERK4 solve of the same problem
+  failCount += test(name="testTimeStepper_ab3_adaptive",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionDataPulsed2D,
+                                               dim=2, time_integrator="AB3", cfl=0.25,
+                                               adaptive_time_step="TRUE"),
+                    referenceNorm=solutionNorm(advectionBin,
+                                  settings=advectionSettings(element=3,data_file=advectionDataPulsed2D,
+                                                             dim=2, time_integrator="LSERK4",
+                                                             cfl=0.25)),
+                    tol=1e-3,
+                    expectedOutput=[r"dt in \[([^,]+), (?!\1\])"])
+
   failCount += test(name="testTimeStepper_dopri5",
                     cmd=advectionBin,
                     settings=advectionSettings(element=3,data_file=advectionData2D,
@@ -52,6 +66,72 @@ def main():
                                                dim=2, time_integrator="LSERK4"),
                     referenceNorm=0.723924546941676)
 
+  failCount += test(name="testTimeStepper_lserk4_fused",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,
+                                               dim=2, time_integrator="LSERK4",
+                                               fused_rk_update="TRUE"),
+                    referenceNorm=0.723924546941676)
+
+  failCount += test(name="testTimeStepper_lsrk_lserk4",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,
+                                               dim=2, time_integrator="LSRK",
+                                               lsrk_tableau="LSERK4"),
+                    referenceNorm=0.723924546941676)
+
+  # after as many iterations as slices parareal reproduces the fine
+  # propagator slice by slice, whichever coarse propagator drives it
+  failCount += test(name="testTimeStepper_parareal", ranks=2,
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,
+                                               dim=2, time_integrator="LSERK4",
+                                               cfl=0.0625,
+                                               parareal_time_slices=2,
+                                               parareal_coarse_integrator="AB3",
+                                               parareal_coarse_dt_factor=4,
+                                               parareal_max_iterations=2),
+                    referenceNorm=solutionNorm(advectionBin, ranks=2,
+                                  settings=advectionSettings(element=3,data_file=advectionData2D,
+                                                             dim=2, time_integrator="LSERK4",
+                                                             cfl=0.0625,
+                                                             parareal_time_slices=2,
+                                                             parareal_coarse_integrator="LSERK4",
+                                                             parareal_coarse_dt_factor=4,
+                                                             parareal_max_iterations=2)),
+                    expectedOutput=[r"Parareal: 2 slices, 2 iterations"])
+
+  failCount += test(name="testTimeStepper_mrab3",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,
+                                               dim=2, time_integrator="MRAB3", cfl=0.25),
+                    referenceNorm=0.723972801309193)
+
+  #with free launches and exchanges the cost model keeps every binned level,
+  # so the run must match the binned multirate run
+  failCount += test(name="testTimeStepper_mrab3_costmodel",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,
+                                               dim=2, time_integrator="MRAB3", cfl=0.25,
+                                               multirate_level_selection="COST MODEL",
+                                               multirate_element_cost=1.0),
+                    expectedOutput=[r"Cost model: +(\d+) of +\1 levels"],
+                    referenceNorm=0.723972801309193)
+
+  #when every launch costs more than the element work, all levels merge into
+  # one and the run reduces to single-rate AB3
+  failCount += test(name="testTimeStepper_mrab3_costmodel_merge",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,
+                                               dim=2, time_integrator="MRAB3", cfl=0.25,
+                                               multirate_level_selection="COST MODEL",
+                                               multirate_element_cost=1.0,
+                                               multirate_launch_cost=1.0e9),
+                    expectedOutput=[r"Cost model: +1 of +\d+ levels"],
+                    referenceNorm=solutionNorm(cmd=advectionBin,
+                                               settings=advectionSettings(element=3,data_file=advectionData2D,
+                                                                          dim=2, time_integrator="AB3", cfl=0.25)))
+
   failCount += test(name="testTimeStepper_extbdf3",
                     cmd=fpeBin,
                     settings=fpeSettings(element=3,data_file=fpeData2D,dim=2,
@@ -112,6 +192,38 @@ def main():
                                          time_integrator="MRSAAB3", cfl=0.25),
                     referenceNorm=14.2550270959095)
 
+  # a relaxation operator given as a matrix takes the dense update kernels
+  # and must reproduce the diagonal runs
+  failCount += test(name="testTimeStepper_saab3_pml_matrix",
+                    cmd=bnsBin,
+                    settings=bnsSettings(element=3,data_file=bnsData2D,dim=2,
+                                         time_integrator="SAAB3", cfl=0.25,
+                                         relaxation_operator="MATRIX"),
+                    referenceNorm=14.2550270959095)
+
+  failCount += test(name="testTimeStepper_sark4_pml_matrix",
+                    cmd=bnsBin,
+                    settings=bnsSettings(element=3,data_file=bnsData2D,dim=2,
+                                         time_integrator="SARK4",
+                                         relaxation_operator="MATRIX"),
+                    referenceNorm=14.2114867833305)
+
+  failCount += test(name="testTimeStepper_sark5_pml_matrix",
+                    cmd=bnsBin,
+                    settings=bnsSettings(element=3,data_file=bnsData2D,dim=2,
+                                         time_integrator="SARK5",
+                                         relaxation_operator="MATRIX"),
+                    referenceNorm=solutionNorm(cmd=bnsBin,
+                                               settings=bnsSettings(element=3,data_file=bnsData2D,dim=2,
+                                                                    time_integrator="SARK5")))
+
+  failCount += test(name="testTimeStepper_mrsaab3_pml_matrix",
+                    cmd=bnsBin,
+                    settings=bnsSettings(element=3,data_file=bnsData2D,dim=2,
+                                         time_integrator="MRSAAB3", cfl=0.25,
+                                         relaxation_operator="MATRIX"),
+                    referenceNorm=14.2550270959095)
+
   return failCount
 
 if __name__ == "__main__":